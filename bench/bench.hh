@@ -0,0 +1,137 @@
+#ifndef SAL_BENCH_BENCH_HH_
+#define SAL_BENCH_BENCH_HH_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace sal::bench {
+
+/*!
+ * @brief numeric command line argument, falls back to def when absent
+ */
+inline std::size_t arg(int argc, char** argv, int i, std::size_t def) {
+  return i < argc ? std::strtoull(argv[i], nullptr, 10) : def;
+}
+
+/*!
+ * @brief seconds spent in f()
+ */
+template <typename F>
+double measure(F&& f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+inline void report(const char* name, std::size_t ops, double seconds) {
+  std::printf(
+      "%-32s %12zu ops %10.2f ns/op %10.3f Mops/s\n",
+      name, ops, seconds * 1e9 / ops, ops / seconds / 1e6
+  );
+}
+
+/*!
+ * @brief keys 0..n-1 in random order
+ */
+inline std::vector<std::uint64_t> shuffled(std::size_t n, std::uint64_t seed) {
+  std::vector<std::uint64_t> keys(n);
+  std::iota(keys.begin(), keys.end(), 0);
+  std::mt19937_64 rng(seed);
+  std::shuffle(keys.begin(), keys.end(), rng);
+  return keys;
+}
+
+/*!
+ * @brief zipf distributed ranks in [0, n), rank 0 being the hottest
+ */
+class Zipf {
+public:
+  Zipf(std::size_t n, double s, std::uint64_t seed) : rng_(seed), cdf_(n) {
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i++) {
+      sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+      cdf_[i] = sum;
+    }
+    for (auto& c : cdf_) {
+      c /= sum;
+    }
+  }
+  std::size_t operator()() {
+    const auto u = std::uniform_real_distribution<double>(0, 1)(rng_);
+    const auto it = std::lower_bound(cdf_.begin(), cdf_.end(), u);
+    return std::min<std::size_t>(it - cdf_.begin(), cdf_.size() - 1);
+  }
+private:
+  std::mt19937_64 rng_;
+  std::vector<double> cdf_;
+};
+
+/*!
+ * @brief m zipf distributed picks out of keys, hot keys are scattered
+ *        over the key space rather than being the smallest ones
+ */
+inline std::vector<std::uint64_t> zipf_trace(
+    const std::vector<std::uint64_t>& keys,
+    std::size_t m,
+    double s,
+    std::uint64_t seed
+) {
+  Zipf zipf(keys.size(), s, seed);
+  const auto perm = shuffled(keys.size(), seed + 1);
+  std::vector<std::uint64_t> trace(m);
+  for (auto& t : trace) {
+    t = keys[perm[zipf()]];
+  }
+  return trace;
+}
+
+struct Depth {
+  double avg = 0;
+  std::size_t max = 0;
+};
+
+/*!
+ * @brief average and maximal node depth of a binary tree, the root being 1
+ */
+template <typename Node>
+Depth depth(const Node* root) {
+  Depth ret;
+  std::size_t nodes = 0;
+  std::size_t sum = 0;
+  std::vector<std::pair<const Node*, std::size_t>> stack;
+  if (root) {
+    stack.emplace_back(root, 1);
+  }
+  while (!stack.empty()) {
+    const auto [node, d] = stack.back();
+    stack.pop_back();
+    nodes++;
+    sum += d;
+    ret.max = std::max(ret.max, d);
+    if (node->left()) {
+      stack.emplace_back(node->left(), d + 1);
+    }
+    if (node->right()) {
+      stack.emplace_back(node->right(), d + 1);
+    }
+  }
+  ret.avg = nodes ? static_cast<double>(sum) / nodes : 0;
+  return ret;
+}
+
+/// keeps the optimizer from dropping the measured work
+inline volatile std::size_t sink = 0;
+
+} /// namespace sal::bench
+
+#endif /// SAL_BENCH_BENCH_HH_
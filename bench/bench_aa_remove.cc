@@ -0,0 +1,35 @@
+#include <sal/aa_tree.hh>
+#include "bench.hh"
+
+/*!
+ * @brief removal throughput of large (256 byte) values
+ * usage: bench_aa_remove [keys]
+ */
+struct Blob {
+  std::uint64_t key = 0;
+  char payload[248] = {};
+  Blob() = default;
+  Blob(std::uint64_t k) : key(k) {}
+  auto operator<=>(const Blob& o) const { return this->key <=> o.key; }
+  bool operator==(const Blob& o) const { return this->key == o.key; }
+};
+
+int main(int argc, char** argv) {
+  static_assert(sizeof(Blob) == 256);
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 17);
+  const auto keys = sal::bench::shuffled(n, 1);
+  sal::AATree<Blob> tree;
+  for (const auto& key : keys) {
+    tree.insert(Blob(key));
+  }
+  const auto removals = sal::bench::shuffled(n, 2);
+  const auto seconds = sal::bench::measure([&] {
+    for (const auto& key : removals) {
+      tree.remove(Blob(key));
+    }
+  });
+  std::printf("keys %zu, value %zu B\n", n, sizeof(Blob));
+  sal::bench::report("AATree remove", n, seconds);
+
+  return 0;
+}
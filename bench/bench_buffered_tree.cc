@@ -0,0 +1,63 @@
+#include <sal/buffered_tree.hh>
+#include <sal/rb_tree.hh>
+#include <cstdio>
+#include <string>
+#include "bench.hh"
+
+/*!
+ * @brief inserts in random order, then mixes of inserts of new keys and
+ *        finds of present ones, BufferedTree against RBTree, both used as
+ *        algorithms, without the find Tree does before a write
+ * usage: bench_buffered_tree [keys]
+ */
+template <typename Set>
+void run(const char* name, const std::vector<std::uint64_t>& keys) {
+  const auto n = keys.size();
+  const std::string label = name;
+  Set set;
+  /// keys below n / 2 first, the others during the mixes
+  const auto half = n / 2;
+  sal::bench::report(
+      (label + " insert").c_str(),
+      half,
+      sal::bench::measure([&] {
+        for (std::size_t i = 0; i < half; i++) {
+          set.insert(keys[i]);
+        }
+      })
+  );
+  std::size_t next = half;
+  std::size_t found = 0;
+  for (const std::size_t share : {90, 50, 10}) {
+    const auto ops = (n - half) / 3;
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < ops; i++) {
+        if ((i * 7 + 3) % 100 < share) {
+          set.insert(keys[next++ % n]);
+        } else {
+          found += set.find(keys[(i * 7919) % half]) ? 1 : 0;
+        }
+      }
+    });
+    char mix[64];
+    std::snprintf(mix, sizeof(mix), "%s %zu%% insert", name, share);
+    sal::bench::report(mix, ops, seconds);
+  }
+  const auto seconds = sal::bench::measure([&] {
+    for (std::size_t i = 0; i < half; i++) {
+      found += set.find(keys[i]) ? 1 : 0;
+    }
+  });
+  sal::bench::report((label + " find").c_str(), half, seconds);
+  sal::bench::sink = found;
+}
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu\n", n);
+  run<sal::RBTree<std::uint64_t>>("rb tree", keys);
+  run<sal::BufferedTree<std::uint64_t>>("buffered", keys);
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include <sal/checkpoint.hh>
+#include <sal/rb_tree.hh>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bench.hh"
+
+/*!
+ * @brief incremental checkpoints of an RBTree against full snapshots, for
+ *        a growing share of the keys replaced between two checkpoints, then
+ *        the recovery from the base and every checkpoint
+ * usage: bench_checkpoint [keys] [path prefix]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const std::string prefix = argc > 2 ? argv[2] : "/tmp/bench_checkpoint";
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu\n", n);
+  sal::RBTree<data_type> tree;
+  for (const auto& key : keys) {
+    tree.insert(key);
+  }
+  const auto size = [](const std::string& path) {
+    struct stat st{};
+    ::stat(path.c_str(), &st);
+    return static_cast<std::size_t>(st.st_size);
+  };
+  const auto base = prefix + ".base";
+  {
+    const auto fd = ::open(base.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    const auto seconds = sal::bench::measure([&] { tree.save(fd); });
+    ::close(fd);
+    tree.clean();
+    std::printf(
+        "%-24s %12zu bytes %10.2f ms\n",
+        "full snapshot",
+        size(base),
+        seconds * 1e3
+    );
+  }
+  /// keys are replaced in shuffled order by keys past n
+  std::size_t next = 0;
+  std::vector<std::string> paths;
+  for (const double rate : {0.0001, 0.001, 0.01, 0.1}) {
+    const auto changes = static_cast<std::size_t>(n * rate);
+    for (std::size_t i = 0; i < changes; i++, next++) {
+      tree.remove(keys[next % n]);
+      tree.insert(n + next);
+    }
+    paths.push_back(prefix + "." + std::to_string(paths.size() + 1));
+    const auto& path = paths.back();
+    const auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = false;
+    const auto seconds = sal::bench::measure([&] {
+      ok = tree.checkpoint(fd);
+    });
+    ::close(fd);
+    char name[64];
+    std::snprintf(name, sizeof(name), "checkpoint %.2f%%", rate * 100);
+    std::printf(
+        "%-24s %12zu bytes %10.2f ms %s\n",
+        name,
+        size(path),
+        seconds * 1e3,
+        ok ? "" : "FAILED"
+    );
+  }
+  {
+    sal::RBTree<data_type> recovered;
+    bool ok = true;
+    const auto seconds = sal::bench::measure([&] {
+      auto fd = ::open(base.c_str(), O_RDONLY);
+      ok = recovered.load(fd);
+      ::close(fd);
+      for (const auto& path : paths) {
+        fd = ::open(path.c_str(), O_RDONLY);
+        ok = ok && recovered.apply(fd);
+        ::close(fd);
+      }
+    });
+    std::printf(
+        "%-24s %12s       %10.2f ms %s\n",
+        "recover",
+        "",
+        seconds * 1e3,
+        ok ? "" : "FAILED"
+    );
+  }
+  std::remove(base.c_str());
+  for (const auto& path : paths) {
+    std::remove(path.c_str());
+  }
+
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <sal/disk_b_tree.hh>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include "bench.hh"
+
+/*!
+ * @brief random finds, inserts and removes in a DiskBTree for a buffer pool
+ *        of 1% to 100% of the pages of the tree, with the reads and writes
+ *        of pages per op; the file stays in the page cache of the system,
+ *        so the times are those of pread and pwrite, not of the device;
+ *        every pool size starts over from a copy of the tree as built
+ * usage: bench_disk_b_tree [keys] [ops] [path]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  using Tree = sal::DiskBTree<data_type>;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto m = sal::bench::arg(argc, argv, 2, 1'000'000);
+  const std::string base = argc > 3 ? argv[3] : "/tmp/bench_disk_b_tree";
+  const auto path = base + ".work";
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::uint64_t pages = 0;
+  {
+    /// present keys are even, the inserted ones odd
+    std::remove(base.c_str());
+    Tree tree(1 << 16);
+    tree.open(base.c_str());
+    const auto seconds = sal::bench::measure([&] {
+      for (const auto& key : keys) {
+        tree.insert(2 * key);
+      }
+      tree.close();
+    });
+    pages = tree.pages();
+    sal::bench::report("build", n, seconds);
+  }
+  std::printf("keys %zu pages %zu ops %zu\n", n, std::size_t(pages), m);
+  const auto row = [](const char* name, std::size_t ops, double seconds,
+      const sal::disk::BufferPool::Stats& stats) {
+    std::printf(
+        "%-20s %10.3f Mops/s %8.3f reads/op %8.3f writes/op\n",
+        name,
+        ops / seconds / 1e6,
+        double(stats.reads) / ops,
+        double(stats.writes) / ops
+    );
+  };
+  for (const double share : {0.01, 0.02, 0.05, 0.1, 0.25, 0.5, 1.0}) {
+    std::filesystem::copy_file(
+        base,
+        path,
+        std::filesystem::copy_options::overwrite_existing
+    );
+    Tree tree(static_cast<std::size_t>(pages * share));
+    if (!tree.open(path.c_str())) {
+      std::printf("cannot open %s\n", path.c_str());
+      return 1;
+    }
+    /// warm up the pool
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < m; i++) {
+      found += tree.find(2 * keys[(i * 7919) % n]);
+    }
+    char name[64];
+    tree.pool().reset();
+    auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < m; i++) {
+        found += tree.find(2 * keys[i % n]);
+      }
+    });
+    std::snprintf(name, sizeof(name), "pool %5.1f%% find", share * 100);
+    row(name, m, seconds, tree.pool().stats());
+    tree.pool().reset();
+    seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < m; i++) {
+        tree.insert(2 * keys[i % n] + 1);
+      }
+    });
+    std::snprintf(name, sizeof(name), "pool %5.1f%% insert", share * 100);
+    row(name, m, seconds, tree.pool().stats());
+    tree.pool().reset();
+    seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < m; i++) {
+        tree.remove(2 * keys[i % n] + 1);
+      }
+      tree.flush();
+    });
+    std::snprintf(name, sizeof(name), "pool %5.1f%% remove", share * 100);
+    row(name, m, seconds, tree.pool().stats());
+    sal::bench::sink = found;
+  }
+  std::remove(base.c_str());
+  std::remove(path.c_str());
+
+  return 0;
+}
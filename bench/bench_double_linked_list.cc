@@ -0,0 +1,128 @@
+#include <sal/double_linked_list.hh>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief bulk operations of DoubleLinkedList against going through a
+ *        std::vector copy
+ * usage: bench_double_linked_list [values] [rounds]
+ */
+using data_type = std::uint64_t;
+using list_type = sal::DoubleLinkedList<data_type>;
+
+/*!
+ * @brief copies the values out, sorts the copy and writes it back
+ */
+void vectorSort(list_type& list, std::vector<data_type>& buffer) {
+  buffer.clear();
+  for (auto* it = list.root(); it; it = it->next()) {
+    buffer.push_back(it->value());
+  }
+  std::stable_sort(buffer.begin(), buffer.end());
+  auto* it = list.root();
+  for (const auto& val : buffer) {
+    it->value() = val;
+    it = it->next();
+  }
+}
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 20);
+  const auto rounds = sal::bench::arg(argc, argv, 2, 100);
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("values %zu\n", n);
+  {
+    /// a throwaway list first, so that neither side pays the heap growth
+    list_type list;
+    list.append(keys);
+  }
+  {
+    list_type list;
+    const auto seconds = sal::bench::measure([&] {
+      for (const auto& key : keys) {
+        list.add(key);
+      }
+    });
+    sal::bench::report("add one by one", n, seconds);
+  }
+  {
+    list_type list;
+    const auto seconds = sal::bench::measure([&] {
+      list.append(keys);
+    });
+    sal::bench::report("append(range)", n, seconds);
+  }
+  {
+    /// the nodes stay where add() put them, ordered by allocation
+    list_type list;
+    list.append(keys);
+    std::vector<data_type> buffer;
+    const auto seconds = sal::bench::measure([&] {
+      vectorSort(list, buffer);
+    });
+    sal::bench::report("copy, std::stable_sort, copy back", n, seconds);
+  }
+  {
+    list_type list;
+    list.append(keys);
+    const auto seconds = sal::bench::measure([&] {
+      list.sort();
+    });
+    sal::bench::report("sort()", n, seconds);
+    sal::bench::sink = list.root()->value();
+  }
+  {
+    /// concatenation, the halves move back and forth between two lists
+    list_type a;
+    list_type b;
+    a.append(keys);
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < rounds; i++) {
+        list_type& from = i % 2 ? b : a;
+        list_type& to = i % 2 ? a : b;
+        for (auto* it = from.root(); it; it = it->next()) {
+          to.add(it->value());
+        }
+        while (from.root()) {
+          from.popFront();
+        }
+      }
+    });
+    sal::bench::report("concatenate by copy", rounds, seconds);
+  }
+  {
+    list_type a;
+    list_type b;
+    a.append(keys);
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < rounds; i++) {
+        list_type& from = i % 2 ? b : a;
+        list_type& to = i % 2 ? a : b;
+        to.splice(to.nil, from);
+      }
+    });
+    sal::bench::report("splice()", rounds, seconds);
+  }
+  const std::size_t capacities[] = {0, list_type::FREE_CAPACITY};
+  for (const auto capacity : capacities) {
+    /// queue like churn, the oldest value leaves for every one added
+    list_type list(capacity);
+    const std::size_t queue = 1000;
+    for (std::size_t i = 0; i < queue; i++) {
+      list.add(i);
+    }
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = queue; i < n + queue; i++) {
+        list.del(i - queue);
+        list.add(i);
+      }
+    });
+    sal::bench::report(
+        capacity ? "del+add, free list" : "del+add, no free list",
+        n,
+        seconds
+    );
+  }
+
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <sal/double_linked_list.hh>
+#include <sal/indexed_linked_list.hh>
+#include "bench.hh"
+
+/*!
+ * @brief add, get and del of random keys at growing list sizes
+ * usage: bench_indexed_linked_list [budget]
+ *
+ * a DoubleLinkedList lookup walks the list, its share of the lookups and
+ * removals is capped at budget / n so that the large sizes stay affordable
+ */
+template <typename List>
+void run(
+    const char* name,
+    const std::vector<std::uint64_t>& keys,
+    std::size_t ops
+) {
+  char label[64];
+  const auto n = keys.size();
+  ops = std::min(ops, n);
+  List list;
+  const auto add = sal::bench::measure([&] {
+    for (const auto& key : keys) {
+      list.add(key);
+    }
+  });
+  std::snprintf(label, sizeof(label), "%s add %zu", name, n);
+  sal::bench::report(label, n, add);
+  const auto trace = sal::bench::shuffled(n, 3);
+  std::size_t found = 0;
+  const auto get = sal::bench::measure([&] {
+    for (std::size_t i = 0; i < ops; i++) {
+      found += static_cast<bool>(list.get(trace[i]));
+    }
+  });
+  sal::bench::sink = found;
+  std::snprintf(label, sizeof(label), "%s get %zu", name, n);
+  sal::bench::report(label, ops, get);
+  const auto del = sal::bench::measure([&] {
+    for (std::size_t i = 0; i < ops; i++) {
+      found += list.del(trace[i]);
+    }
+  });
+  sal::bench::sink = found;
+  std::snprintf(label, sizeof(label), "%s del %zu", name, n);
+  sal::bench::report(label, ops, del);
+}
+
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto budget = sal::bench::arg(argc, argv, 1, 1ull << 28);
+  for (const std::size_t n : {1000, 100000, 1000000}) {
+    const auto keys = sal::bench::shuffled(n, 1);
+    run<sal::DoubleLinkedList<data_type>>(
+        "DoubleLinkedList", keys, budget / n
+    );
+    run<sal::IndexedLinkedList<data_type>>("IndexedLinkedList", keys, n);
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <sal/intrusive_rb_tree.hh>
+#include <sal/rb_tree.hh>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief the sliding window of bench_rb_remove, once with RBTree allocating
+ *        a node per insert and once over preallocated connections linked
+ *        into an IntrusiveRBTree
+ * usage: bench_intrusive_rb_tree [operations] [window]
+ */
+using data_type = std::uint64_t;
+
+struct Connection : sal::RBTreeHook<> {
+  data_type id = 0;
+  friend bool operator<(const Connection& a, const Connection& b) {
+    return a.id < b.id;
+  }
+};
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto w = sal::bench::arg(argc, argv, 2, 1 << 16);
+  const auto key = [](std::uint64_t i) {
+    return i * 0x9e3779b97f4a7c15ull;
+  };
+  std::printf("window %zu\n", w);
+  {
+    sal::RBTree<data_type> tree;
+    for (std::size_t i = 0; i < w; i++) {
+      tree.insert(key(i));
+    }
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = w; i < n + w; i++) {
+        tree.insert(key(i));
+        tree.remove(key(i - w));
+      }
+    });
+    sal::bench::report("RBTree insert+remove", n, seconds);
+  }
+  {
+    /// a slot is reused once its previous connection left the window
+    std::vector<Connection> pool(w);
+    sal::IntrusiveRBTree<Connection> tree;
+    for (std::size_t i = 0; i < w; i++) {
+      pool[i].id = key(i);
+      tree.insert(pool[i]);
+    }
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = w; i < n + w; i++) {
+        auto& conn = tree.remove(pool[i % w]);
+        conn.id = key(i);
+        tree.insert(conn);
+      }
+    });
+    sal::bench::report("IntrusiveRBTree remove+insert", n, seconds);
+  }
+
+  return 0;
+}
@@ -0,0 +1,92 @@
+#include <sal/lru_cache.hh>
+#include <list>
+#include <unordered_map>
+#include "bench.hh"
+
+/*!
+ * @brief look-aside cache over a zipf trace, a miss puts the key
+ * usage: bench_lru_cache [keys] [accesses] [skew x100]
+ */
+using data_type = std::uint64_t;
+
+/*!
+ * @brief the hand rolled cache it replaces, a list plus a separate map,
+ *        i.e. two allocations per entry
+ */
+class ListMapCache {
+public:
+  ListMapCache(std::size_t capacity) : capacity_(capacity) {
+    map_.reserve(capacity);
+  }
+  data_type* get(data_type key) {
+    const auto it = map_.find(key);
+    if (it == map_.end()) {
+      return nullptr;
+    }
+    list_.splice(list_.begin(), list_, it->second);
+    return &it->second->second;
+  }
+  data_type* put(data_type key, data_type val) {
+    if (list_.size() == capacity_) {
+      map_.erase(list_.back().first);
+      list_.pop_back();
+    }
+    list_.emplace_front(key, val);
+    map_.emplace(key, list_.begin());
+    return &list_.front().second;
+  }
+private:
+  using list_type = std::list<std::pair<data_type, data_type>>;
+  std::size_t capacity_;
+  list_type list_;
+  std::unordered_map<data_type, list_type::iterator> map_;
+};
+
+template <typename Cache>
+void run(
+    const char* name,
+    Cache& cache,
+    const std::vector<data_type>& trace
+) {
+  std::size_t hits = 0;
+  const auto seconds = sal::bench::measure([&] {
+    for (const auto& key : trace) {
+      if (cache.get(key)) {
+        hits++;
+      } else {
+        cache.put(key, key);
+      }
+    }
+  });
+  sal::bench::report(name, trace.size(), seconds);
+  std::printf(
+      "%-32s hit ratio %.4f\n",
+      "", static_cast<double>(hits) / trace.size()
+  );
+}
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 20);
+  const auto m = sal::bench::arg(argc, argv, 2, 1 << 23);
+  const auto s = sal::bench::arg(argc, argv, 3, 90) / 100.0;
+  const auto keys = sal::bench::shuffled(n, 1);
+  const auto trace = sal::bench::zipf_trace(keys, m, s, 2);
+  std::printf("keys %zu, accesses %zu, zipf s %.2f\n", n, m, s);
+  for (const auto capacity : {n / 100, n / 10}) {
+    std::printf("capacity %zu\n", capacity);
+    {
+      ListMapCache cache(capacity);
+      run("list + unordered_map", cache, trace);
+    }
+    {
+      sal::LRUCache<data_type, data_type> cache(capacity);
+      run("LRUCache", cache, trace);
+    }
+    {
+      sal::LRUCache<data_type, data_type> cache(capacity, capacity * 4 / 5);
+      run("LRUCache segmented 80%", cache, trace);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include <sal/lsm_set.hh>
+#include <sal/rb_tree.hh>
+#include <sal/tree.hh>
+#include <cstdio>
+#include <string>
+#include "bench.hh"
+
+/*!
+ * @brief inserts in random order, then finds of present and of absent keys,
+ *        LsmSet in memory and on disk against Tree<RBTree>
+ * usage: bench_lsm_set [keys] [directory]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const std::string directory = argc > 2 ? argv[2] : "";
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu\n", n);
+  /// present keys are even, absent ones odd
+  const auto run = [&](const char* name, auto& set) {
+    std::string label = name;
+    sal::bench::report(
+        (label + " insert").c_str(),
+        n,
+        sal::bench::measure([&] {
+          for (const auto& key : keys) {
+            set.insert(2 * key);
+          }
+        })
+    );
+    if constexpr (requires { set.compact(); }) {
+      set.compact();
+    }
+    std::size_t found = 0;
+    sal::bench::report(
+        (label + " find hit").c_str(),
+        n,
+        sal::bench::measure([&] {
+          for (const auto& key : keys) {
+            found += set.find(2 * key);
+          }
+        })
+    );
+    sal::bench::report(
+        (label + " find miss").c_str(),
+        n,
+        sal::bench::measure([&] {
+          for (const auto& key : keys) {
+            found += set.find(2 * key + 1);
+          }
+        })
+    );
+    sal::bench::sink = found;
+  };
+  {
+    sal::Tree<data_type, sal::RBTree> tree;
+    run("rb tree", tree);
+  }
+  {
+    sal::LsmSet<data_type> set;
+    run("lsm", set);
+    std::printf("lsm runs %zu\n", set.runs());
+  }
+  if (!directory.empty()) {
+    sal::LsmSet<data_type>::Options options;
+    options.directory = directory;
+    sal::LsmSet<data_type> set(options);
+    run("lsm mapped", set);
+    std::printf("lsm mapped runs %zu\n", set.runs());
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <sal/mapped_tree.hh>
+#include <sal/rb_tree.hh>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include "bench.hh"
+
+/*!
+ * @brief time until an RBTree of n keys answers queries: rebuilt by
+ *        inserting every key, loaded from a snapshot, or mapped from an
+ *        image; then the lookup rate of the loaded and the mapped tree
+ * usage: bench_mapped_tree [keys] [lookups] [directory]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto m = sal::bench::arg(argc, argv, 2, 1'000'000);
+  const std::string dir = argc > 3 ? argv[3] : "/tmp";
+  const auto snapshotPath = dir + "/bench_mapped_tree.snapshot";
+  const auto imagePath = dir + "/bench_mapped_tree.image";
+  const auto keys = sal::bench::shuffled(n, 1);
+  const auto lookups = sal::bench::shuffled(n, 2);
+  std::printf("keys %zu, lookups %zu\n", n, m);
+  {
+    sal::RBTree<data_type> tree;
+    for (const auto& key : keys) {
+      tree.insert(key);
+    }
+    const auto fd =
+        ::open(snapshotPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    tree.save(fd);
+    ::close(fd);
+    const auto seconds = sal::bench::measure([&] {
+      const auto fd =
+          ::open(imagePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      sal::MappedTree<data_type>::write(fd, tree.root());
+      ::close(fd);
+    });
+    sal::bench::report("write image", n, seconds);
+  }
+  std::printf("startup\n");
+  {
+    sal::RBTree<data_type> tree;
+    const auto seconds = sal::bench::measure([&] {
+      for (data_type key = 0; key < n; key++) {
+        tree.insert(key);
+      }
+    });
+    sal::bench::report("insert one by one, sorted", n, seconds);
+  }
+  sal::RBTree<data_type> loaded;
+  {
+    const auto seconds = sal::bench::measure([&] {
+      const auto fd = ::open(snapshotPath.c_str(), O_RDONLY);
+      loaded.load(fd);
+      ::close(fd);
+    });
+    sal::bench::report("snapshot load", n, seconds);
+  }
+  sal::MappedTree<data_type> mapped;
+  {
+    const auto seconds = sal::bench::measure([&] {
+      mapped.open(imagePath.c_str());
+      sal::bench::sink = mapped.find(lookups[0]) != nullptr;
+    });
+    sal::bench::report("mmap open + first find", n, seconds);
+  }
+  std::printf("lookups\n");
+  {
+    std::size_t found = 0;
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < m; i++) {
+        found += loaded.find(lookups[i]) != nullptr;
+      }
+    });
+    sal::bench::sink = found;
+    sal::bench::report("RBTree find", m, seconds);
+  }
+  {
+    std::size_t found = 0;
+    const auto seconds = sal::bench::measure([&] {
+      for (std::size_t i = 0; i < m; i++) {
+        found += mapped.find(lookups[i]) != nullptr;
+      }
+    });
+    sal::bench::sink = found;
+    sal::bench::report("MappedTree find", m, seconds);
+  }
+  std::remove(snapshotPath.c_str());
+  std::remove(imagePath.c_str());
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include <sal/parallel.hh>
+#include <sal/rb_tree.hh>
+#include <sal/thread_pool.hh>
+#include <sal/tree.hh>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief a Tree<RBTree> of unsorted keys, about a third repeated, inserted
+ *        one by one, then built by Tree::build on 1 to N threads, with the
+ *        time of the sort and the deduplication alone
+ * usage: bench_parallel_build [keys] [threads]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  using Tree = sal::Tree<data_type, sal::RBTree>;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto most = sal::bench::arg(
+      argc,
+      argv,
+      2,
+      std::max(std::thread::hardware_concurrency(), 1u)
+  );
+  std::vector<data_type> keys(n);
+  std::mt19937_64 rng(48);
+  for (auto& key : keys) {
+    key = rng() % n;
+  }
+  std::printf("keys %zu\n", n);
+  {
+    auto tree = std::make_unique<Tree>();
+    const auto seconds = sal::bench::measure([&] {
+      for (const auto& key : keys) {
+        tree->insert(key);
+      }
+    });
+    sal::bench::report("insert", n, seconds);
+  }
+  for (std::size_t threads = 1; threads <= most; threads *= 2) {
+    sal::ThreadPool pool(threads);
+    auto copy = keys;
+    const auto sorting = sal::bench::measure([&] {
+      sal::parallel::sort(pool, copy);
+      sal::parallel::unique(pool, copy);
+    });
+    char name[64];
+    std::snprintf(name, sizeof(name), "sort unique %zu threads", threads);
+    sal::bench::report(name, n, sorting);
+    auto tree = std::make_unique<Tree>();
+    const auto seconds = sal::bench::measure([&] {
+      tree->build(keys, pool);
+    });
+    std::snprintf(name, sizeof(name), "build %zu threads", threads);
+    sal::bench::report(name, n, seconds);
+    sal::bench::sink = tree->size();
+  }
+
+  return 0;
+}
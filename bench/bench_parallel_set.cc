@@ -0,0 +1,107 @@
+#include <sal/parallel.hh>
+#include <sal/rb_tree.hh>
+#include <sal/thread_pool.hh>
+#include <sal/tree.hh>
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief values of the subtree in order, on one thread
+ */
+template <typename Node>
+std::vector<std::uint64_t> inorder(const Node* node) {
+  std::vector<std::uint64_t> ret;
+  std::vector<const Node*> stack;
+  for (auto* it = node; it || !stack.empty(); it = it->right()) {
+    for (; it; it = it->left()) {
+      stack.push_back(it);
+    }
+    it = stack.back();
+    stack.pop_back();
+    ret.push_back(it->value());
+  }
+  return ret;
+}
+
+/*!
+ * @brief two Tree<RBTree> of n keys drawn from 0..2n-1, half of them in
+ *        both, combined by Tree::operator+, by a sequential merge of their
+ *        values and by the parallel set operations on 1 to N threads
+ * usage: bench_parallel_set [keys] [threads] [grain]
+ */
+int main(int argc, char** argv) {
+  using Tree = sal::Tree<std::uint64_t, sal::RBTree>;
+  const auto n = sal::bench::arg(argc, argv, 1, 100'000'000);
+  const auto most = sal::bench::arg(
+      argc,
+      argv,
+      2,
+      std::max(std::thread::hardware_concurrency(), 1u)
+  );
+  const auto grain = sal::bench::arg(argc, argv, 3, sal::parallel::GRAIN);
+  auto keys = sal::bench::shuffled(2 * n, 50);
+  std::vector<std::uint64_t> a(keys.begin(), keys.begin() + n);
+  std::vector<std::uint64_t> b(keys.begin() + n / 2, keys.begin() + n + n / 2);
+  std::vector<std::uint64_t>().swap(keys);
+  std::printf("keys %zu + %zu, grain %zu\n", n, n, grain);
+  auto ta = std::make_unique<Tree>();
+  auto tb = std::make_unique<Tree>();
+  {
+    sal::ThreadPool pool;
+    ta->build(a, pool);
+    tb->build(b, pool);
+  }
+  {
+    const auto seconds = sal::bench::measure([&] {
+      const auto u = *ta + *tb;
+      sal::bench::sink = u.size();
+    });
+    sal::bench::report("operator+", 2 * n, seconds);
+  }
+  {
+    /// the same values in bare trees, for their nodes
+    sal::ThreadPool one(1);
+    sal::RBTree<std::uint64_t> ra;
+    sal::RBTree<std::uint64_t> rb;
+    ra.build(a, one);
+    rb.build(b, one);
+    std::vector<std::uint64_t>().swap(a);
+    std::vector<std::uint64_t>().swap(b);
+    const auto seconds = sal::bench::measure([&] {
+      const auto va = inorder(ra.root());
+      const auto vb = inorder(rb.root());
+      std::vector<std::uint64_t> out;
+      out.reserve(va.size() + vb.size());
+      std::set_union(va.begin(), va.end(), vb.begin(), vb.end(),
+          std::back_inserter(out));
+      sal::RBTree<std::uint64_t> u;
+      sal::bench::sink = u.build(std::move(out), one, true);
+    });
+    sal::bench::report("sequential merge union", 2 * n, seconds);
+  }
+  for (std::size_t threads = 1; threads <= most; threads *= 2) {
+    sal::ThreadPool pool(threads);
+    char name[64];
+    std::snprintf(name, sizeof(name), "parallelUnion %zu threads", threads);
+    sal::bench::report(name, 2 * n, sal::bench::measure([&] {
+      sal::bench::sink = ta->parallelUnion(*tb, pool, grain).size();
+    }));
+    std::snprintf(name, sizeof(name), "parallelIntersection %zu threads",
+        threads);
+    sal::bench::report(name, 2 * n, sal::bench::measure([&] {
+      sal::bench::sink = ta->parallelIntersection(*tb, pool, grain).size();
+    }));
+    std::snprintf(name, sizeof(name), "parallelDifference %zu threads",
+        threads);
+    sal::bench::report(name, 2 * n, sal::bench::measure([&] {
+      sal::bench::sink = ta->parallelDifference(*tb, pool, grain).size();
+    }));
+  }
+
+  return 0;
+}
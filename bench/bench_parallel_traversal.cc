@@ -0,0 +1,111 @@
+#include <sal/aa_tree.hh>
+#include <sal/bs_tree.hh>
+#include <sal/parallel.hh>
+#include <sal/rb_tree.hh>
+#include <sal/thread_pool.hh>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief sum of the values in order on one thread, the baseline of reduce
+ */
+template <typename Node>
+std::uint64_t sum(const Node* node) {
+  std::uint64_t ret = 0;
+  std::vector<const Node*> stack;
+  for (auto* it = node; it || !stack.empty(); it = it->right()) {
+    for (; it; it = it->left()) {
+      stack.push_back(it);
+    }
+    it = stack.back();
+    stack.pop_back();
+    ret += it->value();
+  }
+  return ret;
+}
+
+/*!
+ * @brief forEach, reduce and assign of a tree on 1 to most threads, against
+ *        a sequential sum and the copy constructor
+ */
+template <typename Tree>
+void run(const char* tree, const Tree& source, std::size_t n,
+    std::size_t most) {
+  char name[64];
+  std::snprintf(name, sizeof(name), "%s sum", tree);
+  sal::bench::report(name, n, sal::bench::measure([&] {
+    sal::bench::sink = sum(source.root());
+  }));
+  {
+    std::unique_ptr<Tree> copy;
+    std::snprintf(name, sizeof(name), "%s copy constructor", tree);
+    sal::bench::report(name, n, sal::bench::measure([&] {
+      copy = std::make_unique<Tree>(source);
+    }));
+  }
+  for (std::size_t threads = 1; threads <= most; threads *= 2) {
+    sal::ThreadPool pool(threads);
+    std::atomic<std::uint64_t> odd = 0;
+    std::snprintf(name, sizeof(name), "%s forEach %zu threads", tree, threads);
+    sal::bench::report(name, n, sal::bench::measure([&] {
+      sal::parallel::forEach(pool, source.root(), [&](std::uint64_t val) {
+        if (val % 1024 == 1) {
+          odd.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }));
+    std::snprintf(name, sizeof(name), "%s reduce %zu threads", tree, threads);
+    sal::bench::report(name, n, sal::bench::measure([&] {
+      sal::bench::sink = sal::parallel::reduce(pool, source.root(),
+          std::uint64_t{0}, [](std::uint64_t a, std::uint64_t b) {
+            return a + b;
+          });
+    }));
+    auto copy = std::make_unique<Tree>();
+    std::snprintf(name, sizeof(name), "%s assign %zu threads", tree, threads);
+    sal::bench::report(name, n, sal::bench::measure([&] {
+      copy->assign(source, pool);
+    }));
+    sal::bench::sink = odd;
+  }
+}
+
+/*!
+ * @brief RBTree, AATree and BSTree of unique shuffled keys
+ * usage: bench_parallel_traversal [keys] [threads]
+ */
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 100'000'000);
+  const auto most = sal::bench::arg(
+      argc,
+      argv,
+      2,
+      std::max(std::thread::hardware_concurrency(), 1u)
+  );
+  std::printf("keys %zu\n", n);
+  {
+    sal::ThreadPool pool;
+    auto rb = std::make_unique<sal::RBTree<std::uint64_t>>();
+    rb->build(sal::bench::shuffled(n, 49), pool);
+    run("rb", *rb, n, most);
+  }
+  {
+    sal::ThreadPool pool;
+    auto aa = std::make_unique<sal::AATree<std::uint64_t>>();
+    aa->build(sal::bench::shuffled(n, 49), pool);
+    run("aa", *aa, n, most);
+  }
+  {
+    auto bs = std::make_unique<sal::BSTree<std::uint64_t>>();
+    for (const auto key : sal::bench::shuffled(n, 49)) {
+      bs->insert(key);
+    }
+    run("bs", *bs, n, most);
+  }
+
+  return 0;
+}
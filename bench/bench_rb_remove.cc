@@ -0,0 +1,31 @@
+#include <sal/rb_tree.hh>
+#include "bench.hh"
+
+/*!
+ * @brief remove heavy sliding window: every insert beyond the window size
+ *        evicts the oldest key
+ * usage: bench_rb_remove [operations] [window]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const auto w = sal::bench::arg(argc, argv, 2, 1 << 16);
+  /// multiplicative hashing scatters consecutive ids over the key space
+  const auto key = [](std::uint64_t i) {
+    return i * 0x9e3779b97f4a7c15ull;
+  };
+  sal::RBTree<data_type> tree;
+  for (std::size_t i = 0; i < w; i++) {
+    tree.insert(key(i));
+  }
+  const auto seconds = sal::bench::measure([&] {
+    for (std::size_t i = w; i < n + w; i++) {
+      tree.insert(key(i));
+      tree.remove(key(i - w));
+    }
+  });
+  std::printf("window %zu\n", w);
+  sal::bench::report("RBTree insert+remove", n, seconds);
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include <malloc.h>
+#include <sal/aa_tree.hh>
+#include <sal/avl_tree.hh>
+#include <sal/bs_tree.hh>
+#include <sal/rb_tree.hh>
+#include <sal/scapegoat_tree.hh>
+#include <sal/treap.hh>
+#include "bench.hh"
+
+/*!
+ * @brief heap bytes per element and random insert/lookup/remove throughput
+ * usage: bench_scapegoat_tree [keys]
+ */
+template <typename Tree>
+void run(const char* name, const std::vector<std::uint64_t>& keys) {
+  const auto before = mallinfo2().uordblks;
+  auto* tree = new Tree();
+  const auto insert = sal::bench::measure([&] {
+    for (const auto& key : keys) {
+      tree->insert(key);
+    }
+  });
+  const auto bytes = mallinfo2().uordblks - before;
+  std::size_t found = 0;
+  const auto lookup = sal::bench::measure([&] {
+    for (const auto& key : keys) {
+      found += static_cast<bool>(tree->find(key));
+    }
+  });
+  sal::bench::sink = found;
+  const auto remove = sal::bench::measure([&] {
+    for (const auto& key : keys) {
+      tree->remove(key);
+    }
+  });
+  delete tree;
+  const auto n = keys.size();
+  std::printf(
+      "%-14s node %3zu B heap %6.1f B/elem | "
+      "insert %8.3f lookup %8.3f remove %8.3f Mops/s\n",
+      name, sizeof(typename Tree::node_type),
+      static_cast<double>(bytes) / n,
+      n / insert / 1e6, n / lookup / 1e6, n / remove / 1e6
+  );
+}
+
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 20);
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu, value %zu B\n", n, sizeof(data_type));
+  run<sal::ScapegoatTree<data_type>>("ScapegoatTree", keys);
+  run<sal::RBTree<data_type>>("RBTree", keys);
+  run<sal::AATree<data_type>>("AATree", keys);
+  run<sal::AVLTree<data_type>>("AVLTree", keys);
+  run<sal::Treap<data_type>>("Treap", keys);
+  run<sal::BSTree<data_type>>("BSTree", keys);
+
+  return 0;
+}
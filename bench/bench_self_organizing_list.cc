@@ -0,0 +1,96 @@
+#include <sal/self_organizing_list.hh>
+#include "bench.hh"
+
+/*!
+ * @brief replays access streams against every reorganization policy
+ * usage: bench_self_organizing_list [keys] [accesses] [hot set]
+ *
+ * the depth pass walks from the head to each key before the get(), the
+ * timed pass only does the get()s
+ */
+using data_type = std::uint64_t;
+
+template <typename Policy>
+void run(
+    const char* name,
+    const std::vector<data_type>& keys,
+    const std::vector<data_type>& trace
+) {
+  double depth = 0;
+  {
+    sal::SelfOrganizingList<data_type, Policy> list;
+    for (const auto& key : keys) {
+      list.add(key);
+    }
+    std::size_t sum = 0;
+    for (const auto& key : trace) {
+      for (auto* it = list.root(); it && it->value() != key; it = it->next()) {
+        sum++;
+      }
+      sum++;
+      list.get(key);
+    }
+    depth = static_cast<double>(sum) / trace.size();
+  }
+  sal::SelfOrganizingList<data_type, Policy> list;
+  for (const auto& key : keys) {
+    list.add(key);
+  }
+  std::size_t found = 0;
+  const auto seconds = sal::bench::measure([&] {
+    for (const auto& key : trace) {
+      found += static_cast<bool>(list.get(key));
+    }
+  });
+  sal::bench::sink = found;
+  char label[64];
+  std::snprintf(label, sizeof(label), "  %s", name);
+  sal::bench::report(label, trace.size(), seconds);
+  std::printf("%-32s avg depth %.2f\n", "", depth);
+}
+
+void policies(
+    const char* stream,
+    const std::vector<data_type>& keys,
+    const std::vector<data_type>& trace
+) {
+  std::printf("%s\n", stream);
+  run<sal::so::Transpose>("Transpose", keys, trace);
+  run<sal::so::MoveToFront>("MoveToFront", keys, trace);
+  run<sal::so::MoveAheadK<4>>("MoveAheadK<4>", keys, trace);
+  run<sal::so::FrequencyCount>("FrequencyCount", keys, trace);
+}
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 1000);
+  const auto m = sal::bench::arg(argc, argv, 2, 1 << 20);
+  const auto h = sal::bench::arg(argc, argv, 3, 32);
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu, accesses %zu, hot set %zu\n", n, m, h);
+  {
+    const auto perm = sal::bench::shuffled(m, 2);
+    std::vector<data_type> trace(m);
+    for (std::size_t i = 0; i < m; i++) {
+      trace[i] = keys[perm[i] % n];
+    }
+    policies("uniform", keys, trace);
+  }
+  policies("zipf 0.99", keys, sal::bench::zipf_trace(keys, m, 0.99, 3));
+  {
+    /// 90% of the accesses go to a hot set that moves every m / 16 accesses
+    std::mt19937_64 rng(4);
+    std::vector<data_type> trace(m);
+    std::size_t base = 0;
+    for (std::size_t i = 0; i < m; i++) {
+      if (i % (m / 16) == 0) {
+        base = rng() % n;
+      }
+      trace[i] = rng() % 10 ?
+          keys[(base + rng() % h) % n] :
+          keys[rng() % n];
+    }
+    policies("shifting hot set", keys, trace);
+  }
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <sal/rb_tree.hh>
+#include <sal/snapshot.hh>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#include "bench.hh"
+
+/*!
+ * @brief snapshot save and load of an RBTree through a file, against
+ *        rebuilding it by inserting every key
+ * usage: bench_snapshot [keys] [path]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  const char* path = argc > 2 ? argv[2] : "/tmp/bench_snapshot.bin";
+  const auto keys = sal::bench::shuffled(n, 1);
+  std::printf("keys %zu\n", n);
+  sal::RBTree<data_type> tree;
+  for (const auto& key : keys) {
+    tree.insert(key);
+  }
+  {
+    const auto fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool saved = false;
+    const auto seconds = sal::bench::measure([&] {
+      saved = tree.save(fd);
+    });
+    ::close(fd);
+    sal::bench::report(saved ? "save" : "save FAILED", n, seconds);
+  }
+  {
+    sal::RBTree<data_type> loaded;
+    const auto fd = ::open(path, O_RDONLY);
+    bool ok = false;
+    const auto seconds = sal::bench::measure([&] {
+      ok = loaded.load(fd);
+    });
+    ::close(fd);
+    sal::bench::report(ok ? "load" : "load FAILED", n, seconds);
+    const auto depth = sal::bench::depth(loaded.root());
+    std::printf("%-32s %.2f avg %zu max\n", "depth", depth.avg, depth.max);
+  }
+  {
+    /// what load replaces, the keys come sorted out of the snapshot
+    sal::RBTree<data_type> rebuilt;
+    const auto seconds = sal::bench::measure([&] {
+      for (data_type key = 0; key < n; key++) {
+        rebuilt.insert(key);
+      }
+    });
+    sal::bench::report("insert one by one, sorted", n, seconds);
+  }
+  std::remove(path);
+
+  return 0;
+}
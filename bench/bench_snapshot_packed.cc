@@ -0,0 +1,90 @@
+#include <sal/rb_tree.hh>
+#include <sal/snapshot.hh>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief size and decoding speed of packed snapshots against raw ones, for
+ *        a dense range, a range with gaps and sparse random keys
+ * usage: bench_snapshot_packed [keys]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  namespace snapshot = sal::snapshot;
+  const auto n = sal::bench::arg(argc, argv, 1, 10'000'000);
+  std::printf("keys %zu\n", n);
+  std::mt19937_64 random(42);
+  for (const char* name : {"dense", "gaps", "sparse"}) {
+    const std::string kind = name;
+    sal::RBTree<data_type> tree;
+    if (kind == "sparse") {
+      std::set<data_type> keys;
+      while (keys.size() < n) {
+        keys.insert(random());
+      }
+      for (const auto& key : keys) {
+        tree.insert(key);
+      }
+    } else {
+      /// one key in ten missing for gaps
+      for (data_type key = 0, i = 0; i < n; key++) {
+        if (kind == "dense" || random() % 10) {
+          tree.insert(key);
+          i++;
+        }
+      }
+    }
+    std::ostringstream raw;
+    std::ostringstream packed;
+    tree.save(raw);
+    tree.save(packed, snapshot::Encoding::PACKED);
+    const auto rawBytes = raw.str();
+    const auto packedBytes = packed.str();
+    std::printf(
+        "%-8s raw %.2f packed %.2f bytes/key, ratio %.1f\n",
+        name,
+        double(rawBytes.size()) / n,
+        double(packedBytes.size()) / n,
+        double(rawBytes.size()) / packedBytes.size()
+    );
+    {
+      /// decoding alone, no tree
+      std::istringstream is(packedBytes);
+      snapshot::Reader reader(is);
+      snapshot::Header header;
+      reader.read(&header, sizeof(header));
+      snapshot::PackedReader<data_type> decoder(reader, header.count);
+      data_type sum = 0;
+      const auto seconds = sal::bench::measure([&] {
+        data_type val = 0;
+        for (std::size_t i = 0; i < n && decoder.get(val); i++) {
+          sum += val;
+        }
+      });
+      sal::bench::sink = sum;
+      std::printf(
+          "%-8s decode %.2f GB/s of keys\n",
+          name,
+          n * sizeof(data_type) / seconds / 1e9
+      );
+      sal::bench::report("  decode", n, seconds);
+    }
+    for (const auto* bytes : {&rawBytes, &packedBytes}) {
+      sal::RBTree<data_type> loaded;
+      std::istringstream is(*bytes);
+      bool ok = false;
+      const auto seconds = sal::bench::measure([&] {
+        ok = loaded.load(is);
+      });
+      const char* label = bytes == &rawBytes ? "  load raw" : "  load packed";
+      sal::bench::report(ok ? label : "  load FAILED", n, seconds);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include <sal/aa_tree.hh>
+#include <sal/rb_tree.hh>
+#include <sal/self_organizing_list.hh>
+#include <sal/splay_tree.hh>
+#include "bench.hh"
+
+/*!
+ * @brief zipf distributed lookups over a fixed key set
+ * usage: bench_splay_tree [keys] [lookups] [skew x100]
+ */
+template <typename Tree>
+void lookups(
+    const char* name,
+    const std::vector<std::uint64_t>& keys,
+    const std::vector<std::uint64_t>& trace
+) {
+  Tree tree;
+  for (const auto& key : keys) {
+    tree.insert(key);
+  }
+  std::size_t found = 0;
+  const auto seconds = sal::bench::measure([&] {
+    for (const auto& key : trace) {
+      found += static_cast<bool>(tree.find(key));
+    }
+  });
+  sal::bench::sink = found;
+  sal::bench::report(name, trace.size(), seconds);
+}
+
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 16);
+  const auto m = sal::bench::arg(argc, argv, 2, 1 << 21);
+  const auto s = sal::bench::arg(argc, argv, 3, 99) / 100.0;
+  const auto keys = sal::bench::shuffled(n, 1);
+  const auto trace = sal::bench::zipf_trace(keys, m, s, 2);
+  std::printf("keys %zu, lookups %zu, zipf s %.2f\n", n, m, s);
+  lookups<sal::SplayTree<data_type>>("SplayTree", keys, trace);
+  lookups<sal::RBTree<data_type>>("RBTree", keys, trace);
+  lookups<sal::AATree<data_type>>("AATree", keys, trace);
+  {
+    /// a list lookup is linear, keep its share of the trace affordable
+    sal::SelfOrganizingList<data_type> list;
+    for (const auto& key : keys) {
+      list.add(key);
+    }
+    const std::vector<data_type> head(
+        trace.begin(),
+        trace.begin() + std::min<std::size_t>(trace.size(), (1 << 26) / n)
+    );
+    std::size_t found = 0;
+    const auto seconds = sal::bench::measure([&] {
+      for (const auto& key : head) {
+        found += static_cast<bool>(list.get(key));
+      }
+    });
+    sal::bench::sink = found;
+    sal::bench::report("SelfOrganizingList", head.size(), seconds);
+  }
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+#include <sal/aa_tree.hh>
+#include <sal/avl_tree.hh>
+#include <sal/bs_tree.hh>
+#include <sal/rb_tree.hh>
+#include "bench.hh"
+
+/*!
+ * @brief depth and insert/lookup/remove throughput per insertion order
+ * usage: bench_tree_depth [keys] [lookups]
+ *
+ * random: shuffled inserts, uniform lookups
+ * sorted: ascending inserts, uniform lookups
+ * zipf:   inserts in order of first appearance in a zipf trace (hot keys
+ *         first), zipf lookups
+ */
+struct Input {
+  const char* name;
+  std::vector<std::uint64_t> inserts;
+  std::vector<std::uint64_t> lookups;
+};
+
+template <typename Tree>
+void run(const char* name, const Input& input) {
+  Tree tree;
+  const auto insert = sal::bench::measure([&] {
+    for (const auto& key : input.inserts) {
+      tree.insert(key);
+    }
+  });
+  const auto depth = sal::bench::depth(std::as_const(tree).root());
+  std::size_t found = 0;
+  const auto lookup = sal::bench::measure([&] {
+    for (const auto& key : input.lookups) {
+      found += static_cast<bool>(tree.find(key));
+    }
+  });
+  sal::bench::sink = found;
+  const auto removals = sal::bench::shuffled(input.inserts.size(), 3);
+  const auto remove = sal::bench::measure([&] {
+    for (const auto& i : removals) {
+      tree.remove(input.inserts[i]);
+    }
+  });
+  const auto n = input.inserts.size();
+  const auto m = input.lookups.size();
+  std::printf(
+      "%-8s %-8s depth avg %6.2f max %5zu | "
+      "insert %8.3f lookup %8.3f remove %8.3f Mops/s\n",
+      input.name, name, depth.avg, depth.max,
+      n / insert / 1e6, m / lookup / 1e6, n / remove / 1e6
+  );
+}
+
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 14);
+  const auto m = sal::bench::arg(argc, argv, 2, 1 << 20);
+  std::vector<Input> inputs;
+  {
+    const auto keys = sal::bench::shuffled(n, 1);
+    const auto uniform = sal::bench::shuffled(n, 2);
+    std::vector<data_type> lookups(m);
+    for (std::size_t i = 0; i < m; i++) {
+      lookups[i] = uniform[i % n];
+    }
+    inputs.push_back({"random", keys, lookups});
+    auto sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    inputs.push_back({"sorted", sorted, lookups});
+    auto trace = sal::bench::zipf_trace(keys, m, 0.99, 4);
+    std::vector<bool> seen(n);
+    std::vector<data_type> inserts;
+    for (const auto& key : trace) {
+      if (!seen[key]) {
+        seen[key] = true;
+        inserts.push_back(key);
+      }
+    }
+    for (const auto& key : keys) {
+      if (!seen[key]) {
+        inserts.push_back(key);
+      }
+    }
+    inputs.push_back({"zipf", inserts, trace});
+  }
+  for (const auto& input : inputs) {
+    run<sal::AVLTree<data_type>>("AVLTree", input);
+    run<sal::RBTree<data_type>>("RBTree", input);
+    run<sal::AATree<data_type>>("AATree", input);
+    run<sal::BSTree<data_type>>("BSTree", input);
+  }
+
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <sal/double_linked_list.hh>
+#include <sal/unrolled_list.hh>
+#include "bench.hh"
+
+/*!
+ * @brief lookups of random keys out of n, every one a partial scan
+ * usage: bench_unrolled_list [n] [lookups]
+ */
+template <typename List>
+void lookups(
+    const char* name,
+    const std::vector<std::uint64_t>& keys,
+    const std::vector<std::uint64_t>& trace
+) {
+  using value_type = typename List::value_type;
+  List list;
+  for (const auto& key : keys) {
+    list.add(static_cast<value_type>(key));
+  }
+  std::size_t found = 0;
+  const auto seconds = sal::bench::measure([&] {
+    for (const auto& key : trace) {
+      found += static_cast<bool>(list.get(static_cast<value_type>(key)));
+    }
+  });
+  sal::bench::sink = found;
+  sal::bench::report(name, trace.size(), seconds);
+  std::printf(
+      "%-32s %.3f ns/element scanned\n",
+      "", seconds * 1e9 / trace.size() / (keys.size() / 2.0)
+  );
+}
+
+int main(int argc, char** argv) {
+  const auto n = sal::bench::arg(argc, argv, 1, 1 << 20);
+  const auto m = sal::bench::arg(argc, argv, 2, 256);
+  const auto keys = sal::bench::shuffled(n, 1);
+  const auto trace = sal::bench::zipf_trace(keys, m, 0, 2);
+  std::printf("elements %zu, lookups %zu\n", n, m);
+  lookups<sal::DoubleLinkedList<std::uint64_t>>(
+      "DoubleLinkedList<uint64_t>", keys, trace
+  );
+  lookups<sal::UnrolledList<std::uint64_t>>(
+      "UnrolledList<uint64_t>", keys, trace
+  );
+  lookups<sal::DoubleLinkedList<std::uint32_t>>(
+      "DoubleLinkedList<uint32_t>", keys, trace
+  );
+  lookups<sal::UnrolledList<std::uint32_t>>(
+      "UnrolledList<uint32_t>", keys, trace
+  );
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <sal/rb_tree.hh>
+#include <sal/tree.hh>
+#include <sal/wal.hh>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench.hh"
+
+/*!
+ * @brief durable inserts into a logged Tree by as many threads as records
+ *        per group, each insert returning once its group is fdatasync'ed
+ * usage: bench_wal [inserts] [path]
+ */
+int main(int argc, char** argv) {
+  using data_type = std::uint64_t;
+  using Tree = sal::Tree<data_type, sal::RBTree>;
+  const auto n = sal::bench::arg(argc, argv, 1, 100'000);
+  const std::string path = argc > 2 ? argv[2] : "/tmp/bench_wal.log";
+  std::printf("inserts %zu\n", n);
+  for (std::size_t group : {1, 4, 16, 64, 256, 1024}) {
+    std::remove(path.c_str());
+    Tree::wal_type wal({std::chrono::microseconds(1000), group, true});
+    Tree tree;
+    if (!tree.attach(wal, path.c_str())) {
+      std::printf("cannot open %s\n", path.c_str());
+      return 1;
+    }
+    const auto seconds = sal::bench::measure([&] {
+      std::vector<std::thread> threads;
+      for (std::size_t t = 0; t < group; t++) {
+        threads.emplace_back([&, t] {
+          for (data_type key = t; key < n; key += group) {
+            tree.insert(key);
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    });
+    const auto groups = wal.groups();
+    tree.detach();
+    char name[64];
+    std::snprintf(
+        name,
+        sizeof(name),
+        "group %zu (avg %.1f)",
+        group,
+        double(n) / groups
+    );
+    sal::bench::report(name, n, seconds);
+  }
+  std::remove(path.c_str());
+
+  return 0;
+}
@@ -3,12 +3,19 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include <sal/node_tree_binary_base.hh>
 
 namespace sal {
 
+class ThreadPool;
+namespace snapshot {
+enum class Encoding : std::uint32_t;
+} /// namespace snapshot
+
 template <typename Data>
 class AATree {
 public:
@@ -24,9 +31,16 @@ public:
     constexpr Node& operator=(Node&&) = default;
     constexpr const std::size_t& level() const;
     constexpr std::size_t& level();
+    /*!
+     * @brief whether the values of the subtree changed since the last
+     *        checkpoint, marked up to the root
+     */
+    constexpr const bool& dirty() const;
+    constexpr bool& dirty();
     constexpr virtual ~Node() = default;
   protected:
     std::size_t level_ = 0;
+    bool dirty_ = true;
   private:
   };
   using node_type = Node<value_type>;
@@ -43,17 +57,76 @@ public:
   constexpr node_type* remove(value_type&&);
   constexpr node_type* find(const value_type&) const;
   constexpr node_type* find(value_type&&) const;
+  /*!
+   * @brief writes the values in order to a std::ostream or a file
+   *        descriptor, Encoding::PACKED compresses integers, the default
+   *        is Encoding::RAW
+   * @note defined in snapshot.hh, as is load()
+   */
+  template <typename Sink>
+  bool save(Sink&&, snapshot::Encoding = snapshot::Encoding{}) const;
+  /*!
+   * @brief replaces the values with those of a snapshot, built balanced in
+   *        O(n) from a std::istream or a file descriptor
+   * @return false, leaving the tree empty, for an unusable snapshot
+   */
+  template <typename Source>
+  bool load(Source&&);
+  /*!
+   * @brief replaces the values with those of values, sorted and deduplicated
+   *        on the threads of pool, then built balanced like by load(), the
+   *        subtrees in parallel
+   * @param sorted values already sorted and distinct, e.g. by a set
+   *        operation, they are not sorted again
+   * @note defined in parallel.hh
+   * @return values in the tree
+   */
+  std::size_t build(std::vector<value_type> values, ThreadPool& pool,
+      bool sorted = false);
+  /*!
+   * @brief replaces the values with a copy of those of other, shaped the
+   *        same, its subtrees copied in parallel on the threads of pool
+   * @note defined in parallel.hh
+   */
+  void assign(const AATree& other, ThreadPool& pool);
+  /*!
+   * @brief writes the changes since the last checkpoint, load() or clean()
+   *        to a std::ostream or a file descriptor, then forgets them
+   * @note defined in checkpoint.hh, as are apply() and clean()
+   */
+  template <typename Sink>
+  bool checkpoint(Sink&&);
+  /*!
+   * @brief applies the next checkpoint of the tree this one is a copy of,
+   *        recovery is load() of the base then apply() of every checkpoint
+   *        taken since, in order
+   * @return false, leaving the tree as it was, for an unusable checkpoint
+   */
+  template <typename Source>
+  bool apply(Source&&);
+  /*!
+   * @brief forgets the changes, the tree as it is becomes the base of the
+   *        next checkpoints, e.g. once saved
+   */
+  constexpr void clean();
   constexpr virtual ~AATree();
 protected:
+  constexpr static void init(node_type&, node_type*, std::size_t, bool);
+  constexpr static void copy(node_type&, const node_type&, node_type*);
+  constexpr static bool touch(node_type*, std::size_t);
   constexpr static node_type* successor(node_type*);
   constexpr static node_type* predecessor(node_type*);
   constexpr static node_type* decrease(node_type*);
   constexpr node_type*& skew(node_type*&);
   constexpr node_type*& split(node_type*&);
   constexpr node_type* insert(const value_type&, node_type*&);
+  constexpr node_type*& rebalance(node_type*&);
+  constexpr node_type* detach(node_type*&, std::size_t);
   constexpr node_type* remove(const value_type&, node_type*&);
   constexpr node_type* find(const value_type&, node_type* const &) const;
   node_type* root_ = nullptr;
+  /// checkpoints since the base
+  std::uint64_t sequence_ = 0;
 private:
 };
 
@@ -77,7 +150,18 @@ template <NodeValue T>
 constexpr std::size_t& AATree<Data>::Node<T>::level() { return this->level_; }
 
 template <typename Data>
-constexpr AATree<Data>::AATree(const AATree& other) {
+template <NodeValue T>
+constexpr const bool& AATree<Data>::Node<T>::dirty() const {
+  return this->dirty_;
+}
+
+template <typename Data>
+template <NodeValue T>
+constexpr bool& AATree<Data>::Node<T>::dirty() { return this->dirty_; }
+
+template <typename Data>
+constexpr AATree<Data>::AATree(const AATree& other)
+  : sequence_(other.sequence_) {
   if (other.root()) {
     this->root() = new Node(*other.root());
   }
@@ -86,28 +170,26 @@ constexpr AATree<Data>::AATree(const AATree& other) {
 template <typename Data>
 constexpr AATree<Data>& AATree<Data>::operator=(const AATree& other) {
   if (this != &other) {
+    delete std::exchange(this->root(), nullptr);
     if (other.root()) {
       this->root() = new Node(*other.root());
     }
+    this->sequence_ = other.sequence_;
   }
   return *this;
 }
 
 template <typename Data>
-constexpr AATree<Data>::AATree(AATree&& other) {
-  if (other.root()) {
-    this->root() = new Node(std::move(*other.root()));
-    other.root() = nullptr;
-  }
-}
+constexpr AATree<Data>::AATree(AATree&& other)
+  : root_(std::exchange(other.root_, nullptr)),
+    sequence_(std::exchange(other.sequence_, 0)) {}
 
 template <typename Data>
 constexpr AATree<Data>& AATree<Data>::operator=(AATree&& other) {
   if (this != &other) {
-    if (other.root()) {
-      this->root() = new Node(std::move(*other.root()));
-      other.root() = nullptr;
-    }
+    delete std::exchange(this->root(), other.root());
+    other.root() = nullptr;
+    this->sequence_ = std::exchange(other.sequence_, 0);
   }
   return *this;
 }
@@ -123,6 +205,8 @@ AATree<Data>::skew(AATree<Data>::node_type*& node) {
     auto* l = node->left();
     node->left() = l->right();
     l->right() = node;
+    node->dirty() = true;
+    l->dirty() = true;
     node = l;
   }
   return node;
@@ -140,6 +224,8 @@ AATree<Data>::split(AATree<Data>::node_type*& node) {
     node->right() = r->left();
     r->left() = node;
     r->level()++;
+    node->dirty() = true;
+    r->dirty() = true;
     node = r;
   }
   return node;
@@ -203,12 +289,79 @@ AATree<Data>::insert(
     node = new Node(val);
   } else if (val <= node->value()) {
     node->left() = this->insert(val, node->left());
+    node->dirty() = true;
   } else {
     node->right() = this->insert(val, node->right());
+    node->dirty() = true;
   }
   return this->split(this->skew(node));
 }
 
+/*!
+ * @brief restores the level invariants of node after a removal below it
+ */
+template <typename Data>
+constexpr typename AATree<Data>::node_type*&
+AATree<Data>::rebalance(AATree<Data>::node_type*& node) {
+  node = this->decrease(node);
+  node = this->skew(node);
+  if (node) {
+    node->right() = this->skew(node->right());
+  }
+  if (node->right()) {
+    node->right()->right() = this->skew(node->right()->right());
+  }
+  node = this->split(node);
+  if (node) {
+    node->right() = this->split(node->right());
+  }
+  /// a skew below an untouched right child leaves it clean
+  this->touch(node, 2);
+  return node;
+}
+
+/*!
+ * @brief marks the nodes of the top levels of the subtree at node with a
+ *        marked child, bottom up
+ * @return whether node is marked
+ */
+template <typename Data>
+constexpr bool AATree<Data>::touch(node_type* node, std::size_t levels) {
+  if (!node) {
+    return false;
+  } else if (levels) {
+    const auto l = touch(node->left(), levels - 1);
+    const auto r = touch(node->right(), levels - 1);
+    node->dirty() = node->dirty() || l || r;
+  }
+  return node->dirty();
+}
+
+/*!
+ * @brief unlinks the last node of the subtree towards childs()[dir], i.e.
+ *        its minimum for 0 and its maximum for 1, rebalancing the ancestors
+ *        on the way back
+ * @note node != nullptr
+ */
+template <typename Data>
+constexpr typename AATree<Data>::node_type*
+AATree<Data>::detach(AATree<Data>::node_type*& node, std::size_t dir) {
+  if (auto*& next = node->childs()[dir]) {
+    auto* detached = this->detach(next, dir);
+    node->dirty() = true;
+    this->rebalance(node);
+    return detached;
+  }
+  auto* detached = node;
+  node = std::exchange(detached->childs()[1 - dir], nullptr);
+  return detached;
+}
+
+/*!
+ * @note an inner node is replaced by its predecessor (successor without a
+ *       left child) node in a single descent, values are never copied and
+ *       the remaining nodes keep their addresses
+ */
 template <typename Data>
 constexpr typename AATree<Data>::node_type*
 AATree<Data>::remove(
@@ -218,39 +371,33 @@ AATree<Data>::remove(
   if (!node) {
     return node;
   } else if (val > node->value()) {
+    auto* right = node->right();
     node->right() = this->remove(val, node->right());
+    node->dirty() = node->dirty() || node->right() != right;
   } else if (val < node->value()) {
+    auto* left = node->left();
     node->left() = this->remove(val, node->left());
+    node->dirty() = node->dirty() || node->left() != left;
   } else {
+    auto* toBeDeleted = node;
     if (!node->left() && !node->right()) {
-      delete node;
-      if (node == this->root()) {
-        this->root() = nullptr;
-      }
+      node = nullptr;
+      delete toBeDeleted;
       return nullptr;
-    } else if (!node->left()) {
-      auto* l = this->successor(node);
-      node->value() = l->value();
-      node->right() = this->remove(l->value(), node->right());
-    } else {
-      auto* l = this->predecessor(node);
-      node->value() = l->value();
-      node->left() = this->remove(l->value(), node->left());
     }
+    auto* replacement = node->left() ?
+        this->detach(node->left(), 1) :
+        this->detach(node->right(), 0);
+    replacement->left() = node->left();
+    replacement->right() = node->right();
+    replacement->level() = node->level();
+    replacement->dirty() = true;
+    toBeDeleted->left() = nullptr;
+    toBeDeleted->right() = nullptr;
+    node = replacement;
+    delete toBeDeleted;
   }
-  node = this->decrease(node);
-  node = this->skew(node);
-  if (node) {
-    node->right() = this->skew(node->right());
-  }
-  if (node->right()) {
-    node->right()->right() = this->skew(node->right()->right());
-  }
-  node = this->split(node);
-  if (node) {
-    node->right() = this->split(node->right());
-  }
-  return node;
+  return this->rebalance(node);
 }
 
 template <typename Data>
@@ -312,6 +459,34 @@ constexpr AATree<Data>::~AATree() {
   }
 }
 
+/*!
+ * @brief shapes a node built from a snapshot or a checkpoint, see
+ *        snapshot::load
+ */
+template <typename Data>
+constexpr void AATree<Data>::init(
+    node_type& n,
+    node_type*,
+    std::size_t level,
+    bool
+) {
+  n.level() = level;
+  n.dirty() = false;
+}
+
+/*!
+ * @brief the rest of a node copied by assign(), see parallel::clone
+ */
+template <typename Data>
+constexpr void AATree<Data>::copy(
+    node_type& n,
+    const node_type& from,
+    node_type*
+) {
+  n.level() = from.level();
+  n.dirty() = from.dirty();
+}
+
 } /// namespace sal
 
 #endif /// SAL_AA_TREE_HH_
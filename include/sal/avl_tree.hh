@@ -0,0 +1,324 @@
+#ifndef SAL_AVL_TREE_HH_
+#define SAL_AVL_TREE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <sal/node_tree_binary_base.hh>
+
+namespace sal {
+
+/*!
+ * @brief height balanced tree, sibling subtrees differ in height by one at
+ *        most, which bounds the depth by ~1.44 log2(n) (vs 2 log2(n) of rb)
+ */
+template <typename Data>
+class AVLTree {
+public:
+  using value_type = Data;
+  using height_type = std::uint8_t;
+  template <NodeValue T>
+  class Node : public NodeTreeBinaryBase<Node, T> {
+  public:
+    constexpr Node() = default;
+    constexpr Node(T);
+    constexpr Node(const Node&) = default;
+    constexpr Node& operator=(const Node&) = default;
+    constexpr Node(Node&&) = default;
+    constexpr Node& operator=(Node&&) = default;
+    constexpr const height_type& height() const;
+    constexpr height_type& height();
+    constexpr virtual ~Node() = default;
+  protected:
+    height_type height_ = 1;
+  private:
+  };
+  using node_type = Node<value_type>;
+  constexpr AVLTree() = default;
+  constexpr AVLTree(const AVLTree&);
+  constexpr AVLTree& operator=(const AVLTree&);
+  constexpr AVLTree(AVLTree&&);
+  constexpr AVLTree& operator=(AVLTree&&);
+  constexpr node_type* const & root() const;
+  constexpr node_type*& root();
+  constexpr node_type* insert(const value_type&);
+  constexpr node_type* insert(value_type&&);
+  constexpr node_type* remove(const value_type&);
+  constexpr node_type* remove(value_type&&);
+  constexpr node_type* find(const value_type&) const;
+  constexpr node_type* find(value_type&&) const;
+  constexpr virtual ~AVLTree();
+protected:
+  constexpr static height_type height(const node_type*);
+  constexpr static node_type*& update(node_type*&);
+  constexpr static node_type*& rotateLeft(node_type*&);
+  constexpr static node_type*& rotateRight(node_type*&);
+  constexpr static node_type*& balance(node_type*&);
+  constexpr static node_type* detachMin(node_type*&);
+  constexpr node_type* insert(const value_type&, node_type*&);
+  constexpr node_type* remove(const value_type&, node_type*&);
+  constexpr node_type* find(const value_type&, node_type* const &) const;
+  node_type* root_ = nullptr;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+template <NodeValue T>
+constexpr AVLTree<Data>::Node<T>::Node(T value)
+  : NodeTreeBinaryBase<Node, T>(value) {}
+
+template <typename Data>
+template <NodeValue T>
+constexpr const typename AVLTree<Data>::height_type&
+AVLTree<Data>::Node<T>::height() const {
+  return this->height_;
+}
+
+template <typename Data>
+template <NodeValue T>
+constexpr typename AVLTree<Data>::height_type&
+AVLTree<Data>::Node<T>::height() {
+  return this->height_;
+}
+
+template <typename Data>
+constexpr AVLTree<Data>::AVLTree(const AVLTree& other) {
+  if (other.root()) {
+    this->root() = new Node(*other.root());
+  }
+}
+
+template <typename Data>
+constexpr AVLTree<Data>& AVLTree<Data>::operator=(const AVLTree& other) {
+  if (this != &other) {
+    delete std::exchange(this->root(), nullptr);
+    if (other.root()) {
+      this->root() = new Node(*other.root());
+    }
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr AVLTree<Data>::AVLTree(AVLTree&& other)
+  : root_(std::exchange(other.root_, nullptr)) {}
+
+template <typename Data>
+constexpr AVLTree<Data>& AVLTree<Data>::operator=(AVLTree&& other) {
+  if (this != &other) {
+    delete std::exchange(this->root(), other.root());
+    other.root() = nullptr;
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type* const &
+AVLTree<Data>::root() const {
+  return this->root_;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*&
+AVLTree<Data>::root() {
+  return this->root_;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::height_type
+AVLTree<Data>::height(const node_type* node) {
+  return node ? node->height() : 0;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*&
+AVLTree<Data>::update(node_type*& node) {
+  node->height() = std::max(height(node->left()), height(node->right())) + 1;
+  return node;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*&
+AVLTree<Data>::rotateLeft(node_type*& node) {
+  auto* r = node->right();
+  node->right() = r->left();
+  r->left() = node;
+  update(node);
+  node = r;
+  return update(node);
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*&
+AVLTree<Data>::rotateRight(node_type*& node) {
+  auto* l = node->left();
+  node->left() = l->right();
+  l->right() = node;
+  update(node);
+  node = l;
+  return update(node);
+}
+
+/*!
+ * @brief restores the height invariant of node, whose subtrees are valid
+ *        avl trees differing in height by two at most
+ */
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*&
+AVLTree<Data>::balance(node_type*& node) {
+  const auto l = height(node->left());
+  const auto r = height(node->right());
+  if (l > r + 1) {
+    if (height(node->left()->left()) < height(node->left()->right())) {
+      rotateLeft(node->left());
+    }
+    return rotateRight(node);
+  } else if (r > l + 1) {
+    if (height(node->right()->right()) < height(node->right()->left())) {
+      rotateRight(node->right());
+    }
+    return rotateLeft(node);
+  }
+  return update(node);
+}
+
+/*!
+ * @brief unlinks the minimum of the subtree, rebalancing on the way back
+ * @note node != nullptr
+ */
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::detachMin(node_type*& node) {
+  if (!node->left()) {
+    auto* min = node;
+    node = node->right();
+    min->right() = nullptr;
+    return min;
+  }
+  auto* min = detachMin(node->left());
+  balance(node);
+  return min;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::insert(
+    const typename AVLTree<Data>::value_type& val,
+    AVLTree<Data>::node_type*& node
+) {
+  if (!node) {
+    return node = new node_type(val);
+  }
+  auto* inserted = val < node->value() ?
+      this->insert(val, node->left()) :
+      this->insert(val, node->right());
+  balance(node);
+  return inserted;
+}
+
+/*!
+ * @note an inner node is replaced by its successor node, values are never
+ *       copied, so the addresses of the remaining nodes stay valid
+ */
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::remove(
+    const typename AVLTree<Data>::value_type& val,
+    AVLTree<Data>::node_type*& node
+) {
+  if (!node) {
+    return node;
+  } else if (val > node->value()) {
+    this->remove(val, node->right());
+  } else if (val < node->value()) {
+    this->remove(val, node->left());
+  } else {
+    auto* toBeDeleted = node;
+    if (!node->left()) {
+      node = node->right();
+    } else if (!node->right()) {
+      node = node->left();
+    } else {
+      auto* successor = detachMin(node->right());
+      successor->left() = node->left();
+      successor->right() = node->right();
+      node = successor;
+    }
+    toBeDeleted->left() = nullptr;
+    toBeDeleted->right() = nullptr;
+    delete toBeDeleted;
+  }
+  if (node) {
+    balance(node);
+  }
+  return node;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::find(
+    const typename AVLTree<Data>::value_type& val,
+    AVLTree<Data>::node_type* const & node
+) const {
+  if (!node) {
+    return node;
+  } else if (val > node->value()) {
+    return this->find(val, node->right());
+  } else if (val < node->value()) {
+    return this->find(val, node->left());
+  }
+  return node;
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::insert(const typename AVLTree<Data>::value_type& val) {
+  return this->insert(val, this->root());
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::insert(typename AVLTree<Data>::value_type&& val) {
+  return this->insert(val, this->root());
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::remove(const typename AVLTree<Data>::value_type& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::remove(typename AVLTree<Data>::value_type&& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::find(const typename AVLTree<Data>::value_type& val) const {
+  return this->find(val, this->root());
+}
+
+template <typename Data>
+constexpr typename AVLTree<Data>::node_type*
+AVLTree<Data>::find(typename AVLTree<Data>::value_type&& val) const {
+  return this->find(val, this->root());
+}
+
+template <typename Data>
+constexpr AVLTree<Data>::~AVLTree() {
+  if (this->root()) {
+    delete this->root();
+  }
+}
+
+} /// namespace sal
+
+#endif /// SAL_AVL_TREE_HH_
@@ -1,10 +1,22 @@
 #ifndef SAL_BS_TREE_HH_
 #define SAL_BS_TREE_HH_
 
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 #include <sal/xx_tree_base.hh>
 
 namespace sal {
 
+class ThreadPool;
+namespace snapshot {
+enum class Encoding : std::uint32_t;
+} /// namespace snapshot
+
 namespace bs {
 
 template <NodeValue T>
@@ -60,6 +72,13 @@ public:
 
 } /// namespace info
 
+/*!
+ * @brief unbalanced bst which repairs itself with day-stout-warren rebuilds:
+ *        once an insertion lands deeper than factor() * log2(size + 1), the
+ *        lowest ancestor whose subtree is too high for its own size is
+ *        rebuilt perfectly balanced, in place and in linear time
+ * @note factor() == 0 disables the automatic rebuilds
+ */
 template <typename Data>
 class BSTree : public XXTreeBase<typename info::BSTree<Data>::node_type> {
 public:
@@ -74,15 +93,51 @@ public:
   constexpr BSTree& operator=(const BSTree&);
   constexpr BSTree(BSTree&&);
   constexpr BSTree& operator=(BSTree&&);
+  constexpr node_type* insert(const value_type&);
+  constexpr node_type* insert(value_type&&);
+  constexpr std::size_t size() const;
+  constexpr const double& factor() const;
+  constexpr double& factor();
+  constexpr void rebalance();
+  /*!
+   * @brief writes the values in order to a std::ostream or a file
+   *        descriptor, Encoding::PACKED compresses integers, the default
+   *        is Encoding::RAW
+   * @note defined in snapshot.hh, as is load()
+   */
+  template <typename Sink>
+  bool save(Sink&&, snapshot::Encoding = snapshot::Encoding{}) const;
+  /*!
+   * @brief replaces the values with those of a snapshot, built balanced in
+   *        O(n) from a std::istream or a file descriptor
+   * @return false, leaving the tree empty, for an unusable snapshot
+   */
+  template <typename Source>
+  bool load(Source&&);
+  /*!
+   * @brief replaces the values with a copy of those of other, shaped the
+   *        same, its subtrees copied in parallel on the threads of pool
+   * @note defined in parallel.hh
+   */
+  void assign(const BSTree& other, ThreadPool& pool);
   constexpr virtual ~BSTree() = default;
 //  constexpr node_type* insert(value_type&& v) { return XXTreeBase<typename info::BSTree<Data>::node_type>::insert(v); };
 protected:
+  constexpr static void adopt(node_type*);
+  constexpr static std::size_t count(const node_type*);
+  constexpr static std::size_t vine(node_type*&);
+  constexpr static void compress(node_type*&, std::size_t);
+  constexpr static void rebalance(node_type*&);
+  constexpr node_type*& slot(node_type*);
+  constexpr std::size_t bound(std::size_t) const;
   constexpr node_type*
       insert(const value_type&, node_type*&, node_type* p = nullptr) override;
   constexpr node_type*
       remove(const value_type&, node_type*&) override;
   constexpr node_type*
       find(const value_type&, node_type* const &) const override;
+  std::size_t size_ = 0;
+  double factor_ = 2.0;
 private:
 };
 
@@ -91,25 +146,229 @@ private:
 namespace sal {
 
 template <typename Data>
-constexpr BSTree<Data>::BSTree(const BSTree& o) : XXTreeBase<node_type>(o) {}
+constexpr BSTree<Data>::BSTree(const BSTree& o)
+  : XXTreeBase<node_type>(o), size_(o.size_), factor_(o.factor_) {
+  if (this->root()) {
+    this->root()->parent() = nullptr;
+    adopt(this->root());
+  }
+}
 
 template <typename Data>
 constexpr BSTree<Data>& BSTree<Data>::operator=(const BSTree& o) {
-  return XXTreeBase<node_type>::operator=(o);
+  if (this != &o) {
+    delete std::exchange(this->root(), nullptr);
+    if (o.root()) {
+      this->root() = new node_type(*o.root());
+      this->root()->parent() = nullptr;
+      adopt(this->root());
+    }
+    this->size_ = o.size_;
+    this->factor_ = o.factor_;
+  }
+  return *this;
 }
 
 template <typename Data>
-constexpr BSTree<Data>::BSTree(BSTree&& o) : XXTreeBase<node_type>(o) {}
+constexpr BSTree<Data>::BSTree(BSTree&& o)
+  : size_(std::exchange(o.size_, 0)), factor_(o.factor_) {
+  this->root() = std::exchange(o.root(), nullptr);
+}
 
 template <typename Data>
 constexpr BSTree<Data>& BSTree<Data>::operator=(BSTree&& o) {
-  return XXTreeBase<node_type>::operator=(std::move(o));
+  if (this != &o) {
+    delete std::exchange(this->root(), o.root());
+    o.root() = nullptr;
+    this->size_ = std::exchange(o.size_, 0);
+    this->factor_ = o.factor_;
+  }
+  return *this;
+}
+
+/*!
+ * @brief points the parent links of the subtree back into it, node copies
+ *        still refer to the parents of the nodes they were copied from
+ */
+template <typename Data>
+constexpr void BSTree<Data>::adopt(node_type* n) {
+  for (auto* child : n->childs()) {
+    if (child) {
+      child->parent() = n;
+      adopt(child);
+    }
+  }
+}
+
+template <typename Data>
+constexpr typename BSTree<Data>::node_type*
+BSTree<Data>::insert(const value_type& v) {
+  auto* inserted = XXTreeBase<node_type>::insert(v);
+  if (!inserted || this->factor_ <= 0) {
+    return inserted;
+  }
+  while (true) {
+    std::size_t depth = 1;
+    for (const auto* it = inserted; it->parent(); it = it->parent()) {
+      depth++;
+    }
+    if (depth <= this->bound(this->size_)) {
+      break;
+    }
+    /// a rebuild may leave the path above it too long, hence the loop
+    auto* it = inserted;
+    std::size_t size = 1;
+    std::size_t height = 1;
+    while (it->parent() && height <= this->bound(size)) {
+      auto* p = it->parent();
+      size += count(it == p->left() ? p->right() : p->left()) + 1;
+      height++;
+      it = p;
+    }
+    const bool whole = !it->parent();
+    rebalance(this->slot(it));
+    if (whole) {
+      break;
+    }
+  }
+  return inserted;
+}
+
+template <typename Data>
+constexpr typename BSTree<Data>::node_type*
+BSTree<Data>::insert(value_type&& v) {
+  return this->insert(std::as_const(v));
+}
+
+template <typename Data>
+constexpr std::size_t BSTree<Data>::size() const {
+  return this->size_;
+}
+
+template <typename Data>
+constexpr const double& BSTree<Data>::factor() const {
+  return this->factor_;
+}
+
+template <typename Data>
+constexpr double& BSTree<Data>::factor() {
+  return this->factor_;
+}
+
+template <typename Data>
+constexpr void BSTree<Data>::rebalance() {
+  rebalance(this->root());
+}
+
+template <typename Data>
+constexpr std::size_t BSTree<Data>::count(const node_type* n) {
+  return n ? count(n->left()) + count(n->right()) + 1 : 0;
+}
+
+/*!
+ * @brief right rotations until the subtree is a vine leaning right
+ * @return number of nodes
+ */
+template <typename Data>
+constexpr std::size_t BSTree<Data>::vine(node_type*& n) {
+  std::size_t size = 0;
+  auto* parent = n->parent();
+  auto** it = &n;
+  while (*it) {
+    auto* top = *it;
+    if (auto* l = top->left()) {
+      top->left() = l->right();
+      if (top->left()) {
+        top->left()->parent() = top;
+      }
+      l->right() = top;
+      top->parent() = l;
+      l->parent() = parent;
+      *it = l;
+    } else {
+      size++;
+      parent = top;
+      it = &top->right();
+    }
+  }
+  return size;
+}
+
+/*!
+ * @brief left rotates every other node along the right spine, count times
+ */
+template <typename Data>
+constexpr void BSTree<Data>::compress(node_type*& n, std::size_t count) {
+  auto* parent = n->parent();
+  auto** it = &n;
+  for (std::size_t i = 0; i < count; i++) {
+    auto* top = *it;
+    auto* r = top->right();
+    top->right() = r->left();
+    if (top->right()) {
+      top->right()->parent() = top;
+    }
+    r->left() = top;
+    top->parent() = r;
+    r->parent() = parent;
+    *it = r;
+    parent = r;
+    it = &r->right();
+  }
+}
+
+/*!
+ * @brief day-stout-warren, O(n) time and O(1) extra memory
+ */
+template <typename Data>
+constexpr void BSTree<Data>::rebalance(node_type*& n) {
+  if (n == nullptr) {
+    return;
+  }
+  auto size = vine(n);
+  std::size_t full = 1;
+  while (full * 2 + 1 <= size) {
+    full = full * 2 + 1;
+  }
+  compress(n, size - full);
+  size = full;
+  while (size > 1) {
+    size /= 2;
+    compress(n, size);
+  }
+}
+
+/*!
+ * @return link referring to n, either in its parent or the root
+ */
+template <typename Data>
+constexpr typename BSTree<Data>::node_type*&
+BSTree<Data>::slot(node_type* n) {
+  if (n->parent() == nullptr) {
+    return this->root();
+  }
+  return n == n->parent()->left() ? n->parent()->left() : n->parent()->right();
+}
+
+/*!
+ * @note never below the height of a perfectly balanced tree of size nodes,
+ *       which a factor() close to or under 1 would ask for
+ */
+template <typename Data>
+constexpr std::size_t BSTree<Data>::bound(std::size_t size) const {
+  return std::max<std::size_t>(
+      static_cast<std::size_t>(
+          this->factor_ * std::log2(static_cast<double>(size + 1))
+      ),
+      std::bit_width(size)
+  );
 }
 
 template <typename Data>
 constexpr typename BSTree<Data>::node_type*
 BSTree<Data>::insert(const value_type& v, node_type*& n, node_type* p) {
   if (n == nullptr) {
+    this->size_++;
     return n = new node_type(v, p);
   } else if (v < n->value()) {
     return this->insert(v, n->left(), n);
@@ -130,32 +389,39 @@ BSTree<Data>::remove(const value_type& v, node_type*& n) {
   } else if (v > n->value()) {
     return this->remove(v, n->right());
   } else {
+    this->size_--;
     if (n->left() == nullptr && n->right() == nullptr) {
       delete n;
       n = nullptr;
     } else if (n->left() == nullptr) {
       auto* toBeDeleted = n;
       n = n->right();
+      n->parent() = toBeDeleted->parent();
       toBeDeleted->right() = nullptr;
       delete toBeDeleted;
     } else if (n->right() == nullptr) {
       auto* toBeDeleted = n;
       n = n->left();
+      n->parent() = toBeDeleted->parent();
       toBeDeleted->left() = nullptr;
       delete toBeDeleted;
     } else {
       auto* predecessor = this->predecessor(n);
       if (predecessor == n->left()) {
         n->left() = nullptr;
-        predecessor->right() = n->right();
-        n->right() = nullptr;
       } else {
         predecessor->parent()->right() = predecessor->left();
+        if (predecessor->left()) {
+          predecessor->left()->parent() = predecessor->parent();
+        }
         predecessor->left() = n->left();
+        predecessor->left()->parent() = predecessor;
         n->left() = nullptr;
-        predecessor->right() = n->right();
-        n->right() = nullptr;
       }
+      predecessor->right() = n->right();
+      predecessor->right()->parent() = predecessor;
+      predecessor->parent() = n->parent();
+      n->right() = nullptr;
       const auto* toBeDeleted = n;
       delete toBeDeleted;
       n = predecessor;
@@ -0,0 +1,367 @@
+#ifndef SAL_BUFFERED_TREE_HH_
+#define SAL_BUFFERED_TREE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace sal {
+
+namespace be {
+
+/*!
+ * @brief insert or remove of a value waiting in the buffer of an inner node
+ */
+template <typename T>
+struct Message {
+  T value{};
+  bool removed = false;
+};
+
+/*!
+ * @brief leaf of sorted values, or inner node of pivots, child i holding the
+ *        values in [keys[i - 1], keys[i]), and of a buffer of messages
+ *        sorted by value, one per value at most
+ */
+template <typename T>
+struct Node {
+  bool leaf() const { return this->childs.empty(); }
+  std::vector<T> keys;
+  std::vector<Message<T>> buffer;
+  std::vector<Node> childs;
+};
+
+} /// namespace be
+
+/*!
+ * @brief write optimized B epsilon tree: an insert or a remove is a message
+ *        put in the buffer of the root, a full buffer flushes its largest
+ *        batch, the messages bound to the same child, one level down, so a
+ *        message moves down a level as part of a batch of about
+ *        BUFFER / FANOUT others instead of descending alone
+ *
+ * find() looks for a message of the value in the buffers on the way down,
+ * the highest is the latest. leaves emptied by removes are dropped, others
+ * are left underfull
+ * @note insert() and remove() are blind writes, returning nothing; Tree
+ *       finds the value first, use the algorithm itself for the write
+ *       throughput
+ */
+template <typename Data>
+class BufferedTree {
+public:
+  using value_type = Data;
+  using message_type = be::Message<value_type>;
+  using node_type = be::Node<value_type>;
+  /// childs of an inner node at most
+  static constexpr std::size_t FANOUT = 16;
+  /// messages of an inner node at most
+  static constexpr std::size_t BUFFER = 512;
+  /// values of a leaf at most
+  static constexpr std::size_t LEAF = 256;
+  constexpr BufferedTree() = default;
+  void insert(const value_type&);
+  void remove(const value_type&);
+  bool find(const value_type&) const;
+  /*!
+   * @brief levels, 1 for a single leaf
+   */
+  std::size_t depth() const;
+  virtual ~BufferedTree() = default;
+protected:
+  void put(const message_type&);
+  static bool oversized(const node_type&);
+  /*!
+   * @brief messages [first, last) into the buffer of node, they are newer
+   *        than those of the buffer
+   */
+  static void add(node_type&, const message_type*, const message_type*);
+  /*!
+   * @brief messages [first, last) applied to the values of a leaf
+   */
+  static void apply(node_type&, const message_type*, const message_type*);
+  /*!
+   * @brief moves the largest batches of an overfull buffer to the childs
+   *        until the buffer is half full
+   */
+  static void flush(node_type&);
+  /*!
+   * @brief splits the oversized child i of node in as many nodes as needed
+   */
+  static void split(node_type&, std::size_t i);
+  node_type root_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+void BufferedTree<Data>::insert(const value_type& val) {
+  this->put({val, false});
+}
+
+template <typename Data>
+void BufferedTree<Data>::remove(const value_type& val) {
+  this->put({val, true});
+}
+
+template <typename Data>
+bool BufferedTree<Data>::find(const value_type& val) const {
+  const auto less = [](const message_type& m, const value_type& v) {
+    return m.value < v;
+  };
+  const auto* it = &this->root_;
+  while (!it->leaf()) {
+    const auto& buffer = it->buffer;
+    const auto m =
+        std::lower_bound(buffer.begin(), buffer.end(), val, less);
+    if (m != buffer.end() && !(val < m->value)) {
+      return !m->removed;
+    }
+    const auto i = std::upper_bound(it->keys.begin(), it->keys.end(), val) -
+        it->keys.begin();
+    it = &it->childs[i];
+  }
+  return std::binary_search(it->keys.begin(), it->keys.end(), val);
+}
+
+template <typename Data>
+std::size_t BufferedTree<Data>::depth() const {
+  std::size_t ret = 1;
+  for (const auto* it = &this->root_; !it->leaf(); it = &it->childs[0]) {
+    ret++;
+  }
+  return ret;
+}
+
+template <typename Data>
+void BufferedTree<Data>::put(const message_type& message) {
+  auto& root = this->root_;
+  if (root.leaf()) {
+    apply(root, &message, &message + 1);
+  } else {
+    add(root, &message, &message + 1);
+    if (root.buffer.size() > BUFFER) {
+      flush(root);
+    }
+    /// the last child left after drops takes the place of the root
+    if (root.childs.size() == 1 && root.buffer.empty()) {
+      auto child = std::move(root.childs[0]);
+      root = std::move(child);
+    }
+  }
+  if (oversized(root)) {
+    /// the tree grows at the root
+    node_type top;
+    top.childs.push_back(std::move(root));
+    split(top, 0);
+    root = std::move(top);
+  }
+}
+
+template <typename Data>
+bool BufferedTree<Data>::oversized(const node_type& node) {
+  return node.leaf() ? node.keys.size() > LEAF : node.childs.size() > FANOUT;
+}
+
+template <typename Data>
+void BufferedTree<Data>::add(
+    node_type& node,
+    const message_type* first,
+    const message_type* last
+) {
+  auto& buffer = node.buffer;
+  if (last - first == 1) {
+    const auto it = std::lower_bound(
+        buffer.begin(),
+        buffer.end(),
+        *first,
+        [](const message_type& a, const message_type& b) {
+          return a.value < b.value;
+        }
+    );
+    if (it != buffer.end() && !(first->value < it->value)) {
+      *it = *first;
+    } else {
+      buffer.insert(it, *first);
+    }
+    return;
+  }
+  std::vector<message_type> merged;
+  merged.reserve(buffer.size() + (last - first));
+  auto it = buffer.begin();
+  for (; first != last; first++) {
+    for (; it != buffer.end() && it->value < first->value; it++) {
+      merged.push_back(*it);
+    }
+    if (it != buffer.end() && !(first->value < it->value)) {
+      it++;
+    }
+    merged.push_back(*first);
+  }
+  merged.insert(merged.end(), it, buffer.end());
+  buffer.swap(merged);
+}
+
+template <typename Data>
+void BufferedTree<Data>::apply(
+    node_type& node,
+    const message_type* first,
+    const message_type* last
+) {
+  auto& keys = node.keys;
+  if (last - first == 1) {
+    const auto it = std::lower_bound(keys.begin(), keys.end(), first->value);
+    const auto present = it != keys.end() && !(first->value < *it);
+    if (first->removed && present) {
+      keys.erase(it);
+    } else if (!first->removed && !present) {
+      keys.insert(it, first->value);
+    }
+    return;
+  }
+  std::vector<value_type> merged;
+  merged.reserve(keys.size() + (last - first));
+  auto it = keys.begin();
+  for (; first != last; first++) {
+    for (; it != keys.end() && *it < first->value; it++) {
+      merged.push_back(std::move(*it));
+    }
+    if (it != keys.end() && !(first->value < *it)) {
+      it++;
+    }
+    if (!first->removed) {
+      merged.push_back(first->value);
+    }
+  }
+  merged.insert(
+      merged.end(),
+      std::make_move_iterator(it),
+      std::make_move_iterator(keys.end())
+  );
+  keys.swap(merged);
+}
+
+template <typename Data>
+void BufferedTree<Data>::flush(node_type& node) {
+  auto& buffer = node.buffer;
+  const auto less = [](const message_type& m, const value_type& v) {
+    return m.value < v;
+  };
+  while (buffer.size() > BUFFER / 2) {
+    /// the largest batch, bounded by the pivots of its child
+    std::size_t child = 0;
+    std::size_t first = 0;
+    std::size_t last = 0;
+    for (std::size_t i = 0, begin = 0; i < node.childs.size(); i++) {
+      const auto end = i < node.keys.size() ?
+          static_cast<std::size_t>(std::lower_bound(
+              buffer.begin() + begin,
+              buffer.end(),
+              node.keys[i],
+              less
+          ) - buffer.begin()) :
+          buffer.size();
+      if (end - begin > last - first) {
+        child = i;
+        first = begin;
+        last = end;
+      }
+      begin = end;
+    }
+    auto& target = node.childs[child];
+    if (target.leaf()) {
+      apply(target, buffer.data() + first, buffer.data() + last);
+    } else {
+      add(target, buffer.data() + first, buffer.data() + last);
+      if (target.buffer.size() > BUFFER) {
+        flush(target);
+      }
+    }
+    buffer.erase(buffer.begin() + first, buffer.begin() + last);
+    if (target.leaf() && target.keys.empty() && node.childs.size() > 1) {
+      /// an empty leaf is dropped, its range goes to a neighbour
+      node.childs.erase(node.childs.begin() + child);
+      node.keys.erase(node.keys.begin() + (child ? child - 1 : 0));
+    } else if (oversized(target)) {
+      split(node, child);
+    }
+  }
+}
+
+template <typename Data>
+void BufferedTree<Data>::split(node_type& node, std::size_t i) {
+  auto& child = node.childs[i];
+  std::vector<node_type> parts;
+  std::vector<value_type> pivots;
+  if (child.leaf()) {
+    const auto n = child.keys.size();
+    const auto count = (n + LEAF - 1) / LEAF;
+    for (std::size_t p = 0; p < count; p++) {
+      const auto begin = child.keys.begin() + n * p / count;
+      const auto end = child.keys.begin() + n * (p + 1) / count;
+      if (p) {
+        pivots.push_back(*begin);
+      }
+      parts.emplace_back();
+      parts.back().keys.assign(
+          std::make_move_iterator(begin),
+          std::make_move_iterator(end)
+      );
+    }
+  } else {
+    /// the pivot between two parts goes up, the buffer is split by it
+    const auto n = child.childs.size();
+    const auto count = (n + FANOUT - 1) / FANOUT;
+    auto message = child.buffer.begin();
+    for (std::size_t p = 0; p < count; p++) {
+      const auto begin = n * p / count;
+      const auto end = n * (p + 1) / count;
+      parts.emplace_back();
+      auto& part = parts.back();
+      part.childs.assign(
+          std::make_move_iterator(child.childs.begin() + begin),
+          std::make_move_iterator(child.childs.begin() + end)
+      );
+      part.keys.assign(
+          std::make_move_iterator(child.keys.begin() + begin),
+          std::make_move_iterator(child.keys.begin() + end - 1)
+      );
+      auto stop = child.buffer.end();
+      if (end < n) {
+        pivots.push_back(child.keys[end - 1]);
+        stop = std::lower_bound(
+            message,
+            child.buffer.end(),
+            pivots.back(),
+            [](const message_type& m, const value_type& v) {
+              return m.value < v;
+            }
+        );
+      }
+      part.buffer.assign(
+          std::make_move_iterator(message),
+          std::make_move_iterator(stop)
+      );
+      message = stop;
+    }
+  }
+  node.keys.insert(
+      node.keys.begin() + i,
+      std::make_move_iterator(pivots.begin()),
+      std::make_move_iterator(pivots.end())
+  );
+  node.childs.erase(node.childs.begin() + i);
+  node.childs.insert(
+      node.childs.begin() + i,
+      std::make_move_iterator(parts.begin()),
+      std::make_move_iterator(parts.end())
+  );
+}
+
+} /// namespace sal
+
+#endif /// SAL_BUFFERED_TREE_HH_
@@ -0,0 +1,399 @@
+#ifndef SAL_CHECKPOINT_HH_
+#define SAL_CHECKPOINT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sal/aa_tree.hh>
+#include <sal/rb_tree.hh>
+#include <sal/snapshot.hh>
+
+namespace sal {
+
+/*!
+ * @brief incremental checkpoints of binary search trees whose nodes mark
+ *        themselves dirty() when the values of their subtree change
+ *
+ * a checkpoint turns the state of a tree at the previous checkpoint into
+ * the current one, it holds the values of the dirty nodes and a KEEP entry
+ * for every clean subtree met on the way down to them:
+ *
+ *   u64 magic | u32 version | u32 value size | u64 sequence |
+ *   entries | u8 END | u64 sum
+ *
+ *   KEEP:   u8 1 | a | b | u64 na | u64 nb
+ *   VALUES: u8 2 | u64 n | n values
+ *
+ * the values of a clean subtree are those it had at the previous
+ * checkpoint, so the values strictly between its minimum a and its maximum
+ * b are taken from there, while equal values on its edges are told by
+ * their counts na and nb (nb = 0 when a = b); a checkpoint costs the
+ * changed values and a few entries per changed path, whatever the size of
+ * the tree
+ */
+namespace checkpoint {
+
+constexpr std::uint64_t MAGIC = 0x3154504b434c4153; /// "SALCKPT1"
+constexpr std::uint32_t VERSION = 1;
+
+struct Header {
+  std::uint64_t magic = MAGIC;
+  std::uint32_t version = VERSION;
+  std::uint32_t valueSize = 0;
+  std::uint64_t sequence = 0;
+};
+
+enum class Entry : std::uint8_t {
+  END = 0,
+  KEEP = 1,
+  VALUES = 2,
+};
+
+/*!
+ * @brief writes the checkpoint of the tree at root, the marks stay
+ * @param sequence number of the checkpoint since the base of the tree
+ */
+template <typename Node>
+bool write(snapshot::Writer&, const Node* root, std::uint64_t sequence);
+
+/*!
+ * @brief clears the marks write() went through
+ */
+template <typename Node>
+void clean(Node* root);
+
+/*!
+ * @brief replaces the tree at root with a balanced one, the state it had
+ *        at the checkpoint read, with init as for snapshot::load
+ * @return false, leaving the tree as it was, for a checkpoint out of
+ *         sequence, truncated or corrupt
+ */
+template <typename Node, typename Init>
+bool apply(
+    snapshot::Reader&,
+    Node*& root,
+    std::uint64_t sequence,
+    Init init
+);
+
+} /// namespace checkpoint
+
+} /// namespace sal
+
+namespace sal {
+
+namespace checkpoint {
+
+/*!
+ * @brief walks the dirty nodes in order, the values of a run of them are
+ *        held by address until a clean subtree or the end closes the run
+ */
+template <typename Node>
+class Encoder {
+public:
+  using value_type =
+      std::remove_cvref_t<decltype(std::declval<const Node&>().value())>;
+  explicit Encoder(snapshot::Writer& w) : writer_(w) {}
+  bool visit(const Node*);
+  bool flush();
+protected:
+  bool keep(const Node*);
+  std::uint64_t edge(const Node*, std::size_t dir);
+  snapshot::Writer& writer_;
+  std::vector<const value_type*> run_;
+  std::vector<const Node*> stack_;
+private:
+};
+
+template <typename Node>
+bool Encoder<Node>::visit(const Node* node) {
+  if (!node) {
+    return true;
+  } else if (!node->dirty()) {
+    return this->flush() && this->keep(node);
+  }
+  if (!this->visit(node->left())) {
+    return false;
+  }
+  this->run_.push_back(&node->value());
+  return this->visit(node->right());
+}
+
+template <typename Node>
+bool Encoder<Node>::flush() {
+  if (this->run_.empty()) {
+    return this->writer_.good();
+  }
+  const std::uint64_t size = this->run_.size();
+  bool ok = this->writer_.put(Entry::VALUES) && this->writer_.put(size);
+  for (const auto* val : this->run_) {
+    ok = ok && this->writer_.put(*val);
+  }
+  this->run_.clear();
+  return ok;
+}
+
+/*!
+ * @brief values equal to the first one met from the edge towards dir, i.e.
+ *        the minimum for 0 and the maximum for 1
+ */
+template <typename Node>
+std::uint64_t Encoder<Node>::edge(const Node* node, std::size_t dir) {
+  std::uint64_t ret = 0;
+  const value_type* first = nullptr;
+  this->stack_.clear();
+  for (const auto* it = node; it || !this->stack_.empty();) {
+    if (it) {
+      this->stack_.push_back(it);
+      it = it->childs()[dir];
+      continue;
+    }
+    it = this->stack_.back();
+    this->stack_.pop_back();
+    if (first && (*first < it->value() || it->value() < *first)) {
+      break;
+    }
+    first = &it->value();
+    ret++;
+    it = it->childs()[1 - dir];
+  }
+  return ret;
+}
+
+template <typename Node>
+bool Encoder<Node>::keep(const Node* node) {
+  const auto* min = node;
+  while (min->left()) {
+    min = min->left();
+  }
+  const auto* max = node;
+  while (max->right()) {
+    max = max->right();
+  }
+  const std::uint64_t na = this->edge(node, 0);
+  const std::uint64_t nb =
+      min->value() < max->value() ? this->edge(node, 1) : 0;
+  return this->writer_.put(Entry::KEEP) &&
+      this->writer_.put(min->value()) &&
+      this->writer_.put(max->value()) &&
+      this->writer_.put(na) &&
+      this->writer_.put(nb);
+}
+
+template <typename Node>
+bool write(
+    snapshot::Writer& w,
+    const Node* root,
+    std::uint64_t sequence
+) {
+  using value_type = typename Encoder<Node>::value_type;
+  Header header;
+  header.valueSize = snapshot::Codec<value_type>::RAW_SIZE;
+  header.sequence = sequence;
+  Encoder<Node> encoder(w);
+  return w.write(&header, sizeof(header)) &&
+      encoder.visit(root) &&
+      encoder.flush() &&
+      w.put(Entry::END) &&
+      w.finish();
+}
+
+template <typename Node>
+void clean(Node* node) {
+  if (!node || !node->dirty()) {
+    return;
+  }
+  node->dirty() = false;
+  clean(node->left());
+  clean(node->right());
+}
+
+/*!
+ * @brief values of a tree in order, one at a time
+ */
+template <typename Node>
+class Cursor {
+public:
+  explicit Cursor(const Node* root) : it_(root) { this->next(); }
+  const Node* get() const { return this->top_; }
+  void next() {
+    while (this->it_) {
+      this->stack_.push_back(this->it_);
+      this->it_ = this->it_->left();
+    }
+    if (this->stack_.empty()) {
+      this->top_ = nullptr;
+      return;
+    }
+    this->top_ = this->stack_.back();
+    this->stack_.pop_back();
+    this->it_ = this->top_->right();
+  }
+protected:
+  const Node* it_ = nullptr;
+  const Node* top_ = nullptr;
+  std::vector<const Node*> stack_;
+private:
+};
+
+/*!
+ * @note the values are merged aside and the tree is only replaced once the
+ *       checksum holds; the counts of equal values cannot exceed the size
+ *       of the previous state, so a corrupt one fails before exhausting
+ *       the memory
+ */
+template <typename Node, typename Init>
+bool apply(
+    snapshot::Reader& r,
+    Node*& root,
+    std::uint64_t sequence,
+    Init init
+) {
+  using value_type =
+      std::remove_cvref_t<decltype(std::declval<Node&>().value())>;
+  Header header;
+  if (!r.read(&header, sizeof(header)) ||
+      header.magic != MAGIC ||
+      header.version != VERSION ||
+      header.valueSize != snapshot::Codec<value_type>::RAW_SIZE ||
+      header.sequence != sequence) {
+    return false;
+  }
+  const auto limit = snapshot::count(root);
+  std::vector<value_type> values;
+  Cursor<Node> cursor(root);
+  for (auto entry = Entry::END;;) {
+    if (!r.get(entry)) {
+      return false;
+    } else if (entry == Entry::END) {
+      break;
+    } else if (entry == Entry::VALUES) {
+      std::uint64_t n = 0;
+      if (!r.get(n)) {
+        return false;
+      }
+      for (value_type val; n; n--) {
+        if (!r.get(val)) {
+          return false;
+        }
+        values.push_back(std::move(val));
+      }
+    } else if (entry == Entry::KEEP) {
+      value_type a;
+      value_type b;
+      std::uint64_t na = 0;
+      std::uint64_t nb = 0;
+      if (!r.get(a) || !r.get(b) || !r.get(na) || !r.get(nb) ||
+          na > limit || nb > limit) {
+        return false;
+      }
+      values.insert(values.end(), na, a);
+      while (cursor.get() && !(a < cursor.get()->value())) {
+        cursor.next();
+      }
+      for (; cursor.get() && cursor.get()->value() < b; cursor.next()) {
+        values.push_back(cursor.get()->value());
+      }
+      values.insert(values.end(), nb, b);
+    } else {
+      return false;
+    }
+  }
+  if (!r.finish()) {
+    return false;
+  }
+  std::size_t i = 0;
+  auto source = [&](value_type& val) {
+    val = std::move(values[i++]);
+    return true;
+  };
+  snapshot::Builder<Node, Init, decltype(source)> builder(source, init);
+  auto* built = builder.build(values.size(), nullptr, 0);
+  if (!builder.good()) {
+    delete built;
+    return false;
+  }
+  delete std::exchange(root, built);
+  return true;
+}
+
+} /// namespace checkpoint
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+template <typename Sink>
+bool RBTree<Data>::checkpoint(Sink&& sink) {
+  snapshot::Writer writer(sink);
+  if (!checkpoint::write(writer, this->root(), this->sequence_ + 1)) {
+    return false;
+  }
+  checkpoint::clean(this->root());
+  this->sequence_++;
+  return true;
+}
+
+template <typename Data>
+template <typename Source>
+bool RBTree<Data>::apply(Source&& source) {
+  snapshot::Reader reader(source);
+  if (!checkpoint::apply(
+      reader,
+      this->root(),
+      this->sequence_ + 1,
+      &RBTree::init
+  )) {
+    return false;
+  }
+  this->sequence_++;
+  return true;
+}
+
+template <typename Data>
+constexpr void RBTree<Data>::clean() {
+  checkpoint::clean(this->root());
+  this->sequence_ = 0;
+}
+
+template <typename Data>
+template <typename Sink>
+bool AATree<Data>::checkpoint(Sink&& sink) {
+  snapshot::Writer writer(sink);
+  if (!checkpoint::write(writer, this->root(), this->sequence_ + 1)) {
+    return false;
+  }
+  checkpoint::clean(this->root());
+  this->sequence_++;
+  return true;
+}
+
+template <typename Data>
+template <typename Source>
+bool AATree<Data>::apply(Source&& source) {
+  snapshot::Reader reader(source);
+  if (!checkpoint::apply(
+      reader,
+      this->root(),
+      this->sequence_ + 1,
+      &AATree::init
+  )) {
+    return false;
+  }
+  this->sequence_++;
+  return true;
+}
+
+template <typename Data>
+constexpr void AATree<Data>::clean() {
+  checkpoint::clean(this->root());
+  this->sequence_ = 0;
+}
+
+} /// namespace sal
+
+#endif /// SAL_CHECKPOINT_HH_
@@ -0,0 +1,908 @@
+#ifndef SAL_DISK_B_TREE_HH_
+#define SAL_DISK_B_TREE_HH_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sal {
+
+/*!
+ * @brief parts of DiskBTree
+ */
+namespace disk {
+
+/*!
+ * @brief fixed number of page frames over a file, read and written back
+ *        with pread and pwrite; a page is pinned while in use and the clock
+ *        hand evicts unpinned pages not referenced since its last pass
+ */
+class BufferPool {
+public:
+  static constexpr std::uint64_t NONE = ~std::uint64_t{0};
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t reads = 0;
+    std::uint64_t writes = 0;
+  };
+  BufferPool(std::size_t pageSize, std::size_t frames);
+  BufferPool(const BufferPool&) = delete;
+  BufferPool& operator=(const BufferPool&) = delete;
+  /*!
+   * @brief opens or creates the file at path
+   * @return false for a file that is no whole number of pages
+   */
+  bool open(const char* path);
+  /*!
+   * @brief writes the dirty pages back and closes the file
+   */
+  bool close();
+  /*!
+   * @brief pages of the file when it was opened
+   */
+  std::uint64_t filePages() const;
+  std::size_t pageSize() const;
+  std::size_t frames() const;
+  /*!
+   * @param fresh a page new to the file, zeroed instead of read
+   * @return the page, nullptr on an I/O error or with every frame pinned
+   */
+  char* pin(std::uint64_t page, bool fresh = false);
+  void unpin(const char* data);
+  /*!
+   * @brief marks a pinned page to be written back
+   */
+  void touch(const char* data);
+  /*!
+   * @brief writes the dirty pages back and syncs the file
+   */
+  bool flush();
+  const Stats& stats() const;
+  void reset();
+  virtual ~BufferPool();
+protected:
+  struct Frame {
+    std::uint64_t page = NONE;
+    std::uint32_t pins = 0;
+    bool referenced = false;
+    bool dirty = false;
+  };
+  char* data(std::size_t frame);
+  std::size_t frame(const char* data) const;
+  bool writeBack(std::size_t frame);
+  std::size_t pageSize_;
+  /// words so that pages are aligned for any value of at most 8 bytes
+  std::vector<std::uint64_t> memory_;
+  std::vector<Frame> frames_;
+  std::unordered_map<std::uint64_t, std::size_t> table_;
+  std::size_t hand_ = 0;
+  std::uint64_t filePages_ = 0;
+  int fd_ = -1;
+  Stats stats_;
+private:
+};
+
+} /// namespace disk
+
+/*!
+ * @brief B+tree of trivially copyable values in the pages of a file, cached
+ *        by a disk::BufferPool of a fixed number of frames, for sets larger
+ *        than memory
+ *
+ * the values are in the leaves, linked in order, the inner nodes hold
+ * separators and child pages; inserts split full nodes and removes refill
+ * minimal ones on the way down, so that no more than 4 pages are pinned at
+ * once and a pass never goes back up. page 0 holds the Meta, written by
+ * flush() and close()
+ * @note single threaded; a crash between two flush() may leave the file
+ *       inconsistent, log the changes with Wal where it matters. an I/O
+ *       error fails the tree, see good()
+ */
+template <typename Data, std::size_t PageSize = 4096>
+class DiskBTree {
+public:
+  using value_type = Data;
+  static_assert(std::is_trivially_copyable_v<value_type>);
+  static_assert(alignof(value_type) <= 8 && PageSize % 8 == 0);
+  static constexpr std::uint64_t MAGIC = 0x31305254424c4153; /// "SALBTR01"
+  static constexpr std::uint32_t VERSION = 1;
+  struct Meta {
+    std::uint64_t magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t valueSize = sizeof(value_type);
+    std::uint64_t pageSize = PageSize;
+    std::uint64_t root = 1;
+    std::uint64_t count = 0;
+    /// pages in use or free, the meta page included
+    std::uint64_t pages = 2;
+    /// first free page, each holding the next one, 0 for none
+    std::uint64_t free = 0;
+  };
+  /*!
+   * @param frames pages cached, at least 8
+   */
+  explicit DiskBTree(std::size_t frames = 1024);
+  DiskBTree(const DiskBTree&) = delete;
+  DiskBTree& operator=(const DiskBTree&) = delete;
+  /*!
+   * @brief opens the tree in the file at path, a new one when it is empty
+   * @return false, leaving the tree closed, for a file of no such tree
+   */
+  bool open(const char* path);
+  bool close();
+  /*!
+   * @return false when closed or after an I/O error
+   */
+  bool good() const;
+  std::size_t size() const;
+  std::uint64_t pages() const;
+  bool insert(const value_type&);
+  bool remove(const value_type&);
+  bool find(const value_type&) const;
+  /*!
+   * @return the least value not less than val, none when there is none
+   */
+  std::optional<value_type> lowerBound(const value_type& val) const;
+  /*!
+   * @brief calls f with every value in order
+   */
+  template <typename F>
+  void inorder(F&& f) const;
+  /*!
+   * @brief writes the meta and the dirty pages back
+   */
+  bool flush();
+  disk::BufferPool& pool() const;
+  virtual ~DiskBTree();
+protected:
+  struct Node {
+    std::uint32_t leaf;
+    std::uint32_t count;
+    /// next leaf, 0 for none
+    std::uint64_t next;
+  };
+  static constexpr std::size_t LEAF_MAX =
+      (PageSize - sizeof(Node)) / sizeof(value_type);
+  static constexpr std::size_t INNER_MAX =
+      (PageSize - sizeof(Node) - 8) / (sizeof(value_type) + 8);
+  static constexpr std::size_t LEAF_MIN = (LEAF_MAX - 1) / 2;
+  static constexpr std::size_t INNER_MIN = (INNER_MAX - 1) / 2;
+  static_assert(INNER_MAX >= 3, "a page holds too few values");
+  static Node& node(char* page);
+  /// childs first, so that they are aligned whatever the value size
+  static std::uint64_t* childs(char* page);
+  static value_type* keys(char* page);
+  static value_type* values(char* page);
+  static bool full(char* page);
+  static bool minimal(char* page);
+  /*!
+   * @brief index of the child of an inner page that val belongs to
+   */
+  static std::size_t route(char* page, const value_type& val);
+  /*!
+   * @brief index of the first value of a leaf not less than val
+   */
+  static std::size_t lower(char* page, const value_type& val);
+  char* pin(std::uint64_t page, bool fresh = false) const;
+  /*!
+   * @brief leaf val belongs to, pinned
+   */
+  char* leaf(const value_type& val) const;
+  std::uint64_t allocate();
+  bool release(std::uint64_t page);
+  bool split(char* parent, std::size_t i, char* child);
+  /*!
+   * @brief refills the minimal child i of parent from a sibling, or merges
+   *        it with one
+   * @return the page to go on with, child or its left sibling, pinned
+   */
+  char* refill(char* parent, std::size_t i, char* child);
+  void merge(char* parent, std::size_t i, char* left, char* right);
+  mutable disk::BufferPool pool_;
+  Meta meta_;
+  mutable bool good_ = false;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+namespace disk {
+
+inline BufferPool::BufferPool(std::size_t pageSize, std::size_t frames)
+  : pageSize_(pageSize),
+    memory_(pageSize / 8 * frames),
+    frames_(frames) {
+  this->table_.reserve(frames);
+}
+
+inline bool BufferPool::open(const char* path) {
+  this->close();
+  const auto fd = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st{};
+  if (::fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) % this->pageSize_) {
+    ::close(fd);
+    return false;
+  }
+  this->fd_ = fd;
+  this->filePages_ = static_cast<std::size_t>(st.st_size) / this->pageSize_;
+  return true;
+}
+
+inline bool BufferPool::close() {
+  if (this->fd_ < 0) {
+    return true;
+  }
+  const auto ok = this->flush();
+  ::close(this->fd_);
+  this->fd_ = -1;
+  this->table_.clear();
+  std::fill(this->frames_.begin(), this->frames_.end(), Frame{});
+  this->hand_ = 0;
+  return ok;
+}
+
+inline std::uint64_t BufferPool::filePages() const {
+  return this->filePages_;
+}
+
+inline std::size_t BufferPool::pageSize() const {
+  return this->pageSize_;
+}
+
+inline std::size_t BufferPool::frames() const {
+  return this->frames_.size();
+}
+
+inline char* BufferPool::data(std::size_t frame) {
+  return reinterpret_cast<char*>(this->memory_.data()) +
+      frame * this->pageSize_;
+}
+
+inline std::size_t BufferPool::frame(const char* data) const {
+  const auto* memory = reinterpret_cast<const char*>(this->memory_.data());
+  return static_cast<std::size_t>(data - memory) / this->pageSize_;
+}
+
+inline bool BufferPool::writeBack(std::size_t frame) {
+  auto& f = this->frames_[frame];
+  const auto* data = this->data(frame);
+  const auto offset = static_cast<off_t>(f.page * this->pageSize_);
+  for (std::size_t done = 0; done < this->pageSize_;) {
+    const auto written = ::pwrite(
+        this->fd_,
+        data + done,
+        this->pageSize_ - done,
+        offset + static_cast<off_t>(done)
+    );
+    if (written < 0 && errno != EINTR) {
+      return false;
+    } else if (written > 0) {
+      done += static_cast<std::size_t>(written);
+    }
+  }
+  f.dirty = false;
+  this->stats_.writes++;
+  return true;
+}
+
+inline char* BufferPool::pin(std::uint64_t page, bool fresh) {
+  if (this->fd_ < 0) {
+    return nullptr;
+  }
+  if (const auto it = this->table_.find(page); it != this->table_.end()) {
+    auto& f = this->frames_[it->second];
+    f.pins++;
+    f.referenced = true;
+    this->stats_.hits++;
+    return this->data(it->second);
+  }
+  /// two sweeps clear every reference bit, a third finds nothing new
+  const auto n = this->frames_.size();
+  auto victim = n;
+  for (std::size_t i = 0; i < 2 * n && victim == n; i++) {
+    auto& f = this->frames_[this->hand_];
+    if (!f.pins && !f.referenced) {
+      victim = this->hand_;
+    }
+    f.referenced = false;
+    this->hand_ = (this->hand_ + 1) % n;
+  }
+  if (victim == n) {
+    return nullptr;
+  }
+  auto& f = this->frames_[victim];
+  if (f.page != NONE) {
+    if (f.dirty && !this->writeBack(victim)) {
+      return nullptr;
+    }
+    this->table_.erase(f.page);
+    f.page = NONE;
+  }
+  auto* data = this->data(victim);
+  if (fresh) {
+    std::memset(data, 0, this->pageSize_);
+  } else {
+    const auto offset = static_cast<off_t>(page * this->pageSize_);
+    for (std::size_t done = 0; done < this->pageSize_;) {
+      const auto read = ::pread(
+          this->fd_,
+          data + done,
+          this->pageSize_ - done,
+          offset + static_cast<off_t>(done)
+      );
+      if (read == 0 || (read < 0 && errno != EINTR)) {
+        return nullptr;
+      } else if (read > 0) {
+        done += static_cast<std::size_t>(read);
+      }
+    }
+    this->stats_.reads++;
+  }
+  f.page = page;
+  f.pins = 1;
+  f.referenced = true;
+  f.dirty = fresh;
+  this->table_.emplace(page, victim);
+  return data;
+}
+
+inline void BufferPool::unpin(const char* data) {
+  this->frames_[this->frame(data)].pins--;
+}
+
+inline void BufferPool::touch(const char* data) {
+  this->frames_[this->frame(data)].dirty = true;
+}
+
+inline bool BufferPool::flush() {
+  if (this->fd_ < 0) {
+    return false;
+  }
+  for (std::size_t i = 0; i < this->frames_.size(); i++) {
+    if (this->frames_[i].dirty && !this->writeBack(i)) {
+      return false;
+    }
+  }
+  return ::fdatasync(this->fd_) == 0;
+}
+
+inline const BufferPool::Stats& BufferPool::stats() const {
+  return this->stats_;
+}
+
+inline void BufferPool::reset() {
+  this->stats_ = Stats{};
+}
+
+inline BufferPool::~BufferPool() {
+  this->close();
+}
+
+} /// namespace disk
+
+template <typename Data, std::size_t PageSize>
+DiskBTree<Data, PageSize>::DiskBTree(std::size_t frames)
+  : pool_(PageSize, std::max<std::size_t>(frames, 8)) {}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::open(const char* path) {
+  this->close();
+  if (!this->pool_.open(path)) {
+    return false;
+  }
+  this->good_ = true;
+  if (!this->pool_.filePages()) {
+    /// a new tree, a single empty leaf
+    this->meta_ = Meta{};
+    auto* root = this->pin(this->meta_.root, true);
+    if (!root) {
+      this->close();
+      return false;
+    }
+    node(root).leaf = 1;
+    this->pool_.touch(root);
+    this->pool_.unpin(root);
+    if (!this->flush()) {
+      this->close();
+      return false;
+    }
+    return true;
+  }
+  const auto* page = this->pin(0);
+  if (page) {
+    std::memcpy(&this->meta_, page, sizeof(Meta));
+    this->pool_.unpin(page);
+  }
+  const Meta expected;
+  if (!page ||
+      this->meta_.magic != expected.magic ||
+      this->meta_.version != expected.version ||
+      this->meta_.valueSize != expected.valueSize ||
+      this->meta_.pageSize != expected.pageSize ||
+      this->meta_.pages > this->pool_.filePages() ||
+      !this->meta_.root ||
+      this->meta_.root >= this->meta_.pages ||
+      this->meta_.free >= this->meta_.pages) {
+    this->good_ = false;
+    this->pool_.close();
+    return false;
+  }
+  return true;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::close() {
+  const auto ok = !this->good_ || this->flush();
+  this->good_ = false;
+  return this->pool_.close() && ok;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::good() const {
+  return this->good_;
+}
+
+template <typename Data, std::size_t PageSize>
+std::size_t DiskBTree<Data, PageSize>::size() const {
+  return this->meta_.count;
+}
+
+template <typename Data, std::size_t PageSize>
+std::uint64_t DiskBTree<Data, PageSize>::pages() const {
+  return this->meta_.pages;
+}
+
+template <typename Data, std::size_t PageSize>
+disk::BufferPool& DiskBTree<Data, PageSize>::pool() const {
+  return this->pool_;
+}
+
+template <typename Data, std::size_t PageSize>
+typename DiskBTree<Data, PageSize>::Node&
+DiskBTree<Data, PageSize>::node(char* page) {
+  return *reinterpret_cast<Node*>(page);
+}
+
+template <typename Data, std::size_t PageSize>
+std::uint64_t* DiskBTree<Data, PageSize>::childs(char* page) {
+  return reinterpret_cast<std::uint64_t*>(page + sizeof(Node));
+}
+
+template <typename Data, std::size_t PageSize>
+typename DiskBTree<Data, PageSize>::value_type*
+DiskBTree<Data, PageSize>::keys(char* page) {
+  return reinterpret_cast<value_type*>(
+      page + sizeof(Node) + (INNER_MAX + 1) * 8
+  );
+}
+
+template <typename Data, std::size_t PageSize>
+typename DiskBTree<Data, PageSize>::value_type*
+DiskBTree<Data, PageSize>::values(char* page) {
+  return reinterpret_cast<value_type*>(page + sizeof(Node));
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::full(char* page) {
+  return node(page).count == (node(page).leaf ? LEAF_MAX : INNER_MAX);
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::minimal(char* page) {
+  return node(page).count <= (node(page).leaf ? LEAF_MIN : INNER_MIN);
+}
+
+template <typename Data, std::size_t PageSize>
+std::size_t DiskBTree<Data, PageSize>::route(
+    char* page,
+    const value_type& val
+) {
+  const auto* begin = keys(page);
+  return std::upper_bound(begin, begin + node(page).count, val) - begin;
+}
+
+template <typename Data, std::size_t PageSize>
+std::size_t DiskBTree<Data, PageSize>::lower(
+    char* page,
+    const value_type& val
+) {
+  const auto* begin = values(page);
+  return std::lower_bound(begin, begin + node(page).count, val) - begin;
+}
+
+template <typename Data, std::size_t PageSize>
+char* DiskBTree<Data, PageSize>::pin(std::uint64_t page, bool fresh) const {
+  auto* ret = this->good_ ? this->pool_.pin(page, fresh) : nullptr;
+  this->good_ = ret != nullptr;
+  return ret;
+}
+
+template <typename Data, std::size_t PageSize>
+char* DiskBTree<Data, PageSize>::leaf(const value_type& val) const {
+  auto* it = this->pin(this->meta_.root);
+  while (it && !node(it).leaf) {
+    auto* child = this->pin(childs(it)[route(it, val)]);
+    this->pool_.unpin(it);
+    it = child;
+  }
+  return it;
+}
+
+template <typename Data, std::size_t PageSize>
+std::uint64_t DiskBTree<Data, PageSize>::allocate() {
+  if (!this->meta_.free) {
+    return this->meta_.pages++;
+  }
+  const auto page = this->meta_.free;
+  auto* data = this->pin(page);
+  if (!data) {
+    return 0;
+  }
+  std::memcpy(&this->meta_.free, data, sizeof(this->meta_.free));
+  this->pool_.unpin(data);
+  return page;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::release(std::uint64_t page) {
+  auto* data = this->pin(page);
+  if (!data) {
+    return false;
+  }
+  std::memcpy(data, &this->meta_.free, sizeof(this->meta_.free));
+  this->meta_.free = page;
+  this->pool_.touch(data);
+  this->pool_.unpin(data);
+  return true;
+}
+
+/*!
+ * @brief moves the upper half of the full child i of parent, which is not
+ *        full, to a new right sibling
+ */
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::split(
+    char* parent,
+    std::size_t i,
+    char* child
+) {
+  const auto page = this->allocate();
+  auto* sibling = page ? this->pin(page, true) : nullptr;
+  if (!sibling) {
+    return false;
+  }
+  auto& c = node(child);
+  auto& s = node(sibling);
+  value_type separator;
+  if (c.leaf) {
+    const auto half = c.count / 2;
+    s = {1, c.count - half, c.next};
+    std::copy(values(child) + half, values(child) + c.count, values(sibling));
+    c.count = half;
+    c.next = page;
+    separator = values(sibling)[0];
+  } else {
+    /// the middle key goes up
+    const auto half = c.count / 2;
+    s = {0, c.count - half - 1, 0};
+    std::copy(keys(child) + half + 1, keys(child) + c.count, keys(sibling));
+    std::copy(
+        childs(child) + half + 1,
+        childs(child) + c.count + 1,
+        childs(sibling)
+    );
+    separator = keys(child)[half];
+    c.count = half;
+  }
+  auto& p = node(parent);
+  std::copy_backward(keys(parent) + i, keys(parent) + p.count,
+      keys(parent) + p.count + 1);
+  std::copy_backward(childs(parent) + i + 1, childs(parent) + p.count + 1,
+      childs(parent) + p.count + 2);
+  keys(parent)[i] = separator;
+  childs(parent)[i + 1] = page;
+  p.count++;
+  this->pool_.touch(parent);
+  this->pool_.touch(child);
+  this->pool_.touch(sibling);
+  this->pool_.unpin(sibling);
+  return true;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::insert(const value_type& val) {
+  auto* it = this->pin(this->meta_.root);
+  if (it && full(it)) {
+    /// the tree grows at the root
+    const auto page = this->allocate();
+    auto* top = page ? this->pin(page, true) : nullptr;
+    if (!top) {
+      return false;
+    }
+    node(top) = {0, 0, 0};
+    childs(top)[0] = this->meta_.root;
+    if (!this->split(top, 0, it)) {
+      return false;
+    }
+    this->pool_.unpin(it);
+    this->meta_.root = page;
+    it = top;
+  }
+  while (it && !node(it).leaf) {
+    auto i = route(it, val);
+    auto* child = this->pin(childs(it)[i]);
+    if (child && full(child)) {
+      if (!this->split(it, i, child)) {
+        return false;
+      }
+      if (!(val < keys(it)[i])) {
+        this->pool_.unpin(child);
+        child = this->pin(childs(it)[i + 1]);
+      }
+    }
+    this->pool_.unpin(it);
+    it = child;
+  }
+  if (!it) {
+    return false;
+  }
+  auto& n = node(it);
+  const auto i = lower(it, val);
+  const auto absent = i == n.count || val < values(it)[i];
+  if (absent) {
+    std::copy_backward(values(it) + i, values(it) + n.count,
+        values(it) + n.count + 1);
+    values(it)[i] = val;
+    n.count++;
+    this->meta_.count++;
+    this->pool_.touch(it);
+  }
+  this->pool_.unpin(it);
+  return absent;
+}
+
+/*!
+ * @brief appends right, the child i + 1 of parent, to left, the child i,
+ *        and frees it
+ */
+template <typename Data, std::size_t PageSize>
+void DiskBTree<Data, PageSize>::merge(
+    char* parent,
+    std::size_t i,
+    char* left,
+    char* right
+) {
+  auto& l = node(left);
+  auto& r = node(right);
+  if (l.leaf) {
+    std::copy(values(right), values(right) + r.count, values(left) + l.count);
+    l.count += r.count;
+    l.next = r.next;
+  } else {
+    keys(left)[l.count] = keys(parent)[i];
+    std::copy(keys(right), keys(right) + r.count, keys(left) + l.count + 1);
+    std::copy(childs(right), childs(right) + r.count + 1,
+        childs(left) + l.count + 1);
+    l.count += r.count + 1;
+  }
+  auto& p = node(parent);
+  const auto page = childs(parent)[i + 1];
+  std::copy(keys(parent) + i + 1, keys(parent) + p.count, keys(parent) + i);
+  std::copy(childs(parent) + i + 2, childs(parent) + p.count + 1,
+      childs(parent) + i + 1);
+  p.count--;
+  this->pool_.touch(parent);
+  this->pool_.touch(left);
+  this->pool_.unpin(right);
+  this->release(page);
+}
+
+template <typename Data, std::size_t PageSize>
+char* DiskBTree<Data, PageSize>::refill(
+    char* parent,
+    std::size_t i,
+    char* child
+) {
+  auto& p = node(parent);
+  auto& c = node(child);
+  auto* left = i > 0 ? this->pin(childs(parent)[i - 1]) : nullptr;
+  if (left && !minimal(left)) {
+    auto& l = node(left);
+    if (c.leaf) {
+      std::copy_backward(values(child), values(child) + c.count,
+          values(child) + c.count + 1);
+      values(child)[0] = values(left)[l.count - 1];
+      keys(parent)[i - 1] = values(child)[0];
+    } else {
+      std::copy_backward(keys(child), keys(child) + c.count,
+          keys(child) + c.count + 1);
+      std::copy_backward(childs(child), childs(child) + c.count + 1,
+          childs(child) + c.count + 2);
+      keys(child)[0] = keys(parent)[i - 1];
+      childs(child)[0] = childs(left)[l.count];
+      keys(parent)[i - 1] = keys(left)[l.count - 1];
+    }
+    l.count--;
+    c.count++;
+    this->pool_.touch(parent);
+    this->pool_.touch(child);
+    this->pool_.touch(left);
+    this->pool_.unpin(left);
+    return child;
+  }
+  auto* right = this->good_ && i < p.count ?
+      this->pin(childs(parent)[i + 1]) :
+      nullptr;
+  if (!this->good_) {
+    return nullptr;
+  }
+  if (right && !minimal(right)) {
+    auto& r = node(right);
+    if (c.leaf) {
+      values(child)[c.count] = values(right)[0];
+      std::copy(values(right) + 1, values(right) + r.count, values(right));
+      keys(parent)[i] = values(right)[0];
+    } else {
+      keys(child)[c.count] = keys(parent)[i];
+      childs(child)[c.count + 1] = childs(right)[0];
+      keys(parent)[i] = keys(right)[0];
+      std::copy(keys(right) + 1, keys(right) + r.count, keys(right));
+      std::copy(childs(right) + 1, childs(right) + r.count + 1,
+          childs(right));
+    }
+    r.count--;
+    c.count++;
+    this->pool_.touch(parent);
+    this->pool_.touch(child);
+    this->pool_.touch(right);
+    this->pool_.unpin(right);
+    if (left) {
+      this->pool_.unpin(left);
+    }
+    return child;
+  }
+  /// both siblings minimal, a merge fits in one page
+  if (left) {
+    if (right) {
+      this->pool_.unpin(right);
+    }
+    this->merge(parent, i - 1, left, child);
+    return left;
+  }
+  this->merge(parent, i, child, right);
+  return child;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::remove(const value_type& val) {
+  auto* it = this->pin(this->meta_.root);
+  while (it && !node(it).leaf) {
+    const auto i = route(it, val);
+    auto* child = this->pin(childs(it)[i]);
+    if (child && minimal(child)) {
+      child = this->refill(it, i, child);
+    }
+    if (!child) {
+      return false;
+    }
+    /// the tree shrinks at the root
+    if (!node(it).count) {
+      const auto page = this->meta_.root;
+      this->meta_.root = childs(it)[0];
+      this->pool_.unpin(it);
+      this->release(page);
+    } else {
+      this->pool_.unpin(it);
+    }
+    it = child;
+  }
+  if (!it) {
+    return false;
+  }
+  auto& n = node(it);
+  const auto i = lower(it, val);
+  const auto present = i < n.count && !(val < values(it)[i]);
+  if (present) {
+    std::copy(values(it) + i + 1, values(it) + n.count, values(it) + i);
+    n.count--;
+    this->meta_.count--;
+    this->pool_.touch(it);
+  }
+  this->pool_.unpin(it);
+  return present && this->good_;
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::find(const value_type& val) const {
+  auto* it = this->leaf(val);
+  if (!it) {
+    return false;
+  }
+  const auto i = lower(it, val);
+  const auto ret = i < node(it).count && !(val < values(it)[i]);
+  this->pool_.unpin(it);
+  return ret;
+}
+
+template <typename Data, std::size_t PageSize>
+std::optional<typename DiskBTree<Data, PageSize>::value_type>
+DiskBTree<Data, PageSize>::lowerBound(const value_type& val) const {
+  auto* it = this->leaf(val);
+  if (!it) {
+    return std::nullopt;
+  }
+  auto i = lower(it, val);
+  /// past the leaf, the first value of the next one
+  while (i == node(it).count && node(it).next) {
+    auto* next = this->pin(node(it).next);
+    this->pool_.unpin(it);
+    if (!(it = next)) {
+      return std::nullopt;
+    }
+    i = 0;
+  }
+  std::optional<value_type> ret;
+  if (i < node(it).count) {
+    ret = values(it)[i];
+  }
+  this->pool_.unpin(it);
+  return ret;
+}
+
+template <typename Data, std::size_t PageSize>
+template <typename F>
+void DiskBTree<Data, PageSize>::inorder(F&& f) const {
+  auto* it = this->pin(this->meta_.root);
+  while (it && !node(it).leaf) {
+    auto* child = this->pin(childs(it)[0]);
+    this->pool_.unpin(it);
+    it = child;
+  }
+  while (it) {
+    for (std::size_t i = 0; i < node(it).count; i++) {
+      f(values(it)[i]);
+    }
+    const auto next = node(it).next;
+    this->pool_.unpin(it);
+    it = next ? this->pin(next) : nullptr;
+  }
+}
+
+template <typename Data, std::size_t PageSize>
+bool DiskBTree<Data, PageSize>::flush() {
+  /// page 0 holds nothing but the meta, no need to read it
+  auto* page = this->pin(0, true);
+  if (!page) {
+    return false;
+  }
+  std::memcpy(page, &this->meta_, sizeof(Meta));
+  this->pool_.touch(page);
+  this->pool_.unpin(page);
+  this->good_ = this->pool_.flush();
+  return this->good_;
+}
+
+template <typename Data, std::size_t PageSize>
+DiskBTree<Data, PageSize>::~DiskBTree() {
+  this->close();
+}
+
+} /// namespace sal
+
+#endif /// SAL_DISK_B_TREE_HH_
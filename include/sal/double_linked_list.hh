@@ -2,6 +2,9 @@
 #define SAL_DOUBLE_LINKED_LIST_HH_
 
 #include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <utility>
 
 #include <sal/util.hh>
@@ -28,6 +31,14 @@ public:
   private:
   };
   constexpr static Node<value_type>* nil = nullptr;
+  /// spare nodes kept by default for the next additions
+  constexpr static std::size_t FREE_CAPACITY = 64;
+  constexpr DoubleLinkedList() = default;
+  /*!
+   * @param freeCapacity most removed nodes kept for reuse, 0 frees every
+   *        removed node right away
+   */
+  constexpr explicit DoubleLinkedList(std::size_t freeCapacity);
   constexpr Node<value_type>* const & root() const;
   constexpr Node<value_type>*& root();
   constexpr Node<value_type>* const & last() const;
@@ -40,13 +51,111 @@ public:
   virtual constexpr Node<value_type>* const & get(value_type&&) const;
   virtual constexpr bool del(const value_type&);
   virtual constexpr bool del(value_type&&);
+  /*!
+   * @brief moves every node of other in front of pos, to the end for nil,
+   *        in O(1) between plain lists
+   */
+  constexpr void splice(Node<value_type>* pos, DoubleLinkedList& other);
+  /*!
+   * @brief moves the nodes from first to last inclusive of other in front of
+   *        pos, to the end for nil, in O(1) between plain lists
+   * @note pos must not lie within the moved range; lists keeping state per
+   *       node walk the range to update it, see detach() and attach()
+   */
+  constexpr void splice(
+      Node<value_type>* pos,
+      DoubleLinkedList& other,
+      Node<value_type>* first,
+      Node<value_type>* last
+  );
+  /*!
+   * @brief appends every value of range, the nodes are chained aside and
+   *        linked in at once
+   * @return the first appended node, nil for an empty range
+   */
+  template <typename Range>
+  constexpr Node<value_type>* append(const Range&);
+  /*!
+   * @note the list must not be empty
+   */
+  constexpr value_type popFront();
+  constexpr value_type popBack();
+  /*!
+   * @brief stable bottom-up merge sort relinking the nodes in place, values
+   *        are neither copied nor moved and nothing is allocated
+   */
+  template <typename Compare = std::less<>>
+  constexpr void sort(Compare = {});
+  /*!
+   * @brief spare nodes held for reuse
+   */
+  constexpr std::size_t freeSize() const;
+  constexpr std::size_t freeCapacity() const;
+  /*!
+   * @brief sets the most spare nodes held, the ones above it are freed
+   */
+  constexpr void freeCapacity(std::size_t);
+  /*!
+   * @brief frees every spare node
+   */
+  constexpr void shrinkToFit();
   virtual ~DoubleLinkedList();
 protected:
   virtual constexpr Node<value_type>*& insert(const value_type&);
   virtual constexpr Node<value_type>* const & find(const value_type&) const;
   virtual constexpr bool remove(const value_type&);
+  /*!
+   * @brief takes a node out of the list, lists keeping state per node drop
+   *        it here
+   */
+  virtual constexpr Node<value_type>* extract(Node<value_type>*);
+  /*!
+   * @brief takes the nodes from first to last out of the list for splice(),
+   *        lists keeping state per node drop it for the range here
+   */
+  virtual constexpr void detach(
+      Node<value_type>* first,
+      Node<value_type>* last
+  );
+  /*!
+   * @brief called once splice() or append() linked in the nodes from first
+   *        to last, lists keeping state per node take them up here
+   * @return the first node of the range still in the list, lists may drop
+   *         some, nil when none is left
+   */
+  virtual constexpr Node<value_type>* attach(
+      Node<value_type>* first,
+      Node<value_type>* last
+  );
+  constexpr void link(
+      Node<value_type>* pos,
+      Node<value_type>* first,
+      Node<value_type>* last
+  );
+  constexpr void unlink(Node<value_type>* first, Node<value_type>* last);
+  constexpr void unlink(Node<value_type>*);
+  template <typename Compare>
+  constexpr static Node<value_type>* merge(
+      Node<value_type>*,
+      Node<value_type>*,
+      Compare&
+  );
+  /*!
+   * @brief unlinked node holding val, a spare one when there is any
+   */
+  constexpr Node<value_type>* acquire(const value_type&);
+  /*!
+   * @brief takes back an unlinked node, it is kept as a spare while there is
+   *        room, freed otherwise
+   * @note a spare keeps its stale value until it is reused
+   */
+  constexpr void release(Node<value_type>*);
   Node<value_type>* root_ = nullptr;
   Node<value_type>* last_ = nullptr;
+  /// spare nodes chained through next()
+  Node<value_type>* free_ = nullptr;
+  std::size_t freeSize_ = 0;
+  std::size_t freeCapacity_ = FREE_CAPACITY;
 private:
 };
 
@@ -97,6 +206,10 @@ DoubleLinkedList<Data>::Node<T>::next() {
   return this->next_;
 }
 
+template <typename Data>
+constexpr DoubleLinkedList<Data>::DoubleLinkedList(std::size_t freeCapacity)
+  : freeCapacity_(freeCapacity) {}
+
 template <typename Data>
 constexpr typename DoubleLinkedList<Data>::template
 Node<typename DoubleLinkedList<Data>::value_type>* const &
@@ -200,10 +313,10 @@ DoubleLinkedList<Data>::insert(
     const DoubleLinkedList<Data>::value_type& val
 ) {
   if (!this->last()) {
-    this->root() = new Node<value_type>(std::move(val));
+    this->root() = this->acquire(val);
     return this->last() = this->root();
   } else {
-    Node<value_type>* inserted = new Node<value_type>(std::move(val));
+    Node<value_type>* inserted = this->acquire(val);
     this->last()->next() = inserted;
     inserted->prev() = this->last();
     return this->last() = inserted;
@@ -243,24 +356,266 @@ constexpr bool DoubleLinkedList<Data>::remove(
   if (!it) {
     return false;
   }
-  if (it->prev()) {
-    it->prev()->next() = it->next();
+  this->release(this->extract(it));
+  return true;
+}
+
+template <typename Data>
+constexpr typename DoubleLinkedList<Data>::template
+Node<typename DoubleLinkedList<Data>::value_type>*
+DoubleLinkedList<Data>::extract(Node<value_type>* node) {
+  this->unlink(node);
+  return node;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::detach(
+    Node<value_type>* first,
+    Node<value_type>* last
+) {
+  this->unlink(first, last);
+}
+
+template <typename Data>
+constexpr typename DoubleLinkedList<Data>::template
+Node<typename DoubleLinkedList<Data>::value_type>*
+DoubleLinkedList<Data>::attach(Node<value_type>* first, Node<value_type>*) {
+  return first;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::link(
+    Node<value_type>* pos,
+    Node<value_type>* first,
+    Node<value_type>* last
+) {
+  first->prev() = pos ? pos->prev() : this->last();
+  last->next() = pos;
+  if (first->prev()) {
+    first->prev()->next() = first;
   } else {
-    this->root() = it->next();
+    this->root() = first;
   }
-  if (it->next()) {
-    it->next()->prev() = it->prev();
+  if (pos) {
+    pos->prev() = last;
   } else {
-    this->last() = it->prev();
+    this->last() = last;
   }
-  return true;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::unlink(
+    Node<value_type>* first,
+    Node<value_type>* last
+) {
+  if (first->prev()) {
+    first->prev()->next() = last->next();
+  } else {
+    this->root() = last->next();
+  }
+  if (last->next()) {
+    last->next()->prev() = first->prev();
+  } else {
+    this->last() = first->prev();
+  }
+  first->prev() = nullptr;
+  last->next() = nullptr;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::unlink(Node<value_type>* node) {
+  this->unlink(node, node);
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::splice(
+    Node<value_type>* pos,
+    DoubleLinkedList& other
+) {
+  if (other.root()) {
+    this->splice(pos, other, other.root(), other.last());
+  }
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::splice(
+    Node<value_type>* pos,
+    DoubleLinkedList& other,
+    Node<value_type>* first,
+    Node<value_type>* last
+) {
+  other.detach(first, last);
+  this->link(pos, first, last);
+  this->attach(first, last);
+}
+
+template <typename Data>
+template <typename Range>
+constexpr typename DoubleLinkedList<Data>::template
+Node<typename DoubleLinkedList<Data>::value_type>*
+DoubleLinkedList<Data>::append(const Range& range) {
+  Node<value_type>* first = nullptr;
+  Node<value_type>* last = nullptr;
+  for (const auto& val : range) {
+    auto* node = this->acquire(val);
+    if (last) {
+      last->next() = node;
+      node->prev() = last;
+    } else {
+      first = node;
+    }
+    last = node;
+  }
+  if (first) {
+    this->link(nullptr, first, last);
+    return this->attach(first, last);
+  }
+  return first;
+}
+
+template <typename Data>
+constexpr typename DoubleLinkedList<Data>::value_type
+DoubleLinkedList<Data>::popFront() {
+  auto* node = this->extract(this->root());
+  auto val = std::move(node->value());
+  this->release(node);
+  return val;
+}
+
+template <typename Data>
+constexpr typename DoubleLinkedList<Data>::value_type
+DoubleLinkedList<Data>::popBack() {
+  auto* node = this->extract(this->last());
+  auto val = std::move(node->value());
+  this->release(node);
+  return val;
+}
+
+/*!
+ * @brief merges the nil terminated chains a and b, following next() only,
+ *        ties go to a
+ */
+template <typename Data>
+template <typename Compare>
+constexpr typename DoubleLinkedList<Data>::template
+Node<typename DoubleLinkedList<Data>::value_type>*
+DoubleLinkedList<Data>::merge(
+    Node<value_type>* a,
+    Node<value_type>* b,
+    Compare& comp
+) {
+  Node<value_type>* head = nullptr;
+  auto** tail = &head;
+  while (a && b) {
+    auto*& taken = comp(b->value(), a->value()) ? b : a;
+    *tail = taken;
+    tail = &taken->next();
+    taken = taken->next();
+  }
+  *tail = a ? a : b;
+  return head;
+}
+
+/*!
+ * @note bins[i] holds a sorted run of 2^i nodes preceding every run in the
+ *       lower bins, so merging a bin in front of the carry keeps it stable;
+ *       the prev links are restored in one last pass
+ */
+template <typename Data>
+template <typename Compare>
+constexpr void DoubleLinkedList<Data>::sort(Compare comp) {
+  Node<value_type>* bins[64]{};
+  std::size_t used = 0;
+  auto* it = this->root();
+  while (it) {
+    auto* carry = std::exchange(it, it->next());
+    carry->next() = nullptr;
+    std::size_t i = 0;
+    for (; bins[i]; i++) {
+      carry = merge(std::exchange(bins[i], nullptr), carry, comp);
+    }
+    bins[i] = carry;
+    used = std::max(used, i + 1);
+  }
+  Node<value_type>* sorted = nullptr;
+  for (std::size_t i = 0; i < used; i++) {
+    if (bins[i]) {
+      sorted = merge(bins[i], sorted, comp);
+    }
+  }
+  Node<value_type>* prev = nullptr;
+  for (it = sorted; it; it = it->next()) {
+    it->prev() = prev;
+    prev = it;
+  }
+  this->root() = sorted;
+  this->last() = prev;
+}
+
+template <typename Data>
+constexpr typename DoubleLinkedList<Data>::template
+Node<typename DoubleLinkedList<Data>::value_type>*
+DoubleLinkedList<Data>::acquire(const value_type& val) {
+  if (!this->free_) {
+    return new Node<value_type>(val);
+  }
+  auto* node = std::exchange(this->free_, this->free_->next());
+  this->freeSize_--;
+  node->next() = nullptr;
+  node->value() = val;
+  return node;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::release(Node<value_type>* node) {
+  node->prev() = nullptr;
+  if (this->freeSize_ < this->freeCapacity_) {
+    node->next() = std::exchange(this->free_, node);
+    this->freeSize_++;
+  } else {
+    node->next() = nullptr;
+    delete node;
+  }
+}
+
+template <typename Data>
+constexpr std::size_t DoubleLinkedList<Data>::freeSize() const {
+  return this->freeSize_;
+}
+
+template <typename Data>
+constexpr std::size_t DoubleLinkedList<Data>::freeCapacity() const {
+  return this->freeCapacity_;
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::freeCapacity(std::size_t capacity) {
+  this->freeCapacity_ = capacity;
+  while (this->freeSize_ > capacity) {
+    auto* node = std::exchange(this->free_, this->free_->next());
+    node->next() = nullptr;
+    delete node;
+    this->freeSize_--;
+  }
+}
+
+template <typename Data>
+constexpr void DoubleLinkedList<Data>::shrinkToFit() {
+  const auto capacity = this->freeCapacity_;
+  this->freeCapacity(0);
+  this->freeCapacity_ = capacity;
 }
 
 template <typename Data>
 DoubleLinkedList<Data>::~DoubleLinkedList() {
-  if (this->root()) {
-    delete this->root();
+  /// unlinked one by one, ~Node would recurse down the whole chain
+  while (this->root()) {
+    auto* toBeDeleted = this->root();
+    this->root() = toBeDeleted->next();
+    toBeDeleted->next() = nullptr;
+    delete toBeDeleted;
   }
+  this->shrinkToFit();
 }
 
 } /// namespace sal
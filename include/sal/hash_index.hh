@@ -0,0 +1,194 @@
+#ifndef SAL_HASH_INDEX_HH_
+#define SAL_HASH_INDEX_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace sal {
+
+/*!
+ * @brief key of a node, its value
+ */
+struct NodeValueOf {
+  template <typename Node>
+  constexpr const auto& operator()(const Node& node) const {
+    return node.value();
+  }
+};
+
+/*!
+ * @brief open addressing index from keys to nodes owned elsewhere, linear
+ *        probing over a power of two table of node pointers, at most half
+ *        full, erasing shifts the following probe run back instead of
+ *        leaving tombstones
+ */
+template <
+    typename Entry,
+    typename Key,
+    typename KeyOf = NodeValueOf,
+    typename Hash = std::hash<Key>
+>
+class HashIndex {
+public:
+  using key_type = Key;
+  using entry_type = Entry;
+  constexpr static entry_type* nil = nullptr;
+  HashIndex() = default;
+  HashIndex(const HashIndex&) = default;
+  HashIndex& operator=(const HashIndex&) = default;
+  HashIndex(HashIndex&&) = default;
+  HashIndex& operator=(HashIndex&&) = default;
+  std::size_t size() const;
+  /*!
+   * @brief grows the table so that n entries fit without a rehash
+   */
+  void reserve(std::size_t n);
+  void clear();
+  /*!
+   * @return slot of the entry with key, nil when absent
+   * @note the slot is valid until the next insert() or erase()
+   */
+  entry_type* const & find(const key_type&) const;
+  /*!
+   * @return false when an entry with the same key is indexed already
+   */
+  bool insert(entry_type*);
+  /*!
+   * @return the unindexed entry, nullptr when absent
+   */
+  entry_type* erase(const key_type&);
+  virtual ~HashIndex() = default;
+protected:
+  std::size_t slot(const key_type&) const;
+  void rehash(std::size_t);
+  std::vector<entry_type*> slots_;
+  std::size_t size_ = 0;
+  std::size_t shift_ = 64;
+  [[no_unique_address]] KeyOf keyOf_;
+  [[no_unique_address]] Hash hash_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+std::size_t HashIndex<Entry, Key, KeyOf, Hash>::size() const {
+  return this->size_;
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+void HashIndex<Entry, Key, KeyOf, Hash>::reserve(std::size_t n) {
+  std::size_t capacity = 8;
+  while (capacity < 2 * n) {
+    capacity *= 2;
+  }
+  if (capacity > this->slots_.size()) {
+    this->rehash(capacity);
+  }
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+void HashIndex<Entry, Key, KeyOf, Hash>::clear() {
+  std::fill(this->slots_.begin(), this->slots_.end(), nullptr);
+  this->size_ = 0;
+}
+
+/*!
+ * @brief fibonacci hashing on top of Hash, std::hash of integers is the
+ *        identity, whose low bits alone would cluster sequential keys
+ */
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+std::size_t
+HashIndex<Entry, Key, KeyOf, Hash>::slot(const key_type& key) const {
+  const auto h = static_cast<std::uint64_t>(this->hash_(key));
+  return static_cast<std::size_t>(
+      (h * 0x9e3779b97f4a7c15ull) >> this->shift_
+  );
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+void HashIndex<Entry, Key, KeyOf, Hash>::rehash(std::size_t capacity) {
+  auto old = std::exchange(this->slots_, std::vector<entry_type*>(capacity));
+  this->shift_ = 64;
+  while (capacity > 1) {
+    capacity >>= 1;
+    this->shift_--;
+  }
+  const auto mask = this->slots_.size() - 1;
+  for (auto* entry : old) {
+    if (entry) {
+      auto i = this->slot(this->keyOf_(*entry));
+      while (this->slots_[i]) {
+        i = (i + 1) & mask;
+      }
+      this->slots_[i] = entry;
+    }
+  }
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+typename HashIndex<Entry, Key, KeyOf, Hash>::entry_type* const &
+HashIndex<Entry, Key, KeyOf, Hash>::find(const key_type& key) const {
+  if (!this->size_) {
+    return HashIndex::nil;
+  }
+  const auto mask = this->slots_.size() - 1;
+  for (auto i = this->slot(key); this->slots_[i]; i = (i + 1) & mask) {
+    if (this->keyOf_(*this->slots_[i]) == key) {
+      return this->slots_[i];
+    }
+  }
+  return HashIndex::nil;
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+bool HashIndex<Entry, Key, KeyOf, Hash>::insert(entry_type* entry) {
+  if (2 * (this->size_ + 1) > this->slots_.size()) {
+    this->reserve(this->size_ + 1);
+  }
+  const auto& key = this->keyOf_(*entry);
+  const auto mask = this->slots_.size() - 1;
+  auto i = this->slot(key);
+  for (; this->slots_[i]; i = (i + 1) & mask) {
+    if (this->keyOf_(*this->slots_[i]) == key) {
+      return false;
+    }
+  }
+  this->slots_[i] = entry;
+  this->size_++;
+  return true;
+}
+
+template <typename Entry, typename Key, typename KeyOf, typename Hash>
+typename HashIndex<Entry, Key, KeyOf, Hash>::entry_type*
+HashIndex<Entry, Key, KeyOf, Hash>::erase(const key_type& key) {
+  auto* const & found = this->find(key);
+  if (!found) {
+    return nullptr;
+  }
+  auto* erased = found;
+  const auto mask = this->slots_.size() - 1;
+  auto hole = static_cast<std::size_t>(&found - this->slots_.data());
+  /// every entry after the hole in the same run may move back into it unless
+  /// its home slot lies cyclically within (hole, i]
+  for (auto i = (hole + 1) & mask; this->slots_[i]; i = (i + 1) & mask) {
+    const auto home = this->slot(this->keyOf_(*this->slots_[i]));
+    if (((i - home) & mask) >= ((i - hole) & mask)) {
+      this->slots_[hole] = this->slots_[i];
+      hole = i;
+    }
+  }
+  this->slots_[hole] = nullptr;
+  this->size_--;
+  return erased;
+}
+
+} /// namespace sal
+
+#endif /// SAL_HASH_INDEX_HH_
@@ -0,0 +1,158 @@
+#ifndef SAL_INDEXED_LINKED_LIST_HH_
+#define SAL_INDEXED_LINKED_LIST_HH_
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <sal/double_linked_list.hh>
+#include <sal/hash_index.hh>
+
+namespace sal {
+
+/*!
+ * @brief double linked list with a hash index from values to nodes, add(),
+ *        get() and del() take O(1) on average while iteration keeps the
+ *        insertion order
+ * @note values are unique, adding a present value returns its node and
+ *       nodes spliced in with a present value are dropped
+ */
+template <typename Data, typename Hash = std::hash<Data>>
+class IndexedLinkedList : public DoubleLinkedList<Data> {
+public:
+  using value_type = Data;
+  using node_type = typename DoubleLinkedList<Data>::template Node<Data>;
+  constexpr std::size_t size() const;
+  /*!
+   * @brief sizes the index for n values, sparing the rehashes on the way
+   */
+  void reserve(std::size_t n);
+  /*!
+   * @brief adds every value of range, skipping the present ones
+   * @return the first added node, nil when none was
+   */
+  template <typename Range>
+  constexpr node_type* append(const Range&);
+  virtual ~IndexedLinkedList() = default;
+protected:
+  constexpr node_type*& insert(const value_type&) override;
+  constexpr node_type* const & find(const value_type&) const override;
+  constexpr bool remove(const value_type&) override;
+  constexpr node_type* extract(node_type*) override;
+  constexpr void detach(node_type*, node_type*) override;
+  constexpr node_type* attach(node_type*, node_type*) override;
+  HashIndex<node_type, value_type, NodeValueOf, Hash> index_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data, typename Hash>
+constexpr std::size_t IndexedLinkedList<Data, Hash>::size() const {
+  return this->index_.size();
+}
+
+template <typename Data, typename Hash>
+void IndexedLinkedList<Data, Hash>::reserve(std::size_t n) {
+  this->index_.reserve(n);
+}
+
+template <typename Data, typename Hash>
+constexpr typename IndexedLinkedList<Data, Hash>::node_type*&
+IndexedLinkedList<Data, Hash>::insert(
+    const IndexedLinkedList<Data, Hash>::value_type& val
+) {
+  if (auto* const & present = this->index_.find(val)) {
+    return const_cast<node_type*&>(present);
+  }
+  auto*& inserted = DoubleLinkedList<Data>::insert(val);
+  this->index_.insert(inserted);
+  return inserted;
+}
+
+template <typename Data, typename Hash>
+constexpr typename IndexedLinkedList<Data, Hash>::node_type* const &
+IndexedLinkedList<Data, Hash>::find(
+    const IndexedLinkedList<Data, Hash>::value_type& val
+) const {
+  return this->index_.find(val);
+}
+
+template <typename Data, typename Hash>
+template <typename Range>
+constexpr typename IndexedLinkedList<Data, Hash>::node_type*
+IndexedLinkedList<Data, Hash>::append(const Range& range) {
+  node_type* first = nullptr;
+  for (const auto& val : range) {
+    if (this->index_.find(val)) {
+      continue;
+    }
+    auto* added = this->insert(val);
+    if (!first) {
+      first = added;
+    }
+  }
+  return first;
+}
+
+template <typename Data, typename Hash>
+constexpr bool IndexedLinkedList<Data, Hash>::remove(
+    const IndexedLinkedList<Data, Hash>::value_type& val
+) {
+  auto* it = this->index_.find(val);
+  if (!it) {
+    return false;
+  }
+  this->release(this->extract(it));
+  return true;
+}
+
+template <typename Data, typename Hash>
+constexpr typename IndexedLinkedList<Data, Hash>::node_type*
+IndexedLinkedList<Data, Hash>::extract(node_type* node) {
+  this->index_.erase(node->value());
+  return DoubleLinkedList<Data>::extract(node);
+}
+
+/*!
+ * @note O(k) for k nodes, the index forgets each of them
+ */
+template <typename Data, typename Hash>
+constexpr void IndexedLinkedList<Data, Hash>::detach(
+    node_type* first,
+    node_type* last
+) {
+  for (auto* it = first; ; it = it->next()) {
+    this->index_.erase(it->value());
+    if (it == last) {
+      break;
+    }
+  }
+  DoubleLinkedList<Data>::detach(first, last);
+}
+
+template <typename Data, typename Hash>
+constexpr typename IndexedLinkedList<Data, Hash>::node_type*
+IndexedLinkedList<Data, Hash>::attach(node_type* first, node_type* last) {
+  node_type* ret = nullptr;
+  const auto* stop = last->next();
+  for (auto* it = first; it != stop; ) {
+    auto* node = std::exchange(it, it->next());
+    if (this->index_.find(node->value())) {
+      this->unlink(node);
+      this->release(node);
+      continue;
+    }
+    this->index_.insert(node);
+    if (!ret) {
+      ret = node;
+    }
+  }
+  return ret;
+}
+
+} /// namespace sal
+
+#endif /// SAL_INDEXED_LINKED_LIST_HH_
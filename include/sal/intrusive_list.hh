@@ -0,0 +1,198 @@
+#ifndef SAL_INTRUSIVE_LIST_HH_
+#define SAL_INTRUSIVE_LIST_HH_
+
+#include <cstddef>
+
+namespace sal {
+
+/*!
+ * @brief links of an IntrusiveList embedded into the listed objects, an
+ *        object derives from one hook per list it can be in, told apart by
+ *        the Tag
+ */
+template <typename Tag = void>
+class ListHook {
+public:
+  constexpr ListHook() = default;
+  /// links belong to the list, never to a copy
+  constexpr ListHook(const ListHook&) {}
+  constexpr ListHook& operator=(const ListHook&) { return *this; }
+  constexpr ListHook* const & prev() const;
+  constexpr ListHook*& prev();
+  constexpr ListHook* const & next() const;
+  constexpr ListHook*& next();
+  constexpr ~ListHook() = default;
+protected:
+  ListHook* prev_ = nullptr;
+  ListHook* next_ = nullptr;
+private:
+};
+
+/*!
+ * @brief double linked list of objects it does not own, linking and
+ *        unlinking never allocate
+ * @note T derives from ListHook<Tag>, an object is in one such list at most,
+ *       and must outlive its membership; the list unlinks whatever is left
+ *       when it is destroyed
+ */
+template <typename T, typename Tag = void>
+class IntrusiveList {
+public:
+  using value_type = T;
+  using hook_type = ListHook<Tag>;
+  constexpr IntrusiveList() = default;
+  IntrusiveList(const IntrusiveList&) = delete;
+  IntrusiveList& operator=(const IntrusiveList&) = delete;
+  constexpr value_type* root() const;
+  constexpr value_type* last() const;
+  constexpr std::size_t size() const;
+  constexpr static value_type* prev(const value_type&);
+  constexpr static value_type* next(const value_type&);
+  /*!
+   * @brief appends an unlinked object
+   */
+  constexpr value_type& add(value_type&);
+  /*!
+   * @brief links an unlinked object in front of pos, at the end for nullptr
+   */
+  constexpr value_type& insert(value_type* pos, value_type&);
+  /*!
+   * @brief unlinks a linked object in O(1)
+   */
+  constexpr value_type& del(value_type&);
+  constexpr void clear();
+  constexpr ~IntrusiveList();
+protected:
+  constexpr static value_type* value(hook_type*);
+  hook_type* root_ = nullptr;
+  hook_type* last_ = nullptr;
+  std::size_t size_ = 0;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Tag>
+constexpr ListHook<Tag>* const & ListHook<Tag>::prev() const {
+  return this->prev_;
+}
+
+template <typename Tag>
+constexpr ListHook<Tag>*& ListHook<Tag>::prev() {
+  return this->prev_;
+}
+
+template <typename Tag>
+constexpr ListHook<Tag>* const & ListHook<Tag>::next() const {
+  return this->next_;
+}
+
+template <typename Tag>
+constexpr ListHook<Tag>*& ListHook<Tag>::next() {
+  return this->next_;
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type*
+IntrusiveList<T, Tag>::value(hook_type* hook) {
+  return hook ? static_cast<value_type*>(hook) : nullptr;
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type*
+IntrusiveList<T, Tag>::root() const {
+  return value(this->root_);
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type*
+IntrusiveList<T, Tag>::last() const {
+  return value(this->last_);
+}
+
+template <typename T, typename Tag>
+constexpr std::size_t IntrusiveList<T, Tag>::size() const {
+  return this->size_;
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type*
+IntrusiveList<T, Tag>::prev(const value_type& val) {
+  return value(static_cast<const hook_type&>(val).prev());
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type*
+IntrusiveList<T, Tag>::next(const value_type& val) {
+  return value(static_cast<const hook_type&>(val).next());
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type&
+IntrusiveList<T, Tag>::add(value_type& val) {
+  return this->insert(nullptr, val);
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type&
+IntrusiveList<T, Tag>::insert(value_type* pos, value_type& val) {
+  hook_type* hook = &val;
+  hook_type* next = pos;
+  hook->next() = next;
+  hook->prev() = next ? next->prev() : this->last_;
+  if (hook->prev()) {
+    hook->prev()->next() = hook;
+  } else {
+    this->root_ = hook;
+  }
+  if (next) {
+    next->prev() = hook;
+  } else {
+    this->last_ = hook;
+  }
+  this->size_++;
+  return val;
+}
+
+template <typename T, typename Tag>
+constexpr typename IntrusiveList<T, Tag>::value_type&
+IntrusiveList<T, Tag>::del(value_type& val) {
+  hook_type* hook = &val;
+  if (hook->prev()) {
+    hook->prev()->next() = hook->next();
+  } else {
+    this->root_ = hook->next();
+  }
+  if (hook->next()) {
+    hook->next()->prev() = hook->prev();
+  } else {
+    this->last_ = hook->prev();
+  }
+  hook->prev() = nullptr;
+  hook->next() = nullptr;
+  this->size_--;
+  return val;
+}
+
+template <typename T, typename Tag>
+constexpr void IntrusiveList<T, Tag>::clear() {
+  while (this->root_) {
+    auto* hook = this->root_;
+    this->root_ = hook->next();
+    hook->prev() = nullptr;
+    hook->next() = nullptr;
+  }
+  this->last_ = nullptr;
+  this->size_ = 0;
+}
+
+template <typename T, typename Tag>
+constexpr IntrusiveList<T, Tag>::~IntrusiveList() {
+  this->clear();
+}
+
+} /// namespace sal
+
+#endif /// SAL_INTRUSIVE_LIST_HH_
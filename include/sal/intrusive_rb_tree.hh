@@ -0,0 +1,256 @@
+#ifndef SAL_INTRUSIVE_RB_TREE_HH_
+#define SAL_INTRUSIVE_RB_TREE_HH_
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include <sal/rb_algorithm.hh>
+
+namespace sal {
+
+/*!
+ * @brief links of an IntrusiveRBTree embedded into the stored objects, an
+ *        object derives from one hook per tree it can be in, told apart by
+ *        the Tag
+ */
+template <typename Tag = void>
+class RBTreeHook {
+public:
+  enum class Color : bool {
+    BLACK,
+    RED,
+  };
+  using childs_type = std::array<RBTreeHook*, 2>;
+  constexpr RBTreeHook() = default;
+  /// links belong to the tree, never to a copy
+  constexpr RBTreeHook(const RBTreeHook&) {}
+  constexpr RBTreeHook& operator=(const RBTreeHook&) { return *this; }
+  constexpr const childs_type& childs() const;
+  constexpr childs_type& childs();
+  constexpr RBTreeHook* const & left() const;
+  constexpr RBTreeHook*& left();
+  constexpr RBTreeHook* const & right() const;
+  constexpr RBTreeHook*& right();
+  constexpr RBTreeHook* const & parent() const;
+  constexpr RBTreeHook*& parent();
+  constexpr const Color& color() const;
+  constexpr Color& color();
+  constexpr ~RBTreeHook() = default;
+protected:
+  childs_type childs_{nullptr, nullptr};
+  RBTreeHook* parent_ = nullptr;
+  Color color_ = Color::RED;
+private:
+};
+
+/*!
+ * @brief red black tree of objects it does not own, ordered by Compare,
+ *        linking and unlinking never allocate, the rebalancing is the one
+ *        of RBTree
+ * @note T derives from RBTreeHook<Tag>, an object is in one such tree at
+ *       most, and must outlive its membership; equal objects may coexist;
+ *       the tree unlinks whatever is left when it is destroyed
+ */
+template <typename T, typename Tag = void, typename Compare = std::less<>>
+class IntrusiveRBTree {
+public:
+  using value_type = T;
+  using hook_type = RBTreeHook<Tag>;
+  constexpr IntrusiveRBTree() = default;
+  IntrusiveRBTree(const IntrusiveRBTree&) = delete;
+  IntrusiveRBTree& operator=(const IntrusiveRBTree&) = delete;
+  constexpr hook_type* const & root() const;
+  constexpr std::size_t size() const;
+  constexpr static value_type* value(hook_type*);
+  constexpr static const value_type* value(const hook_type*);
+  /*!
+   * @brief links an unlinked object in O(log n)
+   */
+  constexpr value_type& insert(value_type&);
+  /*!
+   * @brief unlinks a linked object without searching for it
+   */
+  constexpr value_type& remove(value_type&);
+  /*!
+   * @brief unlinks an object equal to key
+   * @return the unlinked object, nullptr when absent
+   */
+  template <typename Key>
+  constexpr value_type* remove(const Key&);
+  /*!
+   * @brief object equal to key, Compare takes key on either side
+   */
+  template <typename Key>
+  constexpr value_type* find(const Key&) const;
+  constexpr void clear();
+  constexpr ~IntrusiveRBTree();
+protected:
+  constexpr static void clear(hook_type*);
+  hook_type* root_ = nullptr;
+  std::size_t size_ = 0;
+  [[no_unique_address]] Compare compare_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Tag>
+constexpr const typename RBTreeHook<Tag>::childs_type&
+RBTreeHook<Tag>::childs() const {
+  return this->childs_;
+}
+
+template <typename Tag>
+constexpr typename RBTreeHook<Tag>::childs_type& RBTreeHook<Tag>::childs() {
+  return this->childs_;
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>* const & RBTreeHook<Tag>::left() const {
+  return this->childs_[0];
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>*& RBTreeHook<Tag>::left() {
+  return this->childs_[0];
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>* const & RBTreeHook<Tag>::right() const {
+  return this->childs_[1];
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>*& RBTreeHook<Tag>::right() {
+  return this->childs_[1];
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>* const & RBTreeHook<Tag>::parent() const {
+  return this->parent_;
+}
+
+template <typename Tag>
+constexpr RBTreeHook<Tag>*& RBTreeHook<Tag>::parent() {
+  return this->parent_;
+}
+
+template <typename Tag>
+constexpr const typename RBTreeHook<Tag>::Color&
+RBTreeHook<Tag>::color() const {
+  return this->color_;
+}
+
+template <typename Tag>
+constexpr typename RBTreeHook<Tag>::Color& RBTreeHook<Tag>::color() {
+  return this->color_;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::hook_type* const &
+IntrusiveRBTree<T, Tag, Compare>::root() const {
+  return this->root_;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr std::size_t IntrusiveRBTree<T, Tag, Compare>::size() const {
+  return this->size_;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::value_type*
+IntrusiveRBTree<T, Tag, Compare>::value(hook_type* hook) {
+  return hook ? static_cast<value_type*>(hook) : nullptr;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr const typename IntrusiveRBTree<T, Tag, Compare>::value_type*
+IntrusiveRBTree<T, Tag, Compare>::value(const hook_type* hook) {
+  return hook ? static_cast<const value_type*>(hook) : nullptr;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::value_type&
+IntrusiveRBTree<T, Tag, Compare>::insert(value_type& val) {
+  hook_type* hook = &val;
+  hook_type* parent = nullptr;
+  auto* slot = &this->root_;
+  while (*slot) {
+    parent = *slot;
+    const auto right = this->compare_(*value(parent), val);
+    slot = &parent->childs()[right ? 1 : 0];
+  }
+  hook->left() = nullptr;
+  hook->right() = nullptr;
+  hook->parent() = parent;
+  hook->color() = hook_type::Color::RED;
+  *slot = hook;
+  rb::fixInsert(this->root_, hook);
+  this->size_++;
+  return val;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::value_type&
+IntrusiveRBTree<T, Tag, Compare>::remove(value_type& val) {
+  rb::erase(this->root_, static_cast<hook_type*>(&val));
+  this->size_--;
+  return val;
+}
+
+template <typename T, typename Tag, typename Compare>
+template <typename Key>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::value_type*
+IntrusiveRBTree<T, Tag, Compare>::remove(const Key& key) {
+  auto* found = this->find(key);
+  return found ? &this->remove(*found) : nullptr;
+}
+
+template <typename T, typename Tag, typename Compare>
+template <typename Key>
+constexpr typename IntrusiveRBTree<T, Tag, Compare>::value_type*
+IntrusiveRBTree<T, Tag, Compare>::find(const Key& key) const {
+  auto* it = this->root_;
+  while (it) {
+    auto* val = value(it);
+    if (this->compare_(key, *val)) {
+      it = it->left();
+    } else if (this->compare_(*val, key)) {
+      it = it->right();
+    } else {
+      return val;
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr void IntrusiveRBTree<T, Tag, Compare>::clear(hook_type* hook) {
+  if (!hook) {
+    return;
+  }
+  clear(hook->left());
+  clear(hook->right());
+  hook->left() = nullptr;
+  hook->right() = nullptr;
+  hook->parent() = nullptr;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr void IntrusiveRBTree<T, Tag, Compare>::clear() {
+  clear(this->root_);
+  this->root_ = nullptr;
+  this->size_ = 0;
+}
+
+template <typename T, typename Tag, typename Compare>
+constexpr IntrusiveRBTree<T, Tag, Compare>::~IntrusiveRBTree() {
+  this->clear();
+}
+
+} /// namespace sal
+
+#endif /// SAL_INTRUSIVE_RB_TREE_HH_
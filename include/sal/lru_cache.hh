@@ -0,0 +1,234 @@
+#ifndef SAL_LRU_CACHE_HH_
+#define SAL_LRU_CACHE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include <sal/double_linked_list.hh>
+#include <sal/hash_index.hh>
+
+namespace sal {
+
+/*!
+ * @brief fixed capacity cache evicting the least recently used entry, the
+ *        entries are list nodes indexed by key, so an entry costs a single
+ *        allocation, and none at all once the cache is full since the
+ *        evicted node is reused for the new entry
+ *
+ * with a protected capacity the cache is a segmented lru: new entries start
+ * in the probation segment, a hit promotes an entry to the protected one,
+ * whose least recently used entry is demoted back to the front of probation
+ * once it overflows, so a scan over cold keys cannot flush the hot ones
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  static constexpr std::uint8_t PROBATION = 0;
+  static constexpr std::uint8_t PROTECTED = 1;
+  struct Entry {
+    key_type key{};
+    mapped_type value{};
+    std::uint8_t segment = PROBATION;
+    /// entries are identified by their key alone
+    friend constexpr bool operator==(const Entry& a, const Entry& b) {
+      return a.key == b.key;
+    }
+  };
+  using value_type = Entry;
+  using list_type = DoubleLinkedList<value_type>;
+  using node_type = typename list_type::template Node<value_type>;
+  /*!
+   * @param capacity entries kept at most, raised to 1
+   * @param protectedCapacity entries of the protected segment, 0 for a plain
+   *        lru, lowered below capacity
+   */
+  LRUCache(std::size_t capacity, std::size_t protectedCapacity = 0);
+  LRUCache(const LRUCache&) = delete;
+  LRUCache& operator=(const LRUCache&) = delete;
+  std::size_t size() const;
+  std::size_t capacity() const;
+  /*!
+   * @brief entries of a segment, most recently used first
+   */
+  const list_type& segment(std::uint8_t) const;
+  /*!
+   * @return the cached value, nullptr on a miss
+   * @note a hit makes the entry the most recently used one
+   */
+  mapped_type* get(const key_type&);
+  /*!
+   * @brief inserts or overwrites the value of key, evicting the least
+   *        recently used entry when the cache is full
+   * @return the cached value
+   */
+  mapped_type* put(const key_type&, const mapped_type&);
+  mapped_type* put(const key_type&, mapped_type&&);
+  bool del(const key_type&);
+  virtual ~LRUCache() = default;
+protected:
+  struct KeyOf {
+    constexpr const key_type& operator()(const node_type& node) const {
+      return node.value().key;
+    }
+  };
+  /*!
+   * @brief a segment relinks its entries through the list hooks
+   */
+  class Segment : public list_type {
+  public:
+    using list_type::link;
+    using list_type::unlink;
+    void pushFront(node_type*);
+  };
+  void touch(node_type*);
+  node_type* victim();
+  Segment segments_[2];
+  std::size_t sizes_[2] = {0, 0};
+  std::size_t capacity_ = 0;
+  std::size_t protectedCapacity_ = 0;
+  HashIndex<node_type, key_type, KeyOf, Hash> index_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Key, typename Value, typename Hash>
+LRUCache<Key, Value, Hash>::LRUCache(
+    std::size_t capacity,
+    std::size_t protectedCapacity
+) : capacity_(std::max<std::size_t>(capacity, 1)),
+    protectedCapacity_(std::min(protectedCapacity, capacity_ - 1)) {
+  this->index_.reserve(this->capacity_);
+}
+
+template <typename Key, typename Value, typename Hash>
+std::size_t LRUCache<Key, Value, Hash>::size() const {
+  return this->index_.size();
+}
+
+template <typename Key, typename Value, typename Hash>
+std::size_t LRUCache<Key, Value, Hash>::capacity() const {
+  return this->capacity_;
+}
+
+template <typename Key, typename Value, typename Hash>
+const typename LRUCache<Key, Value, Hash>::list_type&
+LRUCache<Key, Value, Hash>::segment(std::uint8_t i) const {
+  return this->segments_[i];
+}
+
+template <typename Key, typename Value, typename Hash>
+void LRUCache<Key, Value, Hash>::Segment::pushFront(node_type* node) {
+  this->link(this->root(), node, node);
+}
+
+/*!
+ * @brief moves a hit entry to the front, in the segmented mode into the
+ *        protected segment, demoting its least recently used entry when full
+ */
+template <typename Key, typename Value, typename Hash>
+void LRUCache<Key, Value, Hash>::touch(node_type* node) {
+  auto& probation = this->segments_[PROBATION];
+  auto& protect = this->segments_[PROTECTED];
+  if (!this->protectedCapacity_) {
+    if (node != probation.root()) {
+      probation.unlink(node);
+      probation.pushFront(node);
+    }
+    return;
+  }
+  if (node->value().segment == PROTECTED) {
+    protect.unlink(node);
+    protect.pushFront(node);
+    return;
+  }
+  probation.unlink(node);
+  this->sizes_[PROBATION]--;
+  if (this->sizes_[PROTECTED] == this->protectedCapacity_) {
+    auto* demoted = protect.last();
+    protect.unlink(demoted);
+    probation.pushFront(demoted);
+    demoted->value().segment = PROBATION;
+    this->sizes_[PROTECTED]--;
+    this->sizes_[PROBATION]++;
+  }
+  protect.pushFront(node);
+  node->value().segment = PROTECTED;
+  this->sizes_[PROTECTED]++;
+}
+
+template <typename Key, typename Value, typename Hash>
+typename LRUCache<Key, Value, Hash>::node_type*
+LRUCache<Key, Value, Hash>::victim() {
+  const auto segment =
+      this->segments_[PROBATION].last() ? PROBATION : PROTECTED;
+  auto* node = this->segments_[segment].last();
+  this->segments_[segment].unlink(node);
+  this->sizes_[segment]--;
+  this->index_.erase(node->value().key);
+  return node;
+}
+
+template <typename Key, typename Value, typename Hash>
+typename LRUCache<Key, Value, Hash>::mapped_type*
+LRUCache<Key, Value, Hash>::get(const key_type& key) {
+  auto* node = this->index_.find(key);
+  if (!node) {
+    return nullptr;
+  }
+  this->touch(node);
+  return &node->value().value;
+}
+
+template <typename Key, typename Value, typename Hash>
+typename LRUCache<Key, Value, Hash>::mapped_type*
+LRUCache<Key, Value, Hash>::put(const key_type& key, const mapped_type& val) {
+  return this->put(key, mapped_type(val));
+}
+
+template <typename Key, typename Value, typename Hash>
+typename LRUCache<Key, Value, Hash>::mapped_type*
+LRUCache<Key, Value, Hash>::put(const key_type& key, mapped_type&& val) {
+  if (auto* node = this->index_.find(key)) {
+    node->value().value = std::move(val);
+    this->touch(node);
+    return &node->value().value;
+  }
+  node_type* node = nullptr;
+  if (this->size() < this->capacity_) {
+    node = new node_type(value_type{key, std::move(val)});
+  } else {
+    node = this->victim();
+    node->value().key = key;
+    node->value().value = std::move(val);
+    node->value().segment = PROBATION;
+  }
+  this->segments_[PROBATION].pushFront(node);
+  this->sizes_[PROBATION]++;
+  this->index_.insert(node);
+  return &node->value().value;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool LRUCache<Key, Value, Hash>::del(const key_type& key) {
+  auto* node = this->index_.erase(key);
+  if (!node) {
+    return false;
+  }
+  const auto segment = node->value().segment;
+  this->segments_[segment].unlink(node);
+  this->sizes_[segment]--;
+  delete node;
+  return true;
+}
+
+} /// namespace sal
+
+#endif /// SAL_LRU_CACHE_HH_
@@ -0,0 +1,577 @@
+#ifndef SAL_LSM_SET_HH_
+#define SAL_LSM_SET_HH_
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <sal/rb_tree.hh>
+
+namespace sal {
+
+/*!
+ * @brief parts of LsmSet
+ */
+namespace lsm {
+
+/*!
+ * @brief value written to an LsmSet, or its tombstone, ordered by value
+ */
+template <typename T>
+struct Record {
+  T value{};
+  bool removed = false;
+  constexpr bool operator<(const Record& o) const { return value < o.value; }
+  constexpr bool operator>(const Record& o) const { return o.value < value; }
+  constexpr bool operator<=(const Record& o) const {
+    return !(o.value < value);
+  }
+};
+
+/*!
+ * @brief bloom filter of k hashes derived from one 64 bit hash by double
+ *        hashing, k = bits per key * ln 2
+ */
+class Bloom {
+public:
+  Bloom() = default;
+  Bloom(std::size_t keys, double bitsPerKey);
+  void add(std::uint64_t hash);
+  bool contains(std::uint64_t hash) const;
+  /*!
+   * @brief finalizer of splitmix64, std::hash of integers is the identity
+   */
+  static constexpr std::uint64_t mix(std::uint64_t);
+protected:
+  std::vector<std::uint64_t> words_;
+  std::uint64_t bits_ = 0;
+  std::size_t hashes_ = 0;
+private:
+};
+
+/*!
+ * @brief immutable sorted records with their bloom filter, held in memory
+ *        or in a file mapped read only and removed with the run
+ */
+template <typename T>
+class Run {
+public:
+  using record_type = Record<T>;
+  /*!
+   * @param path template of the file to move the records to, its trailing
+   *        XXXXXX made unique by mkstemp; none when empty or when the
+   *        records are not trivially copyable
+   */
+  Run(std::vector<record_type>&&, double bitsPerKey, std::string path);
+  Run(const Run&) = delete;
+  Run& operator=(const Run&) = delete;
+  const record_type* begin() const;
+  const record_type* end() const;
+  std::size_t size() const;
+  bool mapped() const;
+  /*!
+   * @return record of val, nullptr when absent
+   */
+  const record_type* find(const T& val, std::uint64_t hash) const;
+  virtual ~Run();
+protected:
+  bool map();
+  std::vector<record_type> records_;
+  const record_type* data_ = nullptr;
+  std::size_t size_ = 0;
+  Bloom bloom_;
+  std::string path_;
+  void* map_ = nullptr;
+private:
+};
+
+} /// namespace lsm
+
+/*!
+ * @brief ordered set for write heavy loads: writes go to an RBTree
+ *        memtable, flushed once full to an immutable sorted run; runs are
+ *        merged by a background thread, Options::ratio runs of a size tier
+ *        into one of the next tier, so that a value is rewritten
+ *        O(log n / log ratio) times
+ *
+ * find() probes the memtable, then the runs newest first, each behind its
+ * bloom filter; a remove is a tombstone, dropped when merged into the
+ * oldest run
+ * @note insert(), remove(), flush() and find() come from one thread at a
+ *       time, a find() must not run while a write replaces the memtable;
+ *       none of them waits for the compaction
+ */
+template <typename Data>
+class LsmSet {
+public:
+  using value_type = Data;
+  using record_type = lsm::Record<value_type>;
+  using run_type = lsm::Run<value_type>;
+  struct Options {
+    /// records of the memtable that make it flush
+    std::size_t memtable = 1 << 16;
+    /// runs of a tier merged together, tiers grow by this factor
+    std::size_t ratio = 4;
+    double bitsPerKey = 10;
+    /// directory of the run files, runs stay in memory when empty; each
+    /// run gets a file of its own, so sets may share a directory
+    std::string directory;
+    /// false merges in flush(), on the writing thread
+    bool background = true;
+  };
+  LsmSet() : LsmSet(Options{}) {}
+  explicit LsmSet(Options);
+  LsmSet(const LsmSet&) = delete;
+  LsmSet& operator=(const LsmSet&) = delete;
+  void insert(const value_type&);
+  void remove(const value_type&);
+  bool find(const value_type&) const;
+  /*!
+   * @brief turns the memtable into a run
+   */
+  void flush();
+  /*!
+   * @brief waits for the background merges to be done
+   */
+  void compact();
+  std::size_t runs() const;
+  /*!
+   * @brief records of the memtable and the runs, tombstones included
+   */
+  std::size_t records() const;
+  virtual ~LsmSet();
+protected:
+  using runs_type = std::vector<std::shared_ptr<const run_type>>;
+  void put(const value_type&, bool removed);
+  std::shared_ptr<const runs_type> current() const;
+  std::size_t tier(std::size_t) const;
+  bool merge();
+  void compactor();
+  Options options_;
+  std::unique_ptr<RBTree<record_type>> memtable_;
+  std::size_t memtableSize_ = 0;
+  mutable std::mutex mutex_;
+  /// wakes the compactor for a new run
+  std::condition_variable work_;
+  /// wakes compact() once the compactor is idle
+  std::condition_variable idle_;
+  /// newest first, replaced whole so that a find holds its own
+  std::shared_ptr<const runs_type> runs_;
+  bool pending_ = false;
+  bool busy_ = false;
+  bool stop_ = false;
+  std::thread thread_;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+namespace lsm {
+
+constexpr std::uint64_t Bloom::mix(std::uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+inline Bloom::Bloom(std::size_t keys, double bitsPerKey) {
+  const auto bits = std::max<std::uint64_t>(
+      64,
+      static_cast<std::uint64_t>(keys * bitsPerKey)
+  );
+  this->words_.assign((bits + 63) / 64, 0);
+  this->bits_ = this->words_.size() * 64;
+  this->hashes_ = std::clamp<std::size_t>(
+      static_cast<std::size_t>(std::lround(bitsPerKey * 0.69)),
+      1,
+      16
+  );
+}
+
+inline void Bloom::add(std::uint64_t hash) {
+  const auto step = std::rotl(hash, 32) | 1;
+  for (std::size_t i = 0; i < this->hashes_; i++, hash += step) {
+    const auto bit = hash % this->bits_;
+    this->words_[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+}
+
+inline bool Bloom::contains(std::uint64_t hash) const {
+  const auto step = std::rotl(hash, 32) | 1;
+  for (std::size_t i = 0; i < this->hashes_; i++, hash += step) {
+    const auto bit = hash % this->bits_;
+    if (!(this->words_[bit / 64] >> (bit % 64) & 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+Run<T>::Run(
+    std::vector<record_type>&& records,
+    double bitsPerKey,
+    std::string path
+) : records_(std::move(records)),
+    data_(records_.data()),
+    size_(records_.size()),
+    bloom_(records_.size(), bitsPerKey),
+    path_(std::move(path)) {
+  for (const auto& record : this->records_) {
+    this->bloom_.add(Bloom::mix(std::hash<T>{}(record.value)));
+  }
+  if constexpr (std::is_trivially_copyable_v<record_type>) {
+    if (!this->path_.empty() && this->size_ && this->map()) {
+      std::vector<record_type>().swap(this->records_);
+    }
+  }
+  if (!this->map_) {
+    this->path_.clear();
+  }
+}
+
+/*!
+ * @brief writes the records to a new file named after path_ and maps them
+ *        in their place
+ */
+template <typename T>
+bool Run<T>::map() {
+  const auto fd = ::mkstemp(this->path_.data());
+  if (fd < 0) {
+    return false;
+  }
+  const auto bytes = this->size_ * sizeof(record_type);
+  const auto* data = reinterpret_cast<const char*>(this->data_);
+  std::size_t done = 0;
+  while (done < bytes) {
+    const auto written = ::write(fd, data + done, bytes - done);
+    if (written <= 0) {
+      break;
+    }
+    done += static_cast<std::size_t>(written);
+  }
+  void* map = MAP_FAILED;
+  if (done == bytes) {
+    map = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    ::unlink(this->path_.c_str());
+    return false;
+  }
+  this->map_ = map;
+  this->data_ = static_cast<const record_type*>(map);
+  return true;
+}
+
+template <typename T>
+const typename Run<T>::record_type* Run<T>::begin() const {
+  return this->data_;
+}
+
+template <typename T>
+const typename Run<T>::record_type* Run<T>::end() const {
+  return this->data_ + this->size_;
+}
+
+template <typename T>
+std::size_t Run<T>::size() const {
+  return this->size_;
+}
+
+template <typename T>
+bool Run<T>::mapped() const {
+  return this->map_;
+}
+
+template <typename T>
+const typename Run<T>::record_type*
+Run<T>::find(const T& val, std::uint64_t hash) const {
+  if (!this->bloom_.contains(hash)) {
+    return nullptr;
+  }
+  const auto* it = std::lower_bound(
+      this->begin(),
+      this->end(),
+      val,
+      [](const record_type& r, const T& v) { return r.value < v; }
+  );
+  return it != this->end() && !(val < it->value) ? it : nullptr;
+}
+
+template <typename T>
+Run<T>::~Run() {
+  if (this->map_) {
+    ::munmap(this->map_, this->size_ * sizeof(record_type));
+    ::unlink(this->path_.c_str());
+  }
+}
+
+} /// namespace lsm
+
+template <typename Data>
+LsmSet<Data>::LsmSet(Options options)
+  : options_(std::move(options)),
+    memtable_(std::make_unique<RBTree<record_type>>()),
+    runs_(std::make_shared<const runs_type>()) {
+  this->options_.ratio = std::max<std::size_t>(this->options_.ratio, 2);
+  if (this->options_.background) {
+    this->thread_ = std::thread([this] { this->compactor(); });
+  }
+}
+
+template <typename Data>
+void LsmSet<Data>::put(const value_type& val, bool removed) {
+  if (auto* node = this->memtable_->find(record_type{val})) {
+    node->value().removed = removed;
+    return;
+  }
+  this->memtable_->insert(record_type{val, removed});
+  if (++this->memtableSize_ >= this->options_.memtable) {
+    this->flush();
+  }
+}
+
+template <typename Data>
+void LsmSet<Data>::insert(const value_type& val) {
+  this->put(val, false);
+}
+
+template <typename Data>
+void LsmSet<Data>::remove(const value_type& val) {
+  this->put(val, true);
+}
+
+template <typename Data>
+std::shared_ptr<const typename LsmSet<Data>::runs_type>
+LsmSet<Data>::current() const {
+  std::lock_guard lock(this->mutex_);
+  return this->runs_;
+}
+
+template <typename Data>
+bool LsmSet<Data>::find(const value_type& val) const {
+  if (const auto* node = this->memtable_->find(record_type{val})) {
+    return !node->value().removed;
+  }
+  const auto hash = lsm::Bloom::mix(std::hash<value_type>{}(val));
+  const auto runs = this->current();
+  for (const auto& run : *runs) {
+    if (const auto* record = run->find(val, hash)) {
+      return !record->removed;
+    }
+  }
+  return false;
+}
+
+template <typename Data>
+void LsmSet<Data>::flush() {
+  if (!this->memtableSize_) {
+    return;
+  }
+  std::vector<record_type> records;
+  records.reserve(this->memtableSize_);
+  std::vector<const typename RBTree<record_type>::node_type*> stack;
+  for (const auto* it = this->memtable_->root(); it || !stack.empty();) {
+    if (it) {
+      stack.push_back(it);
+      it = it->left();
+      continue;
+    }
+    it = stack.back();
+    stack.pop_back();
+    records.push_back(it->value());
+    it = it->right();
+  }
+  this->memtable_ = std::make_unique<RBTree<record_type>>();
+  this->memtableSize_ = 0;
+  std::string path;
+  if (!this->options_.directory.empty()) {
+    path = this->options_.directory + "/run-XXXXXX";
+  }
+  auto run = std::make_shared<const run_type>(
+      std::move(records),
+      this->options_.bitsPerKey,
+      std::move(path)
+  );
+  {
+    std::lock_guard lock(this->mutex_);
+    auto runs = std::make_shared<runs_type>();
+    runs->reserve(this->runs_->size() + 1);
+    runs->push_back(std::move(run));
+    runs->insert(runs->end(), this->runs_->begin(), this->runs_->end());
+    this->runs_ = std::move(runs);
+    this->pending_ = true;
+  }
+  if (this->options_.background) {
+    this->work_.notify_one();
+  } else {
+    while (this->merge()) {}
+  }
+}
+
+/*!
+ * @brief 0 for a run up to the size of a memtable, then one more per
+ *        factor of ratio
+ */
+template <typename Data>
+std::size_t LsmSet<Data>::tier(std::size_t size) const {
+  std::size_t ret = 0;
+  for (auto bound = this->options_.memtable; size > bound; ret++) {
+    bound *= this->options_.ratio;
+  }
+  return ret;
+}
+
+/*!
+ * @brief merges the newest group of ratio or more runs of the same tier,
+ *        the runs are picked and replaced under the lock and merged without
+ *        it, other runs may only be added in front meanwhile
+ * @return whether a group was merged
+ */
+template <typename Data>
+bool LsmSet<Data>::merge() {
+  const auto runs = this->current();
+  /// tiers never decrease from the newest run to the oldest
+  std::size_t first = 0;
+  std::size_t last = 0;
+  bool found = false;
+  for (std::size_t i = 0; i < runs->size() && !found; i = last) {
+    const auto t = this->tier((*runs)[i]->size());
+    for (last = i; last < runs->size() &&
+        this->tier((*runs)[last]->size()) == t; last++) {}
+    if (last - i >= this->options_.ratio) {
+      first = i;
+      found = true;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+  const auto oldest = last == runs->size();
+  /// heads of the runs, the newest wins among equal values
+  std::vector<std::pair<const record_type*, const record_type*>> heads;
+  std::size_t total = 0;
+  for (auto i = first; i < last; i++) {
+    heads.emplace_back((*runs)[i]->begin(), (*runs)[i]->end());
+    total += (*runs)[i]->size();
+  }
+  std::vector<record_type> records;
+  records.reserve(total);
+  while (true) {
+    const record_type* min = nullptr;
+    for (const auto& [it, end] : heads) {
+      if (it != end && (!min || it->value < min->value)) {
+        min = it;
+      }
+    }
+    if (!min) {
+      break;
+    }
+    if (!oldest || !min->removed) {
+      records.push_back(*min);
+    }
+    const auto val = min->value;
+    for (auto& [it, end] : heads) {
+      if (it != end && !(val < it->value)) {
+        it++;
+      }
+    }
+  }
+  std::string path;
+  if (!this->options_.directory.empty()) {
+    path = this->options_.directory + "/run-XXXXXX";
+  }
+  auto merged = std::make_shared<const run_type>(
+      std::move(records),
+      this->options_.bitsPerKey,
+      std::move(path)
+  );
+  std::lock_guard lock(this->mutex_);
+  const auto& now = *this->runs_;
+  const auto shift = now.size() - runs->size();
+  auto next = std::make_shared<runs_type>(now.begin(), now.begin() + shift);
+  next->insert(next->end(), runs->begin(), runs->begin() + first);
+  if (merged->size()) {
+    next->push_back(std::move(merged));
+  }
+  next->insert(next->end(), runs->begin() + last, runs->end());
+  this->runs_ = std::move(next);
+  return true;
+}
+
+template <typename Data>
+void LsmSet<Data>::compactor() {
+  std::unique_lock lock(this->mutex_);
+  while (true) {
+    this->work_.wait(lock, [&] { return this->stop_ || this->pending_; });
+    if (this->stop_) {
+      return;
+    }
+    this->pending_ = false;
+    this->busy_ = true;
+    lock.unlock();
+    while (this->merge()) {}
+    lock.lock();
+    this->busy_ = false;
+    this->idle_.notify_all();
+  }
+}
+
+template <typename Data>
+void LsmSet<Data>::compact() {
+  if (!this->options_.background) {
+    while (this->merge()) {}
+    return;
+  }
+  std::unique_lock lock(this->mutex_);
+  this->idle_.wait(lock, [&] { return !this->pending_ && !this->busy_; });
+}
+
+template <typename Data>
+std::size_t LsmSet<Data>::runs() const {
+  return this->current()->size();
+}
+
+template <typename Data>
+std::size_t LsmSet<Data>::records() const {
+  std::size_t ret = this->memtableSize_;
+  const auto runs = this->current();
+  for (const auto& run : *runs) {
+    ret += run->size();
+  }
+  return ret;
+}
+
+template <typename Data>
+LsmSet<Data>::~LsmSet() {
+  if (this->thread_.joinable()) {
+    {
+      std::lock_guard lock(this->mutex_);
+      this->stop_ = true;
+    }
+    this->work_.notify_one();
+    this->thread_.join();
+  }
+}
+
+} /// namespace sal
+
+#endif /// SAL_LSM_SET_HH_
@@ -0,0 +1,332 @@
+#ifndef SAL_MAPPED_TREE_HH_
+#define SAL_MAPPED_TREE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sal/snapshot.hh>
+
+namespace sal {
+
+/*!
+ * @brief read only search tree laid out in a file, mapped and queried in
+ *        place: nodes refer to their childs by their distance in nodes, so
+ *        the image holds no pointer and means the same wherever it is
+ *        mapped, by any number of processes sharing the pages
+ *
+ * the image is a 64 byte header, the nodes in breadth first order and the
+ * checksum of both as written by snapshot::Writer; it keeps the shape of
+ * the tree it was written from, e.g. an RBTree or an AATree
+ * @note open() only checks the header and the size, so startup stays
+ *       O(1); find() and inorder() treat a child out of the image as none,
+ *       verify() checks every distance and the checksum at the cost of
+ *       reading the whole image, Node::left() and Node::right() are only
+ *       safe to follow on an image that verifies
+ */
+template <typename Data>
+class MappedTree {
+public:
+  using value_type = Data;
+  static_assert(std::is_trivially_copyable_v<value_type>);
+  static constexpr std::uint64_t MAGIC = 0x3154504d4c4153; /// "SALMPT1"
+  static constexpr std::uint32_t VERSION = 1;
+  class Node {
+  public:
+    constexpr const value_type& value() const;
+    constexpr const Node* left() const;
+    constexpr const Node* right() const;
+  protected:
+    friend class MappedTree;
+    constexpr const Node* child(std::size_t) const;
+    value_type value_;
+    /// distance to the child in nodes, 0 for none
+    std::int32_t childs_[2];
+  private:
+  };
+  using node_type = Node;
+  struct alignas(64) Header {
+    std::uint64_t magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t valueSize = sizeof(value_type);
+    std::uint32_t nodeSize = sizeof(node_type);
+    std::uint64_t count = 0;
+  };
+  constexpr MappedTree() = default;
+  MappedTree(const MappedTree&) = delete;
+  MappedTree& operator=(const MappedTree&) = delete;
+  MappedTree(MappedTree&&);
+  MappedTree& operator=(MappedTree&&);
+  /*!
+   * @brief writes the image of the tree at root to a std::ostream or a file
+   *        descriptor
+   */
+  template <typename Sink, typename SourceNode>
+  static bool write(Sink&&, const SourceNode* root);
+  /*!
+   * @brief maps the image at path read only
+   * @return false, leaving the tree closed, for a missing or malformed image
+   */
+  bool open(const char* path);
+  void close();
+  bool verify() const;
+  constexpr const node_type* root() const;
+  constexpr std::size_t size() const;
+  constexpr const node_type* find(const value_type&) const;
+  /*!
+   * @brief calls f with every value in order
+   */
+  template <typename F>
+  void inorder(F&& f) const;
+  virtual ~MappedTree();
+protected:
+  /*!
+   * @brief child i of node, nullptr as well for a distance out of the image
+   */
+  constexpr const node_type* child(const node_type*, std::size_t) const;
+  const void* image_ = nullptr;
+  std::size_t bytes_ = 0;
+  const node_type* nodes_ = nullptr;
+  std::size_t size_ = 0;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::value_type&
+MappedTree<Data>::Node::value() const {
+  return this->value_;
+}
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::Node*
+MappedTree<Data>::Node::child(std::size_t i) const {
+  return this->childs_[i] ? this + this->childs_[i] : nullptr;
+}
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::Node*
+MappedTree<Data>::Node::left() const {
+  return this->child(0);
+}
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::Node*
+MappedTree<Data>::Node::right() const {
+  return this->child(1);
+}
+
+template <typename Data>
+MappedTree<Data>::MappedTree(MappedTree&& other)
+  : image_(std::exchange(other.image_, nullptr)),
+    bytes_(std::exchange(other.bytes_, 0)),
+    nodes_(std::exchange(other.nodes_, nullptr)),
+    size_(std::exchange(other.size_, 0)) {}
+
+template <typename Data>
+MappedTree<Data>& MappedTree<Data>::operator=(MappedTree&& other) {
+  if (this != &other) {
+    this->close();
+    this->image_ = std::exchange(other.image_, nullptr);
+    this->bytes_ = std::exchange(other.bytes_, 0);
+    this->nodes_ = std::exchange(other.nodes_, nullptr);
+    this->size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+/*!
+ * @note breadth first, a node gets its index when its parent is written,
+ *       so the distances are known without a second pass
+ */
+template <typename Data>
+template <typename Sink, typename SourceNode>
+bool MappedTree<Data>::write(Sink&& sink, const SourceNode* root) {
+  /// zeroed whole, the padding up to the alignment is written as well
+  Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.valueSize = sizeof(value_type);
+  header.nodeSize = sizeof(node_type);
+  header.count = snapshot::count(root);
+  snapshot::Writer writer(sink);
+  if (!writer.write(&header, sizeof(header))) {
+    return false;
+  }
+  std::vector<const SourceNode*> queue;
+  queue.reserve(header.count);
+  if (root) {
+    queue.push_back(root);
+  }
+  for (std::size_t i = 0; i < queue.size(); i++) {
+    const auto* source = queue[i];
+    node_type node{};
+    node.value_ = source->value();
+    for (std::size_t c = 0; c < 2; c++) {
+      if (const auto* child = source->childs()[c]) {
+        const auto distance = queue.size() - i;
+        if (distance > std::numeric_limits<std::int32_t>::max()) {
+          return false;
+        }
+        node.childs_[c] = static_cast<std::int32_t>(distance);
+        queue.push_back(child);
+      }
+    }
+    if (!writer.write(&node, sizeof(node))) {
+      return false;
+    }
+  }
+  return writer.finish();
+}
+
+template <typename Data>
+bool MappedTree<Data>::open(const char* path) {
+  this->close();
+  const auto fd = ::open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st{};
+  void* image = MAP_FAILED;
+  const auto bytes = ::fstat(fd, &st) == 0 ?
+      static_cast<std::size_t>(st.st_size) :
+      0;
+  if (bytes >= sizeof(Header)) {
+    image = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (image == MAP_FAILED) {
+    return false;
+  }
+  const auto* header = static_cast<const Header*>(image);
+  if (header->magic != MAGIC ||
+      header->version != VERSION ||
+      header->valueSize != sizeof(value_type) ||
+      header->nodeSize != sizeof(node_type) ||
+      header->count > (bytes - sizeof(Header)) / sizeof(node_type) ||
+      bytes != sizeof(Header) + header->count * sizeof(node_type) +
+          sizeof(std::uint64_t)) {
+    ::munmap(image, bytes);
+    return false;
+  }
+  this->image_ = image;
+  this->bytes_ = bytes;
+  this->nodes_ = reinterpret_cast<const node_type*>(header + 1);
+  this->size_ = header->count;
+  return true;
+}
+
+template <typename Data>
+void MappedTree<Data>::close() {
+  if (this->image_) {
+    ::munmap(const_cast<void*>(this->image_), this->bytes_);
+  }
+  this->image_ = nullptr;
+  this->bytes_ = 0;
+  this->nodes_ = nullptr;
+  this->size_ = 0;
+}
+
+template <typename Data>
+bool MappedTree<Data>::verify() const {
+  if (!this->image_) {
+    return false;
+  }
+  for (std::size_t i = 0; i < this->size_; i++) {
+    for (std::size_t c = 0; c < 2; c++) {
+      if (this->nodes_[i].childs_[c] &&
+          !this->child(this->nodes_ + i, c)) {
+        return false;
+      }
+    }
+  }
+  const auto payload = this->bytes_ - sizeof(std::uint64_t);
+  snapshot::Checksum checksum;
+  checksum.update(static_cast<const char*>(this->image_), payload);
+  std::uint64_t sum = 0;
+  std::memcpy(&sum, static_cast<const char*>(this->image_) + payload, 8);
+  return sum == checksum.value();
+}
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::node_type*
+MappedTree<Data>::root() const {
+  return this->size_ ? this->nodes_ : nullptr;
+}
+
+template <typename Data>
+constexpr std::size_t MappedTree<Data>::size() const {
+  return this->size_;
+}
+
+template <typename Data>
+constexpr const typename MappedTree<Data>::node_type*
+MappedTree<Data>::find(const value_type& val) const {
+  const auto* it = this->root();
+  while (it) {
+    if (val < it->value()) {
+      it = this->child(it, 0);
+    } else if (it->value() < val) {
+      it = this->child(it, 1);
+    } else {
+      return it;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Data>
+template <typename F>
+void MappedTree<Data>::inorder(F&& f) const {
+  std::vector<const node_type*> stack;
+  for (const auto* it = this->root(); it || !stack.empty();) {
+    if (it) {
+      stack.push_back(it);
+      it = this->child(it, 0);
+      continue;
+    }
+    it = stack.back();
+    stack.pop_back();
+    f(it->value());
+    it = this->child(it, 1);
+  }
+}
+
+/*!
+ * @note childs only ever lie further in the image, a distance back or past
+ *       the last node is corrupt and taken as no child, which also rules
+ *       out cycles
+ */
+template <typename Data>
+constexpr const typename MappedTree<Data>::node_type*
+MappedTree<Data>::child(const node_type* node, std::size_t i) const {
+  const auto distance = node->childs_[i];
+  const auto left =
+      this->size_ - static_cast<std::size_t>(node - this->nodes_);
+  if (distance <= 0 || static_cast<std::uint64_t>(distance) >= left) {
+    return nullptr;
+  }
+  return node + distance;
+}
+
+template <typename Data>
+MappedTree<Data>::~MappedTree() {
+  this->close();
+}
+
+} /// namespace sal
+
+#endif /// SAL_MAPPED_TREE_HH_
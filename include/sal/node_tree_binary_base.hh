@@ -16,9 +16,9 @@ public:
   constexpr NodeTreeBinaryBase& operator=(const NodeTreeBinaryBase&) = default;
   constexpr NodeTreeBinaryBase(NodeTreeBinaryBase&&) = default;
   constexpr NodeTreeBinaryBase& operator=(NodeTreeBinaryBase&&) = default;
-  constexpr const NodeType<T>*& left() const;
+  constexpr NodeType<T>* const & left() const;
   constexpr NodeType<T>*& left();
-  constexpr const NodeType<T>*& right() const;
+  constexpr NodeType<T>* const & right() const;
   constexpr NodeType<T>*& right();
   constexpr virtual ~NodeTreeBinaryBase() = default;
 protected:
@@ -35,7 +35,7 @@ constexpr NodeTreeBinaryBase<NodeType, T>::NodeTreeBinaryBase(
 ) : NodeTreeBase<NodeType, T, 2>(value) {}
 
 template <template <typename> class NodeType, NodeValue T>
-constexpr const typename NodeTreeBinaryBase<NodeType, T>::node_type*&
+constexpr typename NodeTreeBinaryBase<NodeType, T>::node_type* const &
 NodeTreeBinaryBase<NodeType, T>::left() const {
   return this->childs_[0];
 }
@@ -47,7 +47,7 @@ NodeTreeBinaryBase<NodeType, T>::left() {
 }
 
 template <template <typename> class NodeType, NodeValue T>
-constexpr const typename NodeTreeBinaryBase<NodeType, T>::node_type*&
+constexpr typename NodeTreeBinaryBase<NodeType, T>::node_type* const &
 NodeTreeBinaryBase<NodeType, T>::right() const {
   return this->childs_[1];
 }
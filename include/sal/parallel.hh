@@ -0,0 +1,707 @@
+#ifndef SAL_PARALLEL_HH_
+#define SAL_PARALLEL_HH_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <sal/aa_tree.hh>
+#include <sal/bs_tree.hh>
+#include <sal/rb_tree.hh>
+#include <sal/thread_pool.hh>
+#include <sal/tree.hh>
+
+namespace sal {
+
+/*!
+ * @brief algorithms on the threads of a ThreadPool, splitting their work
+ *        in halves down to GRAIN values
+ */
+namespace parallel {
+
+constexpr std::size_t GRAIN = 1 << 14;
+
+/*!
+ * @brief merge sort, the halves sorted in parallel and merged in parallel
+ *        by splitting the larger one at its middle value
+ */
+template <typename T>
+void sort(ThreadPool&, std::vector<T>&);
+
+/*!
+ * @brief removes the repeated values of a sorted vector
+ */
+template <typename T>
+void unique(ThreadPool&, std::vector<T>&);
+
+/*!
+ * @brief balanced tree of n sorted values, shaped as by snapshot::load and
+ *        shaped by init the same way, its subtrees built in parallel
+ */
+template <typename Node, typename T, typename Init>
+Node* build(ThreadPool&, const T* values, std::size_t n, Init init);
+
+/*!
+ * @brief calls f on the value of every node of the subtree, in no order and
+ *        from several threads at once
+ */
+template <typename Node, typename F>
+void forEach(ThreadPool&, Node* root, F f);
+
+/*!
+ * @brief folds the values of the subtree in order with op, associative and
+ *        init its identity, the subtrees folded in parallel
+ */
+template <typename T, typename Node, typename Op>
+T reduce(ThreadPool&, const Node* root, T init, Op op);
+
+/*!
+ * @brief deep copy of the subtree, copy(to, from, parent) setting what a
+ *        node keeps besides its value and childs, the subtrees copied in
+ *        parallel
+ */
+template <typename Node, typename Copy>
+Node* clone(ThreadPool&, const Node* root, Copy copy);
+
+/*!
+ * @brief values of the subtree in order, its subtrees flattened in parallel
+ */
+template <typename T, typename Node>
+std::vector<T> flatten(ThreadPool&, const Node* root);
+
+/*!
+ * @brief values of the sorted and distinct a or b, in order, see combine
+ */
+template <typename T>
+std::vector<T> setUnion(ThreadPool&, const std::vector<T>& a,
+    const std::vector<T>& b, std::size_t grain = GRAIN);
+
+/*!
+ * @brief values of the sorted and distinct a and b, in order, see combine
+ */
+template <typename T>
+std::vector<T> setIntersection(ThreadPool&, const std::vector<T>& a,
+    const std::vector<T>& b, std::size_t grain = GRAIN);
+
+/*!
+ * @brief values of the sorted and distinct a not in b, in order, see
+ *        combine
+ */
+template <typename T>
+std::vector<T> setDifference(ThreadPool&, const std::vector<T>& a,
+    const std::vector<T>& b, std::size_t grain = GRAIN);
+
+} /// namespace parallel
+
+} /// namespace sal
+
+namespace sal {
+
+namespace parallel {
+
+/*!
+ * @brief merges the sorted [a, a + na) and [b, b + nb) into out
+ */
+template <typename T>
+void merge(
+    ThreadPool& pool,
+    T* a,
+    std::size_t na,
+    T* b,
+    std::size_t nb,
+    T* out
+) {
+  if (na < nb) {
+    std::swap(a, b);
+    std::swap(na, nb);
+  }
+  if (na + nb <= GRAIN || !nb) {
+    std::merge(
+        std::make_move_iterator(a),
+        std::make_move_iterator(a + na),
+        std::make_move_iterator(b),
+        std::make_move_iterator(b + nb),
+        out
+    );
+    return;
+  }
+  const auto ma = na / 2;
+  const auto mb = static_cast<std::size_t>(
+      std::lower_bound(b, b + nb, a[ma]) - b
+  );
+  out[ma + mb] = std::move(a[ma]);
+  pool.invoke(
+      [&] { merge(pool, a, ma, b, mb, out); },
+      [&] {
+        merge(pool, a + ma + 1, na - ma - 1, b + mb, nb - mb,
+            out + ma + mb + 1);
+      }
+  );
+}
+
+/*!
+ * @brief sorts [a, a + n) into a, or into b when into is set, b being as
+ *        large and free to overwrite
+ */
+template <typename T>
+void sort(ThreadPool& pool, T* a, T* b, std::size_t n, bool into) {
+  if (n <= GRAIN) {
+    std::sort(a, a + n);
+    if (into) {
+      std::move(a, a + n, b);
+    }
+    return;
+  }
+  const auto half = n / 2;
+  pool.invoke(
+      [&] { sort(pool, a + half, b + half, n - half, !into); },
+      [&] { sort(pool, a, b, half, !into); }
+  );
+  auto* from = into ? a : b;
+  merge(pool, from, half, from + half, n - half, into ? b : a);
+}
+
+template <typename T>
+void sort(ThreadPool& pool, std::vector<T>& values) {
+  if (pool.threads() == 1 || values.size() <= GRAIN) {
+    std::sort(values.begin(), values.end());
+    return;
+  }
+  std::vector<T> buffer(values.size());
+  sort(pool, values.data(), buffer.data(), values.size(), false);
+}
+
+/*!
+ * @note the values kept are marked and counted by range before any is
+ *       moved, then moved to their offset
+ */
+template <typename T>
+void unique(ThreadPool& pool, std::vector<T>& values) {
+  const auto n = values.size();
+  if (pool.threads() == 1 || n <= GRAIN) {
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return;
+  }
+  const auto ranges = (n + GRAIN - 1) / GRAIN;
+  std::vector<char> kept(n);
+  std::vector<std::size_t> offsets(ranges + 1, 0);
+  pool.parallelFor(ranges, 1, [&](std::size_t first, std::size_t last) {
+    for (auto r = first; r < last; r++) {
+      for (auto i = r * GRAIN; i < std::min(n, (r + 1) * GRAIN); i++) {
+        kept[i] = !i || values[i - 1] < values[i];
+        offsets[r + 1] += kept[i];
+      }
+    }
+  });
+  for (std::size_t r = 0; r < ranges; r++) {
+    offsets[r + 1] += offsets[r];
+  }
+  std::vector<T> out(offsets[ranges]);
+  pool.parallelFor(ranges, 1, [&](std::size_t first, std::size_t last) {
+    for (auto r = first; r < last; r++) {
+      auto at = offsets[r];
+      for (auto i = r * GRAIN; i < std::min(n, (r + 1) * GRAIN); i++) {
+        if (kept[i]) {
+          out[at++] = std::move(values[i]);
+        }
+      }
+    }
+  });
+  values.swap(out);
+}
+
+/*!
+ * @brief subtree of n values, see snapshot::Builder::build
+ */
+template <typename Node, typename T, typename Init>
+Node* build(
+    ThreadPool& pool,
+    const T* values,
+    std::size_t n,
+    Init& init,
+    Node* parent,
+    std::size_t parentLevel
+) {
+  if (!n) {
+    return nullptr;
+  }
+  const std::size_t level = std::bit_width(n - n / 2) - 1;
+  const auto left = (n - 1) / 2;
+  auto* node = new Node();
+  init(*node, parent, level, parent && level == parentLevel);
+  node->value() = values[left];
+  const auto lower = [&] {
+    node->left() = build<Node>(pool, values, left, init, node, level);
+  };
+  const auto upper = [&] {
+    node->right() = build<Node>(pool, values + left + 1, n - 1 - left, init,
+        node, level);
+  };
+  if (n > GRAIN) {
+    pool.invoke(upper, lower);
+  } else {
+    lower();
+    upper();
+  }
+  return node;
+}
+
+template <typename Node, typename T, typename Init>
+Node* build(ThreadPool& pool, const T* values, std::size_t n, Init init) {
+  return build<Node>(pool, values, n, init, nullptr, 0);
+}
+
+/*!
+ * @brief levels of a tree forked by a traversal, enough subtrees for every
+ *        thread to steal from when they differ in size, none for one thread
+ */
+inline std::size_t forks(const ThreadPool& pool) {
+  const auto threads = pool.threads();
+  return threads > 1 ? std::bit_width(threads) + 3 : 0;
+}
+
+template <typename Node, typename F>
+void forEach(ThreadPool& pool, Node* node, F& f, std::size_t depth) {
+  if (!node) {
+    return;
+  }
+  if (!depth) {
+    std::vector<Node*> stack{node};
+    while (!stack.empty()) {
+      auto* it = stack.back();
+      stack.pop_back();
+      f(it->value());
+      for (auto* child : {it->right(), it->left()}) {
+        if (child) {
+          stack.push_back(child);
+        }
+      }
+    }
+    return;
+  }
+  pool.invoke(
+      [&] { forEach(pool, node->right(), f, depth - 1); },
+      [&] {
+        f(node->value());
+        forEach(pool, node->left(), f, depth - 1);
+      }
+  );
+}
+
+template <typename Node, typename F>
+void forEach(ThreadPool& pool, Node* root, F f) {
+  forEach(pool, root, f, forks(pool));
+}
+
+template <typename T, typename Node, typename Op>
+T reduce(
+    ThreadPool& pool,
+    const Node* node,
+    const T& init,
+    Op& op,
+    std::size_t depth
+) {
+  if (!node) {
+    return init;
+  }
+  if (!depth) {
+    auto ret = init;
+    std::vector<const Node*> stack;
+    for (auto* it = node; it || !stack.empty(); it = it->right()) {
+      for (; it; it = it->left()) {
+        stack.push_back(it);
+      }
+      it = stack.back();
+      stack.pop_back();
+      ret = op(std::move(ret), it->value());
+    }
+    return ret;
+  }
+  auto left = init;
+  auto right = init;
+  pool.invoke(
+      [&] { right = reduce(pool, node->right(), init, op, depth - 1); },
+      [&] { left = reduce(pool, node->left(), init, op, depth - 1); }
+  );
+  return op(op(std::move(left), node->value()), std::move(right));
+}
+
+template <typename T, typename Node, typename Op>
+T reduce(ThreadPool& pool, const Node* root, T init, Op op) {
+  return reduce(pool, root, init, op, forks(pool));
+}
+
+template <typename Node, typename Copy>
+Node* clone(
+    ThreadPool& pool,
+    const Node* from,
+    Copy& copy,
+    Node* parent,
+    std::size_t depth
+) {
+  if (!from) {
+    return nullptr;
+  }
+  auto* node = new Node();
+  node->value() = from->value();
+  copy(*node, *from, parent);
+  const auto lower = [&] {
+    node->left() = clone(pool, from->left(), copy, node,
+        depth ? depth - 1 : 0);
+  };
+  const auto upper = [&] {
+    node->right() = clone(pool, from->right(), copy, node,
+        depth ? depth - 1 : 0);
+  };
+  if (depth) {
+    pool.invoke(upper, lower);
+  } else {
+    lower();
+    upper();
+  }
+  return node;
+}
+
+template <typename Node, typename Copy>
+Node* clone(ThreadPool& pool, const Node* root, Copy copy) {
+  return clone(pool, root, copy, static_cast<Node*>(nullptr), forks(pool));
+}
+
+/*!
+ * @brief moves the parts, in order, into one vector, each to its offset
+ */
+template <typename T>
+std::vector<T> concat(ThreadPool& pool, std::vector<std::vector<T>>& parts) {
+  if (parts.size() == 1) {
+    return std::move(parts[0]);
+  }
+  std::vector<std::size_t> offsets(parts.size() + 1, 0);
+  for (std::size_t i = 0; i < parts.size(); i++) {
+    offsets[i + 1] = offsets[i] + parts[i].size();
+  }
+  std::vector<T> ret(offsets.back());
+  pool.parallelFor(parts.size(), 1, [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; i++) {
+      std::move(parts[i].begin(), parts[i].end(), ret.begin() + offsets[i]);
+      std::vector<T>().swap(parts[i]);
+    }
+  });
+  return ret;
+}
+
+/*!
+ * @brief subtrees below the forked levels and the nodes above them, in
+ *        order, the latter alone
+ */
+template <typename Node>
+void pieces(
+    const Node* node,
+    std::size_t depth,
+    std::vector<std::pair<const Node*, bool>>& out
+) {
+  if (!node) {
+    return;
+  }
+  if (!depth) {
+    out.emplace_back(node, false);
+    return;
+  }
+  pieces(node->left(), depth - 1, out);
+  out.emplace_back(node, true);
+  pieces(node->right(), depth - 1, out);
+}
+
+template <typename T, typename Node>
+std::vector<T> flatten(ThreadPool& pool, const Node* root) {
+  std::vector<std::pair<const Node*, bool>> subtrees;
+  pieces(root, forks(pool), subtrees);
+  std::vector<std::vector<T>> parts(subtrees.size());
+  pool.parallelFor(parts.size(), 1, [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; i++) {
+      const auto [node, alone] = subtrees[i];
+      auto& part = parts[i];
+      if (alone) {
+        part.push_back(node->value());
+        continue;
+      }
+      std::vector<const Node*> stack;
+      for (auto* it = node; it || !stack.empty(); it = it->right()) {
+        for (; it; it = it->left()) {
+          stack.push_back(it);
+        }
+        it = stack.back();
+        stack.pop_back();
+        part.push_back(it->value());
+      }
+    }
+  });
+  if (parts.empty()) {
+    return {};
+  }
+  return concat(pool, parts);
+}
+
+/*!
+ * @brief ranges of the sorted and distinct a and b of about grain values,
+ *        split at the middle value of the larger one, a value found in
+ *        both landing in the same range
+ */
+template <typename T>
+void split(
+    const T* a,
+    std::size_t na,
+    const T* b,
+    std::size_t nb,
+    std::size_t grain,
+    std::vector<std::pair<std::size_t, std::size_t>>& bounds
+) {
+  if (na + nb <= grain) {
+    bounds.emplace_back(na, nb);
+    return;
+  }
+  std::size_t ma = 0;
+  std::size_t mb = 0;
+  if (na >= nb) {
+    ma = na / 2;
+    mb = std::lower_bound(b, b + nb, a[ma]) - b;
+  } else {
+    mb = nb / 2;
+    ma = std::lower_bound(a, a + na, b[mb]) - a;
+  }
+  split(a, ma, b, mb, grain, bounds);
+  split(a + ma, na - ma, b + mb, nb - mb, grain, bounds);
+}
+
+/*!
+ * @brief op(first1, last1, first2, last2, out) of <algorithm> run on the
+ *        ranges of a and b split by split(), in parallel, then concatenated
+ *
+ * a and b are split by one another like trees by the split and join set
+ * algorithms, but flattened: joining the results back is then build() of
+ * a balanced tree in O(n)
+ */
+template <typename T, typename Op>
+std::vector<T> combine(
+    ThreadPool& pool,
+    const std::vector<T>& a,
+    const std::vector<T>& b,
+    std::size_t grain,
+    Op op
+) {
+  std::vector<std::pair<std::size_t, std::size_t>> bounds;
+  split(a.data(), a.size(), b.data(), b.size(), std::max<std::size_t>(grain, 2),
+      bounds);
+  std::vector<std::pair<std::size_t, std::size_t>> starts(bounds.size());
+  for (std::size_t i = 1; i < bounds.size(); i++) {
+    starts[i] = {
+        starts[i - 1].first + bounds[i - 1].first,
+        starts[i - 1].second + bounds[i - 1].second
+    };
+  }
+  std::vector<std::vector<T>> parts(bounds.size());
+  pool.parallelFor(parts.size(), 1, [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; i++) {
+      const auto* ia = a.data() + starts[i].first;
+      const auto* ib = b.data() + starts[i].second;
+      op(ia, ia + bounds[i].first, ib, ib + bounds[i].second,
+          std::back_inserter(parts[i]));
+    }
+  });
+  return concat(pool, parts);
+}
+
+template <typename T>
+std::vector<T> setUnion(
+    ThreadPool& pool,
+    const std::vector<T>& a,
+    const std::vector<T>& b,
+    std::size_t grain
+) {
+  return combine(pool, a, b, grain, [](auto... args) {
+    std::set_union(args...);
+  });
+}
+
+template <typename T>
+std::vector<T> setIntersection(
+    ThreadPool& pool,
+    const std::vector<T>& a,
+    const std::vector<T>& b,
+    std::size_t grain
+) {
+  return combine(pool, a, b, grain, [](auto... args) {
+    std::set_intersection(args...);
+  });
+}
+
+template <typename T>
+std::vector<T> setDifference(
+    ThreadPool& pool,
+    const std::vector<T>& a,
+    const std::vector<T>& b,
+    std::size_t grain
+) {
+  return combine(pool, a, b, grain, [](auto... args) {
+    std::set_difference(args...);
+  });
+}
+
+} /// namespace parallel
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+Tree<Data, Algorithm> Tree<Data, Algorithm>::parallelUnion(
+    const Tree& other,
+    ThreadPool& pool,
+    std::size_t grain
+) const {
+  return this->combine(other, pool, grain, [](auto&&... args) {
+    return parallel::setUnion(args...);
+  });
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+Tree<Data, Algorithm> Tree<Data, Algorithm>::parallelIntersection(
+    const Tree& other,
+    ThreadPool& pool,
+    std::size_t grain
+) const {
+  return this->combine(other, pool, grain, [](auto&&... args) {
+    return parallel::setIntersection(args...);
+  });
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+Tree<Data, Algorithm> Tree<Data, Algorithm>::parallelDifference(
+    const Tree& other,
+    ThreadPool& pool,
+    std::size_t grain
+) const {
+  return this->combine(other, pool, grain, [](auto&&... args) {
+    return parallel::setDifference(args...);
+  });
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+template <typename Op>
+Tree<Data, Algorithm> Tree<Data, Algorithm>::combine(
+    const Tree& other,
+    ThreadPool& pool,
+    std::size_t grain,
+    Op op
+) const {
+  std::vector<data_type> a;
+  std::vector<data_type> b;
+  pool.invoke(
+      [&] { b = parallel::flatten<data_type>(pool, other.algo_.root()); },
+      [&] { a = parallel::flatten<data_type>(pool, this->algo_.root()); }
+  );
+  Tree ret;
+  ret.size_ = ret.algo_.build(
+      op(pool, a, b, grain ? grain : parallel::GRAIN),
+      pool,
+      true
+  );
+  return ret;
+}
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+std::size_t AATree<Data>::build(
+    std::vector<value_type> values,
+    ThreadPool& pool,
+    bool sorted
+) {
+  delete std::exchange(this->root(), nullptr);
+  this->sequence_ = 0;
+  if (!sorted) {
+    parallel::sort(pool, values);
+    parallel::unique(pool, values);
+  }
+  this->root() = parallel::build<node_type>(
+      pool,
+      values.data(),
+      values.size(),
+      &AATree::init
+  );
+  return values.size();
+}
+
+template <typename Data>
+std::size_t RBTree<Data>::build(
+    std::vector<value_type> values,
+    ThreadPool& pool,
+    bool sorted
+) {
+  delete std::exchange(this->root(), nullptr);
+  this->sequence_ = 0;
+  if (!sorted) {
+    parallel::sort(pool, values);
+    parallel::unique(pool, values);
+  }
+  this->root() = parallel::build<node_type>(
+      pool,
+      values.data(),
+      values.size(),
+      &RBTree::init
+  );
+  return values.size();
+}
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+void AATree<Data>::assign(const AATree& other, ThreadPool& pool) {
+  if (this == &other) {
+    return;
+  }
+  delete std::exchange(this->root(), nullptr);
+  this->root() = parallel::clone(pool, other.root(), &AATree::copy);
+  this->sequence_ = other.sequence_;
+}
+
+template <typename Data>
+void BSTree<Data>::assign(const BSTree& other, ThreadPool& pool) {
+  if (this == &other) {
+    return;
+  }
+  delete std::exchange(this->root(), nullptr);
+  this->root() = parallel::clone(
+      pool,
+      other.root(),
+      [](node_type& n, const node_type&, node_type* parent) {
+        n.parent() = parent;
+      }
+  );
+  this->size_ = other.size_;
+  this->factor_ = other.factor_;
+}
+
+template <typename Data>
+void RBTree<Data>::assign(const RBTree& other, ThreadPool& pool) {
+  if (this == &other) {
+    return;
+  }
+  delete std::exchange(this->root(), nullptr);
+  this->root() = parallel::clone(pool, other.root(), &RBTree::copy);
+  this->sequence_ = other.sequence_;
+}
+
+} /// namespace sal
+
+#endif /// SAL_PARALLEL_HH_
@@ -0,0 +1,222 @@
+#ifndef SAL_RB_ALGORITHM_HH_
+#define SAL_RB_ALGORITHM_HH_
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sal {
+
+/*!
+ * @brief red black rebalancing on bare nodes, shared by the owning RBTree
+ *        and the intrusive one
+ *
+ * a node provides childs() (left at 0, right at 1), left(), right(),
+ * parent() and color(), whose type has BLACK and RED enumerators, and may
+ * provide dirty(), see touch(); root is the slot holding the root of the
+ * tree, updated whenever it changes
+ */
+namespace rb {
+
+template <typename Node>
+using color_type =
+    std::remove_cvref_t<decltype(std::declval<Node&>().color())>;
+
+template <typename Node>
+constexpr bool red(const Node* n) {
+  return n && n->color() == color_type<Node>::RED;
+}
+
+/*!
+ * @brief slot of the parent (or root) holding n
+ */
+template <typename Node>
+constexpr Node*& slot(Node*& root, Node* n) {
+  auto* p = n->parent();
+  return p ? p->childs()[n == p->right() ? 1 : 0] : root;
+}
+
+/*!
+ * @brief marks n and its ancestors changed, for nodes with a dirty() flag;
+ *        a marked node has its ancestors marked, so the walk stops at the
+ *        first one
+ */
+template <typename Node>
+constexpr void touch(Node* n) {
+  if constexpr (requires { n->dirty(); }) {
+    for (; n && !n->dirty(); n = n->parent()) {
+      n->dirty() = true;
+    }
+  }
+}
+
+/*!
+ * @brief rotates n down towards dir, its child on the other side takes its
+ *        place
+ * @return the node now in the place of n
+ */
+template <typename Node>
+constexpr Node* rotate(Node*& root, Node* n, std::size_t dir) {
+  auto*& place = slot(root, n);
+  auto* g = n->parent();
+  auto* s = n->childs()[1 - dir];
+  auto* c = s->childs()[dir];
+  n->childs()[1 - dir] = c;
+  if (c) {
+    c->parent() = n;
+  }
+  s->childs()[dir] = n;
+  n->parent() = s;
+  s->parent() = g;
+  place = s;
+  touch(n);
+  touch(s);
+  return s;
+}
+
+/*!
+ * @brief restores the invariants after the red leaf n has been linked
+ */
+template <typename Node>
+constexpr void fixInsert(Node*& root, Node* n) {
+  using Color = color_type<Node>;
+  while (auto* p = n->parent()) {
+    if (p->color() == Color::BLACK) {
+      break;
+    }
+    auto* g = p->parent();
+    if (!g) {
+      p->color() = Color::BLACK;
+      break;
+    }
+    const std::size_t dir = p == g->left() ? 0 : 1;
+    auto* u = g->childs()[1 - dir];
+    if (red(u)) {
+      p->color() = Color::BLACK;
+      u->color() = Color::BLACK;
+      g->color() = Color::RED;
+      n = g;
+      continue;
+    }
+    if (n == p->childs()[1 - dir]) {
+      rotate(root, p, dir);
+      p = n;
+    }
+    rotate(root, g, 1 - dir);
+    p->color() = Color::BLACK;
+    g->color() = Color::RED;
+    break;
+  }
+  root->color() = Color::BLACK;
+}
+
+/*!
+ * @brief restores the black height after the black node n loses one black,
+ *        n is still linked, so the sibling always exists
+ */
+template <typename Node>
+constexpr void fixRemove(Node*& root, Node* n) {
+  using Color = color_type<Node>;
+  while (auto* p = n->parent()) {
+    const std::size_t dir = n == p->left() ? 0 : 1;
+    auto* s = p->childs()[1 - dir];
+    if (s->color() == Color::RED) {
+      p->color() = Color::RED;
+      s->color() = Color::BLACK;
+      rotate(root, p, dir);
+      s = p->childs()[1 - dir];
+    }
+    auto* near = s->childs()[dir];
+    auto* far = s->childs()[1 - dir];
+    if (!red(near) && !red(far)) {
+      s->color() = Color::RED;
+      if (p->color() == Color::RED) {
+        p->color() = Color::BLACK;
+        return;
+      }
+      n = p;
+      continue;
+    }
+    if (!red(far)) {
+      near->color() = Color::BLACK;
+      s->color() = Color::RED;
+      rotate(root, s, 1 - dir);
+      far = s;
+      s = near;
+    }
+    s->color() = p->color();
+    p->color() = Color::BLACK;
+    far->color() = Color::BLACK;
+    rotate(root, p, dir);
+    return;
+  }
+}
+
+/*!
+ * @brief swaps the tree positions and colors of n and its successor s, the
+ *        leftmost node of the right subtree of n
+ */
+template <typename Node>
+constexpr void swapSuccessor(Node*& root, Node* n, Node* s) {
+  auto*& place = slot(root, n);
+  auto* l = n->left();
+  auto* sr = s->right();
+  s->left() = l;
+  l->parent() = s;
+  if (s == n->right()) {
+    s->parent() = n->parent();
+    s->right() = n;
+    n->parent() = s;
+  } else {
+    auto* sp = s->parent();
+    s->parent() = n->parent();
+    s->right() = n->right();
+    s->right()->parent() = s;
+    sp->left() = n;
+    n->parent() = sp;
+  }
+  place = s;
+  n->left() = nullptr;
+  n->right() = sr;
+  if (sr) {
+    sr->parent() = n;
+  }
+  std::swap(n->color(), s->color());
+}
+
+/*!
+ * @brief unlinks n and rebalances, nodes are relinked rather than having
+ *        their values moved, n leaves with all its links cleared
+ */
+template <typename Node>
+constexpr void erase(Node*& root, Node* n) {
+  using Color = color_type<Node>;
+  if (n->left() && n->right()) {
+    auto* s = n->right();
+    while (s->left()) {
+      s = s->left();
+    }
+    swapSuccessor(root, n, s);
+  }
+  if (auto* child = n->left() ? n->left() : n->right()) {
+    /// a lone child is a red leaf under a black node
+    slot(root, n) = child;
+    child->parent() = n->parent();
+    child->color() = Color::BLACK;
+  } else {
+    /// rotations keep n as the child of its parent on the same side
+    if (n->color() == Color::BLACK) {
+      fixRemove(root, n);
+    }
+    slot(root, n) = nullptr;
+  }
+  n->left() = nullptr;
+  n->right() = nullptr;
+  n->parent() = nullptr;
+}
+
+} /// namespace rb
+
+} /// namespace sal
+
+#endif /// SAL_RB_ALGORITHM_HH_
@@ -3,13 +3,20 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <functional>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include <sal/node_tree_binary_base.hh>
+#include <sal/rb_algorithm.hh>
 
 namespace sal {
 
+class ThreadPool;
+namespace snapshot {
+enum class Encoding : std::uint32_t;
+} /// namespace snapshot
+
 template <typename Data>
 class RBTree {
 public:
@@ -43,9 +50,16 @@ public:
     constexpr Color& color();
     constexpr const parent_type& parent() const;
     constexpr parent_type& parent();
+    /*!
+     * @brief whether the values of the subtree changed since the last
+     *        checkpoint, marked up to the root
+     */
+    constexpr const bool& dirty() const;
+    constexpr bool& dirty();
     constexpr virtual ~Node() = default;
   protected:
     Color color_ = Color::RED;
+    bool dirty_ = true;
     parent_type parent_ = nullptr;
   private:
   };
@@ -63,8 +77,63 @@ public:
   constexpr Node<Data>* remove(value_type&&);
   constexpr Node<Data>* find(const value_type&) const;
   constexpr Node<Data>* find(value_type&&) const;
+  /*!
+   * @brief writes the values in order to a std::ostream or a file
+   *        descriptor, Encoding::PACKED compresses integers, the default
+   *        is Encoding::RAW
+   * @note defined in snapshot.hh, as is load()
+   */
+  template <typename Sink>
+  bool save(Sink&&, snapshot::Encoding = snapshot::Encoding{}) const;
+  /*!
+   * @brief replaces the values with those of a snapshot, built balanced in
+   *        O(n) from a std::istream or a file descriptor
+   * @return false, leaving the tree empty, for an unusable snapshot
+   */
+  template <typename Source>
+  bool load(Source&&);
+  /*!
+   * @brief replaces the values with those of values, sorted and deduplicated
+   *        on the threads of pool, then built balanced like by load(), the
+   *        subtrees in parallel
+   * @param sorted values already sorted and distinct, e.g. by a set
+   *        operation, they are not sorted again
+   * @note defined in parallel.hh
+   * @return values in the tree
+   */
+  std::size_t build(std::vector<value_type> values, ThreadPool& pool,
+      bool sorted = false);
+  /*!
+   * @brief replaces the values with a copy of those of other, shaped the
+   *        same, its subtrees copied in parallel on the threads of pool
+   * @note defined in parallel.hh
+   */
+  void assign(const RBTree& other, ThreadPool& pool);
+  /*!
+   * @brief writes the changes since the last checkpoint, load() or clean()
+   *        to a std::ostream or a file descriptor, then forgets them
+   * @note defined in checkpoint.hh, as are apply() and clean()
+   */
+  template <typename Sink>
+  bool checkpoint(Sink&&);
+  /*!
+   * @brief applies the next checkpoint of the tree this one is a copy of,
+   *        recovery is load() of the base then apply() of every checkpoint
+   *        taken since, in order
+   * @return false, leaving the tree as it was, for an unusable checkpoint
+   */
+  template <typename Source>
+  bool apply(Source&&);
+  /*!
+   * @brief forgets the changes, the tree as it is becomes the base of the
+   *        next checkpoints, e.g. once saved
+   */
+  constexpr void clean();
   constexpr virtual ~RBTree();
 protected:
+  constexpr static void adopt(node_type*);
+  constexpr static void init(node_type&, node_type*, std::size_t, bool);
+  constexpr static void copy(node_type&, const node_type&, node_type*);
   constexpr static Node<Data>* successor(Node<Data>*);
   constexpr static Node<Data>* predecessor(Node<Data>*);
   constexpr Node<Data>* insert(Node<Data>*, Node<Data>*&, Node<Data>*);
@@ -75,6 +144,8 @@ protected:
   constexpr Node<Data>* rotate(Node<Data>*&, const Direction&);
   constexpr Node<Data>* fix(Node<Data>*&);
   Node<Data>* root_ = nullptr;
+  /// checkpoints since the base
+  std::uint64_t sequence_ = 0;
 private:
 };
 
@@ -136,39 +207,68 @@ constexpr typename RBTree<Data>::template Node<T>::parent_type&
 RBTree<Data>::Node<T>::parent() { return this->parent_; }
 
 template <typename Data>
-constexpr RBTree<Data>::RBTree(const RBTree& other) {
+template <NodeValue T>
+constexpr const bool& RBTree<Data>::Node<T>::dirty() const {
+  return this->dirty_;
+}
+
+template <typename Data>
+template <NodeValue T>
+constexpr bool& RBTree<Data>::Node<T>::dirty() { return this->dirty_; }
+
+template <typename Data>
+constexpr RBTree<Data>::RBTree(const RBTree& other)
+  : sequence_(other.sequence_) {
   if (other.root()) {
     this->root() = new Node(*other.root());
+    adopt(this->root());
   }
 }
 
 template <typename Data>
 constexpr RBTree<Data>& RBTree<Data>::operator=(const RBTree& other) {
   if (this != &other) {
+    delete std::exchange(this->root(), nullptr);
     if (other.root()) {
       this->root() = new Node(*other.root());
+      adopt(this->root());
     }
+    this->sequence_ = other.sequence_;
   }
   return *this;
 }
 
+/*!
+ * @note the nodes are taken as they are, a moved node would leave the
+ *       parent links of its childs to the node it was moved from
+ */
 template <typename Data>
-constexpr RBTree<Data>::RBTree(RBTree&& other) {
-  if (other.root()) {
-    this->root() = new Node(std::move(*other.root()));
+constexpr RBTree<Data>::RBTree(RBTree&& other)
+  : root_(std::exchange(other.root_, nullptr)),
+    sequence_(std::exchange(other.sequence_, 0)) {}
+
+template <typename Data>
+constexpr RBTree<Data>& RBTree<Data>::operator=(RBTree&& other) {
+  if (this != &other) {
+    delete std::exchange(this->root(), other.root());
     other.root() = nullptr;
+    this->sequence_ = std::exchange(other.sequence_, 0);
   }
+  return *this;
 }
 
+/*!
+ * @brief points the parent links of the subtree back into it, node copies
+ *        still refer to the parents of the nodes they were copied from
+ */
 template <typename Data>
-constexpr RBTree<Data>& RBTree<Data>::operator=(RBTree&& other) {
-  if (this != &other) {
-    if (other.root()) {
-      this->root() = new Node(std::move(*other.root()));
-      other.root() = nullptr;
+constexpr void RBTree<Data>::adopt(node_type* n) {
+  for (auto* child : n->childs()) {
+    if (child) {
+      child->parent() = n;
+      adopt(child);
     }
   }
-  return *this;
 }
 
 template <typename Data>
@@ -229,6 +329,7 @@ RBTree<Data>::insert(
 ) {
   auto* insertable = new node_type(val);
   this->insert(insertable, node, node ? node->parent() : nullptr);
+  rb::touch(insertable->parent());
   this->fix(insertable);
   this->root()->color() = node_type::Color::BLACK;
   return node;
@@ -305,197 +406,50 @@ RBTree<Data>::find(typename RBTree<Data>::value_type&& val) const {
 
 template <typename Data>
 constexpr typename RBTree<Data>::node_type*
-RBTree<Data>::rotate(typename RBTree<Data>::node_type*& n, const Direction& dir) {
-  typename RBTree<Data>::node_type* g = n->parent();
-  typename RBTree<Data>::node_type* s =
-      n->childs()[dir.inv()];
-  typename RBTree<Data>::node_type* c;
-  c = s->childs()[dir];
-  n->childs()[dir.inv()] = c;
-  if (c) {
-    c->parent() = n;
-  }
-  s->childs()[dir] = n;
-  n->parent() = s;
-  s->parent() = g;
-  if (g) {
-    g->childs()[n == g->right() ? Direction::RIGHT : Direction::LEFT] = s;
-  } else {
-    this->root() = s;
-  }
-  return s;
+RBTree<Data>::rotate(
+    typename RBTree<Data>::node_type*& n,
+    const Direction& dir
+) {
+  return rb::rotate(this->root(), n, dir);
 }
 
 template <typename Data>
 constexpr typename RBTree<Data>::node_type*
 RBTree<Data>::fix(typename RBTree<Data>::node_type*& n) {
-  RBTree<Data>::node_type* p = n->parent(); /// parent
-  if (!p) {
-    this->root() = n;
-    return n;
-  }
-  typename RBTree<Data>::node_type* g; /// grandparent
-  typename RBTree<Data>::node_type* u; /// uncle
-  typename RBTree<Data>::node_type* copy = n;
-  do {
-    if (p->color() == node_type::Color::BLACK) {
-      return n;
-    } else if (!(g = p->parent())) {
-      p->color() = node_type::Color::BLACK;
-      return n;
-    }
-    const Direction dir = (p == g->left()) ? Direction::LEFT : Direction::RIGHT;
-    u = g->childs()[dir.inv()];
-    if (!u || u->color() == node_type::Color::BLACK) {
-      if (copy == (dir == Direction::LEFT ? p->right() : p->left())) {
-        this->rotate(p, dir);
-        copy = p;
-        p = g->childs()[dir];
-      }
-      this->rotate(g, dir.inv());
-      p->color() = node_type::Color::BLACK;
-      g->color() = node_type::Color::RED;
-      return n;
-    }
-    p->color() = node_type::Color::BLACK;
-    u->color() = node_type::Color::BLACK;
-    g->color() = node_type::Color::RED;
-    copy = g;
-  } while ((p = copy->parent()));
+  rb::fixInsert(this->root(), n);
   return n;
 }
 
 template <typename Data>
 constexpr typename RBTree<Data>::node_type*
 RBTree<Data>::remove(typename RBTree<Data>::node_type*& n) {
-  /// ?? static constexpr
-  const std::function<void(typename RBTree<Data>::node_type*&)> case1 =
-      [this, &case1](typename RBTree<Data>::node_type*& n) {
-    const auto case2 =
-        [this, &case1](typename RBTree<Data>::node_type*& n) {
-      const Direction dir = (n == n->parent()->left()) ?
-          Direction::LEFT :
-          Direction::RIGHT;
-      RBTree<Data>::node_type* s = n->parent()->childs()[dir.inv()];
-      const auto case3 =
-          [this, &s, &case1, &dir](typename RBTree<Data>::node_type*& n) {
-        const auto case4 =
-            [this, &s, &dir](typename RBTree<Data>::node_type*& n) {
-          const auto case5 =
-              [this, &s, &dir](typename RBTree<Data>::node_type*& n) {
-            const auto case6 =
-                [this, &s, &dir](typename RBTree<Data>::node_type*& n) {
-              s->color() = n->parent()->color();
-              n->parent()->color() = node_type::Color::BLACK;
-              s->childs()[dir.inv()]->color() = node_type::Color::BLACK;
-              this->rotate(n->parent(), dir);
-            };
-            if (s->color() == node_type::Color::BLACK) {
-              if (
-                  s->childs()[dir] &&
-                  s->childs()[dir]->color() == node_type::Color::RED &&
-                  s->childs()[dir.inv()]->color() == node_type::Color::BLACK
-              ) {
-                s->color() = node_type::Color::RED;
-                s->childs()[dir]->color() = node_type::Color::BLACK;
-                this->rotate(s, dir.inv());
-                s = n->parent()->childs()[dir.inv()];
-              }
-            }
-            case6(n);
-          };
-          if (
-              n->parent()->color() == node_type::Color::RED &&
-              s->color() == node_type::Color::BLACK &&
-              (!s->left() || s->left()->color() == node_type::Color::BLACK) &&
-              (!s->right() || s->right()->color() == node_type::Color::BLACK)
-          ) {
-            s->color() = node_type::Color::RED;
-            n->parent()->color() = node_type::Color::BLACK;
-          } else {
-            case5(n);
-          }
-        };
-        if (
-            n->parent()->color() == node_type::Color::BLACK &&
-            s->color() == node_type::Color::BLACK &&
-            (!s->left() || s->left()->color() == node_type::Color::BLACK) &&
-            (!s->right() || s->right()->color() == node_type::Color::BLACK)
-        ) {
-          s->color() = node_type::Color::RED;
-          case1(n->parent());
-        } else {
-          case4(n);
-        }
-      };
-      if (s->color() == node_type::Color::RED) {
-        n->parent()->color() = node_type::Color::RED;
-        s->color() = node_type::Color::BLACK;
-        this->rotate(n->parent(), dir);
-        s = n->parent()->childs()[dir.inv()];
-      }
-      case3(n);
-    };
-    if (n->parent()) {
-      case2(n);
-    }
-  };
-  const auto withOneChild = [&case1](
-      typename RBTree<Data>::node_type*& n,
-      Direction dir
-  ) {
-    const auto exchange = [&dir](
-      typename RBTree<Data>::node_type*& n
-    ) {
-      auto* copy = n;
-      n = n->childs()[dir];
-      n->parent() = copy->parent();
-      return copy;
-    };
-    auto old = exchange(n);
-    if (old->color() == node_type::Color::BLACK) {
-      if (old->childs()[dir]->color() == node_type::Color::RED) {
-        old->childs()[dir]->color() = node_type::Color::BLACK;
-      } else {
-        case1(old->childs()[dir]);
-      }
-    }
-    old->childs()[dir] = nullptr;
-    delete(old);
-  };
-  if (!n->left() && !n->right()) {
-    if (n->color() == node_type::Color::BLACK) {
-      case1(n);
-    }
-    delete n;
-    n = nullptr;
-
-  } else if (!n->left()) {
-    withOneChild(n, Direction::RIGHT);
-  } else if (!n->right()) {
-    withOneChild(n, Direction::LEFT);
-  } else {
+  if (n->left() && n->right()) {
     auto* successor = this->successor(n);
-    if (successor->parent() == n) {
-      n->value() = successor->value();
-      successor->parent()->right() = successor->right();
-      successor->right() = nullptr;
-      if (successor->color() == node_type::Color::BLACK) {
-        case1(successor);
-      }
-      delete successor;
-      successor = nullptr;
-    } else {
-      n->value() = successor->value();
-      successor->parent()->left() = successor->right();
-      successor->right() = nullptr;
-      if (successor->color() == node_type::Color::BLACK) {
-        case1(successor);
-      }
-      delete successor;
-      successor = nullptr;
+    n->value() = successor->value();
+    rb::touch(n);
+    /// the successor has no left child, so it is removed by the cases below
+    return this->remove(
+        successor == n->right() ? n->right() : successor->parent()->left()
+    );
+  }
+  auto* toBeDeleted = n;
+  if (auto* child = n->left() ? n->left() : n->right()) {
+    /// a lone child is a red leaf under a black node
+    n = child;
+    child->parent() = toBeDeleted->parent();
+    child->color() = node_type::Color::BLACK;
+    rb::touch(child->parent());
+    toBeDeleted->left() = nullptr;
+    toBeDeleted->right() = nullptr;
+  } else {
+    rb::touch(toBeDeleted->parent());
+    /// rotations keep n as the child of its parent on the same side
+    if (toBeDeleted->color() == node_type::Color::BLACK) {
+      rb::fixRemove(this->root(), toBeDeleted);
     }
+    n = nullptr;
   }
+  delete toBeDeleted;
   return nullptr;
 }
 
@@ -506,6 +460,36 @@ constexpr RBTree<Data>::~RBTree() {
   }
 }
 
+/*!
+ * @brief shapes a node built from a snapshot or a checkpoint, see
+ *        snapshot::load
+ */
+template <typename Data>
+constexpr void RBTree<Data>::init(
+    node_type& n,
+    node_type* parent,
+    std::size_t,
+    bool horizontal
+) {
+  n.parent() = parent;
+  n.color() = horizontal ? node_type::Color::RED : node_type::Color::BLACK;
+  n.dirty() = false;
+}
+
+/*!
+ * @brief the rest of a node copied by assign(), see parallel::clone
+ */
+template <typename Data>
+constexpr void RBTree<Data>::copy(
+    node_type& n,
+    const node_type& from,
+    node_type* parent
+) {
+  n.parent() = parent;
+  n.color() = from.color();
+  n.dirty() = from.dirty();
+}
+
 } /// namespace sal
 
 #endif /// SAL_RB_TREE_HH_
@@ -2,11 +2,29 @@
 #define SAL_SAL_HXX_
 
 #include <sal/tree.hh>
+#include <sal/snapshot.hh>
+#include <sal/checkpoint.hh>
+#include <sal/wal.hh>
+#include <sal/lsm_set.hh>
+#include <sal/mapped_tree.hh>
+#include <sal/disk_b_tree.hh>
+#include <sal/buffered_tree.hh>
+#include <sal/thread_pool.hh>
+#include <sal/parallel.hh>
 #include <sal/aa_tree.hh>
+#include <sal/avl_tree.hh>
 #include <sal/rb_tree.hh>
 #include <sal/bs_tree.hh>
+#include <sal/scapegoat_tree.hh>
+#include <sal/splay_tree.hh>
+#include <sal/treap.hh>
 #include <sal/double_linked_list.hh>
 #include <sal/self_organizing_list.hh>
+#include <sal/indexed_linked_list.hh>
+#include <sal/lru_cache.hh>
+#include <sal/unrolled_list.hh>
+#include <sal/intrusive_list.hh>
+#include <sal/intrusive_rb_tree.hh>
 
 namespace sal {
 
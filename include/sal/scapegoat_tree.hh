@@ -0,0 +1,311 @@
+#ifndef SAL_SCAPEGOAT_TREE_HH_
+#define SAL_SCAPEGOAT_TREE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include <sal/xx_tree_base.hh>
+
+namespace sal {
+
+namespace sg {
+
+/*!
+ * @brief bare binary node, neither a parent link nor balance metadata
+ */
+template <NodeValue T>
+class Node : public NodeTreeBinaryBase<Node, T> {
+public:
+  using value_type = T;
+  using node_type = Node<T>;
+  constexpr Node() = default;
+  constexpr Node(value_type v);
+  constexpr Node(const Node&) = default;
+  constexpr Node& operator=(const Node&) = default;
+  constexpr Node(Node&&) = default;
+  constexpr Node& operator=(Node&&) = default;
+  constexpr virtual ~Node() = default;
+protected:
+private:
+};
+
+template <NodeValue T>
+constexpr Node<T>::Node(value_type v) : NodeTreeBinaryBase<Node, T>(v) {}
+
+} /// namespace sg
+
+namespace info {
+
+template <typename Data>
+class ScapegoatTree {
+public:
+  using value_type = Data;
+  using node_type = sg::Node<value_type>;
+};
+
+} /// namespace info
+
+/*!
+ * @brief alpha weight balanced tree without per node metadata, a subtree is
+ *        rebuilt in linear time once an insertion lands deeper than
+ *        log_{1/alpha}(size), the whole tree once removals shrink it below
+ *        alpha * (the largest size since the last full rebuild)
+ */
+template <typename Data>
+class ScapegoatTree :
+    public XXTreeBase<typename info::ScapegoatTree<Data>::node_type> {
+public:
+  using value_type = typename info::ScapegoatTree<Data>::value_type;
+  using node_type = typename info::ScapegoatTree<Data>::node_type;
+  using XXTreeBase<typename info::ScapegoatTree<Data>::node_type>::insert;
+  using XXTreeBase<typename info::ScapegoatTree<Data>::node_type>::remove;
+  using XXTreeBase<typename info::ScapegoatTree<Data>::node_type>::find;
+  using XXTreeBase<typename info::ScapegoatTree<Data>::node_type>::root;
+  static constexpr double ALPHA = 2.0 / 3.0;
+  constexpr ScapegoatTree() = default;
+  constexpr ScapegoatTree(const ScapegoatTree&);
+  constexpr ScapegoatTree& operator=(const ScapegoatTree&);
+  constexpr ScapegoatTree(ScapegoatTree&&);
+  constexpr ScapegoatTree& operator=(ScapegoatTree&&);
+  constexpr std::size_t size() const;
+  constexpr virtual ~ScapegoatTree() = default;
+protected:
+  constexpr static std::size_t count(const node_type*);
+  constexpr static node_type* flatten(node_type*, node_type*);
+  constexpr static node_type* build(std::size_t, node_type*&);
+  constexpr static node_type* rebuild(node_type*, std::size_t);
+  constexpr static node_type* detachMax(node_type*&);
+  constexpr std::size_t bound() const;
+  constexpr std::size_t
+      insert(const value_type&, node_type*&, std::size_t, node_type*&);
+  constexpr node_type*
+      insert(const value_type&, node_type*&, node_type* p = nullptr) override;
+  constexpr node_type*
+      remove(const value_type&, node_type*&) override;
+  constexpr node_type*
+      find(const value_type&, node_type* const &) const override;
+  std::size_t size_ = 0;
+  std::size_t maxSize_ = 0;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+constexpr ScapegoatTree<Data>::ScapegoatTree(const ScapegoatTree& o)
+  : XXTreeBase<node_type>(o), size_(o.size_), maxSize_(o.maxSize_) {}
+
+template <typename Data>
+constexpr ScapegoatTree<Data>&
+ScapegoatTree<Data>::operator=(const ScapegoatTree& o) {
+  if (this != &o) {
+    delete std::exchange(this->root(), nullptr);
+    if (o.root()) {
+      this->root() = new node_type(*o.root());
+    }
+    this->size_ = o.size_;
+    this->maxSize_ = o.maxSize_;
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr ScapegoatTree<Data>::ScapegoatTree(ScapegoatTree&& o)
+  : size_(std::exchange(o.size_, 0)),
+    maxSize_(std::exchange(o.maxSize_, 0)) {
+  this->root() = std::exchange(o.root(), nullptr);
+}
+
+template <typename Data>
+constexpr ScapegoatTree<Data>&
+ScapegoatTree<Data>::operator=(ScapegoatTree&& o) {
+  if (this != &o) {
+    delete std::exchange(this->root(), o.root());
+    o.root() = nullptr;
+    this->size_ = std::exchange(o.size_, 0);
+    this->maxSize_ = std::exchange(o.maxSize_, 0);
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr std::size_t ScapegoatTree<Data>::size() const {
+  return this->size_;
+}
+
+template <typename Data>
+constexpr std::size_t ScapegoatTree<Data>::count(const node_type* n) {
+  return n ? count(n->left()) + count(n->right()) + 1 : 0;
+}
+
+/*!
+ * @brief links the subtree in order through right() in front of head
+ * @return first node of the list
+ */
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::flatten(node_type* n, node_type* head) {
+  if (!n) {
+    return head;
+  }
+  n->right() = flatten(n->right(), head);
+  auto* l = n->left();
+  n->left() = nullptr;
+  return flatten(l, n);
+}
+
+/*!
+ * @brief perfectly balanced tree out of the first size nodes of list,
+ *        list is advanced past them
+ */
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::build(std::size_t size, node_type*& list) {
+  if (!size) {
+    return nullptr;
+  }
+  auto* l = build((size - 1) / 2, list);
+  auto* n = list;
+  list = list->right();
+  n->left() = l;
+  n->right() = build(size / 2, list);
+  return n;
+}
+
+/*!
+ * @note linear time, recursion depth is bounded by the subtree height
+ */
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::rebuild(node_type* n, std::size_t size) {
+  auto* list = flatten(n, nullptr);
+  return build(size, list);
+}
+
+/*!
+ * @note n != nullptr
+ */
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::detachMax(node_type*& n) {
+  if (n->right()) {
+    return detachMax(n->right());
+  }
+  auto* max = n;
+  n = n->left();
+  max->left() = nullptr;
+  return max;
+}
+
+/*!
+ * @brief deepest allowed depth, log_{1/alpha}(size)
+ */
+template <typename Data>
+constexpr std::size_t ScapegoatTree<Data>::bound() const {
+  return static_cast<std::size_t>(
+      std::log(static_cast<double>(this->size_)) / -std::log(ALPHA)
+  );
+}
+
+/*!
+ * @return size of the subtree of n while a scapegoat is still looked for
+ *         on the way up, 0 otherwise
+ */
+template <typename Data>
+constexpr std::size_t ScapegoatTree<Data>::insert(
+    const value_type& v,
+    node_type*& n,
+    std::size_t depth,
+    node_type*& inserted
+) {
+  if (n == nullptr) {
+    inserted = n = new node_type(v);
+    this->size_++;
+    this->maxSize_ = std::max(this->maxSize_, this->size_);
+    return depth > this->bound() ? 1 : 0;
+  }
+  std::size_t size = 0;
+  node_type* sibling = nullptr;
+  if (v < n->value()) {
+    size = this->insert(v, n->left(), depth + 1, inserted);
+    sibling = n->right();
+  } else if (v > n->value()) {
+    size = this->insert(v, n->right(), depth + 1, inserted);
+    sibling = n->left();
+  } else {
+    inserted = nullptr;
+    return 0;
+  }
+  if (!size) {
+    return 0;
+  }
+  const auto total = size + count(sibling) + 1;
+  if (size > ALPHA * total) {
+    n = rebuild(n, total);
+    return 0;
+  }
+  return total;
+}
+
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::insert(const value_type& v, node_type*& n, node_type*) {
+  node_type* inserted = nullptr;
+  this->insert(v, n, 0, inserted);
+  return inserted;
+}
+
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::remove(const value_type& v, node_type*& n) {
+  if (n == nullptr) {
+    return nullptr;
+  } else if (v < n->value()) {
+    return this->remove(v, n->left());
+  } else if (v > n->value()) {
+    return this->remove(v, n->right());
+  }
+  auto* toBeDeleted = n;
+  if (n->left() == nullptr) {
+    n = n->right();
+  } else if (n->right() == nullptr) {
+    n = n->left();
+  } else {
+    auto* predecessor = detachMax(n->left());
+    predecessor->left() = n->left();
+    predecessor->right() = n->right();
+    n = predecessor;
+  }
+  toBeDeleted->left() = nullptr;
+  toBeDeleted->right() = nullptr;
+  delete toBeDeleted;
+  auto* replacement = n;
+  this->size_--;
+  if (this->size_ < ALPHA * this->maxSize_) {
+    this->root() = rebuild(this->root(), this->size_);
+    this->maxSize_ = this->size_;
+  }
+  return replacement;
+}
+
+template <typename Data>
+constexpr typename ScapegoatTree<Data>::node_type*
+ScapegoatTree<Data>::find(const value_type& v, node_type* const & n) const {
+  if (n == nullptr) {
+    return nullptr;
+  } else if (v < n->value()) {
+    return this->find(v, n->left());
+  } else if (v > n->value()) {
+    return this->find(v, n->right());
+  } else {
+    return n;
+  }
+}
+
+} /// namespace sal
+
+#endif /// SAL_SCAPEGOAT_TREE_HH_
@@ -1,19 +1,118 @@
 #ifndef SAL_SELF_ORGANIZING_LIST_HH_
 #define SAL_SELF_ORGANIZING_LIST_HH_
 
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+
 #include <sal/double_linked_list.hh>
 
 namespace sal {
 
-template <typename Data>
+/*!
+ * @brief reorganization policies of SelfOrganizingList
+ *
+ * a policy picks, for a node that has just been found, the node it is to be
+ * moved in front of (nullptr to leave it in place); erase() is called for
+ * every node leaving the list
+ */
+namespace so {
+
+/*!
+ * @brief swaps the found node with its predecessor
+ */
+class Transpose {
+public:
+  template <typename Node>
+  constexpr Node* target(Node* node, Node*) {
+    return node->prev();
+  }
+  template <typename Node>
+  constexpr void erase(const Node*) {}
+};
+
+/*!
+ * @brief moves the found node to the head
+ */
+class MoveToFront {
+public:
+  template <typename Node>
+  constexpr Node* target(Node* node, Node* root) {
+    return node == root ? nullptr : root;
+  }
+  template <typename Node>
+  constexpr void erase(const Node*) {}
+};
+
+/*!
+ * @brief moves the found node K positions towards the head
+ */
+template <std::size_t K>
+class MoveAheadK {
+public:
+  template <typename Node>
+  constexpr Node* target(Node* node, Node*) {
+    Node* ret = nullptr;
+    for (std::size_t i = 0; i < K && node->prev(); i++) {
+      ret = node = node->prev();
+    }
+    return ret;
+  }
+  template <typename Node>
+  constexpr void erase(const Node*) {}
+};
+
+/*!
+ * @brief keeps the list ordered by access counts, the found node moves in
+ *        front of every node accessed less often
+ * @note the counts live beside the nodes, keyed by their address
+ */
+class FrequencyCount {
+public:
+  template <typename Node>
+  Node* target(Node* node, Node*) {
+    const auto count = ++this->counts_[node];
+    Node* ret = nullptr;
+    for (auto* it = node->prev(); it && this->count(it) < count;
+        it = it->prev()) {
+      ret = it;
+    }
+    return ret;
+  }
+  template <typename Node>
+  void erase(const Node* node) {
+    this->counts_.erase(node);
+  }
+protected:
+  std::size_t count(const void* node) const {
+    const auto it = this->counts_.find(node);
+    return it == this->counts_.end() ? 0 : it->second;
+  }
+  std::unordered_map<const void*, std::size_t> counts_;
+private:
+};
+
+} /// namespace so
+
+/*!
+ * @brief list reordering itself on every get(), how is up to the Policy
+ */
+template <typename Data, typename Policy = so::Transpose>
 class SelfOrganizingList : public DoubleLinkedList<Data> {
 public:
   using value_type = Data;
+  using node_type = typename DoubleLinkedList<Data>::template Node<Data>;
+  using DoubleLinkedList<Data>::get;
+  constexpr node_type* get(const value_type&) override;
+  constexpr node_type* get(value_type&&) override;
   virtual ~SelfOrganizingList() = default;
 protected:
   using DoubleLinkedList<Data>::find;
-  constexpr typename DoubleLinkedList<Data>::template Node<value_type>*
-      find(const value_type&);
+  constexpr node_type* find(const value_type&);
+  constexpr bool remove(const value_type&) override;
+  constexpr node_type* extract(node_type*) override;
+  constexpr void detach(node_type*, node_type*) override;
+  Policy policy_;
 private:
 };
 
@@ -21,36 +120,80 @@ private:
 
 namespace sal {
 
-template <typename Data>
-constexpr typename DoubleLinkedList<Data>::template
-Node<typename SelfOrganizingList<Data>::value_type>*
-SelfOrganizingList<Data>::find(
-    const SelfOrganizingList<Data>::value_type& val
+template <typename Data, typename Policy>
+constexpr typename SelfOrganizingList<Data, Policy>::node_type*
+SelfOrganizingList<Data, Policy>::get(
+    const SelfOrganizingList<Data, Policy>::value_type& val
+) {
+  return this->find(val);
+}
+
+template <typename Data, typename Policy>
+constexpr typename SelfOrganizingList<Data, Policy>::node_type*
+SelfOrganizingList<Data, Policy>::get(
+    SelfOrganizingList<Data, Policy>::value_type&& val
+) {
+  return this->find(val);
+}
+
+template <typename Data, typename Policy>
+constexpr typename SelfOrganizingList<Data, Policy>::node_type*
+SelfOrganizingList<Data, Policy>::find(
+    const SelfOrganizingList<Data, Policy>::value_type& val
 ) {
   auto* it = util::as_mutable(std::as_const(*this).find(val));
   if (!it) {
     return nullptr;
   }
-  if (it->prev()) {
-    if (it->next()) {
-      it->next()->prev() = it->prev();
-    }
-    it->prev()->next() = it->next();
-    it->next() = it->prev();
-    it->prev() = it->prev()->prev();
-    if (!it->prev()) {
-      this->root() = it;
-    } else {
-      it->prev()->next() = it;
-    }
-    it->next()->prev() = it;
-    if (!it->next()->next()) {
-      this->last() = it->next();
-    }
+  auto* target = this->policy_.target(it, this->root());
+  if (!target) {
+    return it;
+  }
+  this->unlink(it);
+  it->next() = target;
+  it->prev() = target->prev();
+  if (target->prev()) {
+    target->prev()->next() = it;
+  } else {
+    this->root() = it;
   }
+  target->prev() = it;
   return it;
 }
 
+template <typename Data, typename Policy>
+constexpr bool SelfOrganizingList<Data, Policy>::remove(
+    const SelfOrganizingList<Data, Policy>::value_type& val
+) {
+  auto* it = util::as_mutable(std::as_const(*this).find(val));
+  if (!it) {
+    return false;
+  }
+  this->release(this->extract(it));
+  return true;
+}
+
+template <typename Data, typename Policy>
+constexpr typename SelfOrganizingList<Data, Policy>::node_type*
+SelfOrganizingList<Data, Policy>::extract(node_type* node) {
+  this->policy_.erase(node);
+  return DoubleLinkedList<Data>::extract(node);
+}
+
+template <typename Data, typename Policy>
+constexpr void SelfOrganizingList<Data, Policy>::detach(
+    node_type* first,
+    node_type* last
+) {
+  for (auto* it = first; ; it = it->next()) {
+    this->policy_.erase(it);
+    if (it == last) {
+      break;
+    }
+  }
+  DoubleLinkedList<Data>::detach(first, last);
+}
+
 } /// namespace sal
 
 #endif /// SAL_SELF_ORGANIZING_LIST_HH_
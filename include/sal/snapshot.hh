@@ -0,0 +1,851 @@
+#ifndef SAL_SNAPSHOT_HH_
+#define SAL_SNAPSHOT_HH_
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <sal/aa_tree.hh>
+#include <sal/bs_tree.hh>
+#include <sal/rb_tree.hh>
+#include <sal/tree.hh>
+
+namespace sal {
+
+/*!
+ * @brief binary snapshots of binary search trees
+ *
+ * a snapshot is a header, the values in order and a checksum of both:
+ *
+ *   u64 magic | u32 version | u32 value size | u32 encoding | u32 0 |
+ *   u64 count | values | u64 sum
+ *
+ * integers and raw values are in host byte order; the value size is the
+ * size of a raw value, 0 when values are encoded by their Codec; a tree is
+ * loaded in O(n) by building it balanced straight from the stream, without
+ * any comparison beyond checking the order
+ */
+namespace snapshot {
+
+constexpr std::uint64_t MAGIC = 0x3150414e534c4153; /// "SALSNAP1"
+constexpr std::uint32_t VERSION = 2;
+/// bytes moved per write or read call
+constexpr std::size_t BUFFER_SIZE = 1 << 20;
+
+enum class Encoding : std::uint32_t {
+  /// every value by its Codec
+  RAW = 0,
+  /// integers only, see PackedWriter
+  PACKED = 1,
+};
+
+struct Header {
+  std::uint64_t magic = MAGIC;
+  std::uint32_t version = VERSION;
+  std::uint32_t valueSize = 0;
+  Encoding encoding = Encoding::RAW;
+  std::uint32_t reserved = 0;
+  std::uint64_t count = 0;
+};
+
+/*!
+ * @brief multiplicative hash of a byte stream taken 8 bytes at a time, the
+ *        stream may come in pieces of any length
+ */
+class Checksum {
+public:
+  void update(const char*, std::size_t);
+  std::uint64_t value() const;
+protected:
+  static std::uint64_t mix(std::uint64_t, std::uint64_t);
+  std::uint64_t hash_ = MAGIC;
+  std::uint64_t pending_ = 0;
+  std::size_t pendingSize_ = 0;
+  std::uint64_t size_ = 0;
+private:
+};
+
+/*!
+ * @brief buffered sink into a std::ostream or a file descriptor, the bytes
+ *        are checksummed as the buffer is flushed
+ */
+class Writer {
+public:
+  explicit Writer(std::ostream&);
+  explicit Writer(int fd);
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+  bool good() const;
+  bool write(const void*, std::size_t);
+  template <typename T>
+  bool put(const T&);
+  /*!
+   * @brief flushes the buffer followed by the checksum
+   */
+  bool finish();
+  virtual ~Writer() = default;
+protected:
+  bool flush();
+  bool sink(const char*, std::size_t);
+  std::ostream* os_ = nullptr;
+  int fd_ = -1;
+  std::vector<char> buffer_;
+  std::size_t used_ = 0;
+  Checksum checksum_;
+  bool good_ = true;
+private:
+};
+
+/*!
+ * @brief buffered source from a std::istream or a file descriptor, the bytes
+ *        are checksummed as they are consumed
+ */
+class Reader {
+public:
+  explicit Reader(std::istream&);
+  explicit Reader(int fd);
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+  bool good() const;
+  bool read(void*, std::size_t);
+  template <typename T>
+  bool get(T&);
+  /*!
+   * @brief reads the checksum and compares it with the consumed bytes
+   */
+  bool finish();
+  virtual ~Reader() = default;
+protected:
+  bool refill();
+  std::size_t source(char*, std::size_t);
+  std::istream* is_ = nullptr;
+  int fd_ = -1;
+  std::vector<char> buffer_;
+  /// consumed bytes from checked_ to begin_ are not checksummed yet
+  std::size_t checked_ = 0;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  Checksum checksum_;
+  bool good_ = true;
+private:
+};
+
+/*!
+ * @brief encoding of a value, trivially copyable values are copied raw;
+ *        the writer and reader need only write() and read() of bytes, e.g.
+ *        Writer and Reader
+ */
+template <typename T>
+struct Codec;
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+struct Codec<T> {
+  static constexpr std::uint32_t RAW_SIZE = sizeof(T);
+  template <typename W>
+  static bool write(W& w, const T& val) {
+    return w.write(&val, sizeof(T));
+  }
+  template <typename R>
+  static bool read(R& r, T& val) { return r.read(&val, sizeof(T)); }
+};
+
+/*!
+ * @brief strings go as their length followed by their characters
+ */
+template <typename Char, typename Traits, typename Alloc>
+struct Codec<std::basic_string<Char, Traits, Alloc>> {
+  using string_type = std::basic_string<Char, Traits, Alloc>;
+  static constexpr std::uint32_t RAW_SIZE = 0;
+  /// characters read at a time
+  static constexpr std::uint64_t CHUNK = 1 << 16;
+  template <typename W>
+  static bool write(W& w, const string_type& val) {
+    const std::uint64_t size = val.size();
+    return w.write(&size, sizeof(size)) &&
+        w.write(val.data(), size * sizeof(Char));
+  }
+  template <typename R>
+  static bool read(R& r, string_type& val) {
+    std::uint64_t size = 0;
+    if (!r.read(&size, sizeof(size)) || size > val.max_size()) {
+      return false;
+    }
+    /// grown as the characters come, a corrupt length runs out of bytes
+    /// long before it could allocate much
+    val.clear();
+    while (val.size() < size) {
+      const auto at = val.size();
+      const auto n = std::min<std::uint64_t>(CHUNK, size - at);
+      val.resize(at + n);
+      if (!r.read(val.data() + at, n * sizeof(Char))) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+template <typename T>
+concept Packable = std::integral<T> && !std::same_as<T, bool>;
+
+/*!
+ * @brief frame of reference coding of a non decreasing integer sequence:
+ *        the first value goes as is, the differences between consecutive
+ *        values follow in blocks of BLOCK, each a byte holding the bit width
+ *        of its largest difference and every difference in that many bits,
+ *        little endian
+ *
+ * a dense range takes a bit per value, and neither side ever holds more
+ * than a block
+ */
+template <Packable T>
+class PackedWriter {
+public:
+  using value_type = T;
+  static constexpr std::size_t BLOCK = 128;
+  explicit PackedWriter(Writer& w) : writer_(w) {}
+  bool put(const value_type&);
+  /*!
+   * @brief writes the last, partial block
+   */
+  bool flush();
+protected:
+  using unsigned_type = std::make_unsigned_t<value_type>;
+  Writer& writer_;
+  unsigned_type prev_ = 0;
+  unsigned_type deltas_[BLOCK]{};
+  std::size_t size_ = 0;
+  bool first_ = true;
+private:
+};
+
+template <Packable T>
+class PackedReader {
+public:
+  using value_type = T;
+  static constexpr std::size_t BLOCK = PackedWriter<T>::BLOCK;
+  /*!
+   * @param count values to read, the last block holds the remainder
+   */
+  PackedReader(Reader& r, std::size_t count) : reader_(r), left_(count) {}
+  bool get(value_type&);
+protected:
+  using unsigned_type = std::make_unsigned_t<value_type>;
+  bool refill();
+  Reader& reader_;
+  std::size_t left_ = 0;
+  unsigned_type values_[BLOCK]{};
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  unsigned_type prev_ = 0;
+  bool first_ = true;
+private:
+};
+
+/*!
+ * @brief nodes of the subtree, iteratively
+ */
+template <typename Node>
+std::size_t count(const Node*);
+
+/*!
+ * @brief writes the count nodes of the tree at root in order
+ * @return false as well for Encoding::PACKED of values that are no integers
+ */
+template <typename Node>
+bool save(
+    Writer&,
+    const Node* root,
+    std::size_t count,
+    Encoding = Encoding::RAW
+);
+
+/*!
+ * @brief replaces the tree at root with a balanced one read from a snapshot
+ * @param init called as init(node, parent, level, horizontal) for every
+ *        node: level counts from 0 at the bottom and every path from the
+ *        root meets the same number of levels, a horizontal node has the
+ *        level of its parent and is always a right child whose own childs
+ *        are a level lower, i.e. the levels of an aa tree, or the black
+ *        height of a red black tree with the horizontal nodes red
+ * @return false, leaving the tree empty, for a truncated or corrupt snapshot
+ *         or values out of order
+ */
+template <typename Node, typename Init>
+bool load(Reader&, Node*& root, Init init);
+
+} /// namespace snapshot
+
+} /// namespace sal
+
+namespace sal {
+
+namespace snapshot {
+
+inline std::uint64_t Checksum::mix(std::uint64_t hash, std::uint64_t word) {
+  return std::rotl((hash ^ word) * 0x9e3779b97f4a7c15ull, 31);
+}
+
+inline void Checksum::update(const char* data, std::size_t size) {
+  this->size_ += size;
+  while (this->pendingSize_ && size) {
+    this->pending_ |= static_cast<std::uint64_t>(
+        static_cast<unsigned char>(*data++)
+    ) << (8 * this->pendingSize_++);
+    size--;
+    if (this->pendingSize_ == 8) {
+      this->hash_ = mix(this->hash_, this->pending_);
+      this->pending_ = 0;
+      this->pendingSize_ = 0;
+    }
+  }
+  for (; size >= 8; data += 8, size -= 8) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data, 8);
+    this->hash_ = mix(this->hash_, word);
+  }
+  for (; size; size--) {
+    this->pending_ |= static_cast<std::uint64_t>(
+        static_cast<unsigned char>(*data++)
+    ) << (8 * this->pendingSize_++);
+  }
+}
+
+inline std::uint64_t Checksum::value() const {
+  auto hash = mix(mix(this->hash_, this->pending_), this->size_);
+  return hash ^ (hash >> 32);
+}
+
+inline Writer::Writer(std::ostream& os) : os_(&os), buffer_(BUFFER_SIZE) {}
+
+inline Writer::Writer(int fd) : fd_(fd), buffer_(BUFFER_SIZE) {}
+
+inline bool Writer::good() const {
+  return this->good_;
+}
+
+inline bool Writer::sink(const char* data, std::size_t size) {
+  if (this->os_) {
+    this->good_ = this->good_ &&
+        this->os_->write(data, static_cast<std::streamsize>(size));
+    return this->good_;
+  }
+  while (this->good_ && size) {
+    const auto written = ::write(this->fd_, data, size);
+    if (written < 0 && errno != EINTR) {
+      this->good_ = false;
+    } else if (written > 0) {
+      data += written;
+      size -= static_cast<std::size_t>(written);
+    }
+  }
+  return this->good_;
+}
+
+inline bool Writer::flush() {
+  this->checksum_.update(this->buffer_.data(), this->used_);
+  this->sink(this->buffer_.data(), this->used_);
+  this->used_ = 0;
+  return this->good_;
+}
+
+inline bool Writer::write(const void* data, std::size_t size) {
+  const auto* bytes = static_cast<const char*>(data);
+  while (this->used_ + size > this->buffer_.size()) {
+    const auto room = this->buffer_.size() - this->used_;
+    std::memcpy(this->buffer_.data() + this->used_, bytes, room);
+    this->used_ += room;
+    bytes += room;
+    size -= room;
+    if (!this->flush()) {
+      return false;
+    }
+  }
+  std::memcpy(this->buffer_.data() + this->used_, bytes, size);
+  this->used_ += size;
+  return this->good_;
+}
+
+template <typename T>
+bool Writer::put(const T& val) {
+  return Codec<T>::write(*this, val);
+}
+
+inline bool Writer::finish() {
+  if (!this->flush()) {
+    return false;
+  }
+  const auto sum = this->checksum_.value();
+  this->sink(reinterpret_cast<const char*>(&sum), sizeof(sum));
+  if (this->os_ && this->good_) {
+    this->good_ = static_cast<bool>(this->os_->flush());
+  }
+  return this->good_;
+}
+
+inline Reader::Reader(std::istream& is) : is_(&is), buffer_(BUFFER_SIZE) {}
+
+inline Reader::Reader(int fd) : fd_(fd), buffer_(BUFFER_SIZE) {}
+
+inline bool Reader::good() const {
+  return this->good_;
+}
+
+inline std::size_t Reader::source(char* data, std::size_t size) {
+  if (this->is_) {
+    this->is_->read(data, static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(this->is_->gcount());
+  }
+  while (true) {
+    const auto got = ::read(this->fd_, data, size);
+    if (got >= 0) {
+      return static_cast<std::size_t>(got);
+    } else if (errno != EINTR) {
+      return 0;
+    }
+  }
+}
+
+/*!
+ * @brief checksums the consumed bytes and replaces them with fresh ones
+ */
+inline bool Reader::refill() {
+  this->checksum_.update(
+      this->buffer_.data() + this->checked_,
+      this->begin_ - this->checked_
+  );
+  std::memmove(
+      this->buffer_.data(),
+      this->buffer_.data() + this->begin_,
+      this->end_ - this->begin_
+  );
+  this->end_ -= this->begin_;
+  this->begin_ = 0;
+  this->checked_ = 0;
+  const auto got = this->source(
+      this->buffer_.data() + this->end_,
+      this->buffer_.size() - this->end_
+  );
+  this->end_ += got;
+  this->good_ = got > 0;
+  return this->good_;
+}
+
+inline bool Reader::read(void* data, std::size_t size) {
+  auto* bytes = static_cast<char*>(data);
+  while (this->begin_ + size > this->end_) {
+    const auto available = this->end_ - this->begin_;
+    std::memcpy(bytes, this->buffer_.data() + this->begin_, available);
+    this->begin_ += available;
+    bytes += available;
+    size -= available;
+    if (!this->refill()) {
+      return false;
+    }
+  }
+  std::memcpy(bytes, this->buffer_.data() + this->begin_, size);
+  this->begin_ += size;
+  return this->good_;
+}
+
+template <typename T>
+bool Reader::get(T& val) {
+  return Codec<T>::read(*this, val);
+}
+
+inline bool Reader::finish() {
+  this->checksum_.update(
+      this->buffer_.data() + this->checked_,
+      this->begin_ - this->checked_
+  );
+  this->checked_ = this->begin_;
+  const auto expected = this->checksum_.value();
+  std::uint64_t sum = 0;
+  return this->read(&sum, sizeof(sum)) && sum == expected;
+}
+
+template <typename Node>
+std::size_t count(const Node* root) {
+  std::size_t ret = 0;
+  std::vector<const Node*> stack;
+  if (root) {
+    stack.push_back(root);
+  }
+  while (!stack.empty()) {
+    const auto* top = stack.back();
+    stack.pop_back();
+    ret++;
+    for (const auto* child : top->childs()) {
+      if (child) {
+        stack.push_back(child);
+      }
+    }
+  }
+  return ret;
+}
+
+template <Packable T>
+bool PackedWriter<T>::put(const value_type& val) {
+  const auto u = static_cast<unsigned_type>(val);
+  if (std::exchange(this->first_, false)) {
+    this->prev_ = u;
+    return this->writer_.write(&u, sizeof(u));
+  }
+  /// modular, so a non decreasing signed sequence has no negative delta
+  this->deltas_[this->size_++] = u - this->prev_;
+  this->prev_ = u;
+  return this->size_ < BLOCK || this->flush();
+}
+
+template <Packable T>
+bool PackedWriter<T>::flush() {
+  if (!this->size_) {
+    return this->writer_.good();
+  }
+  unsigned_type all = 0;
+  for (std::size_t i = 0; i < this->size_; i++) {
+    all |= this->deltas_[i];
+  }
+  const auto width = static_cast<std::uint8_t>(std::bit_width(all));
+  /// a value spans two words at most, the second may start past the end
+  std::uint8_t bytes[BLOCK * sizeof(unsigned_type) + 16]{};
+  for (std::size_t i = 0; width && i < this->size_; i++) {
+    const auto bit = i * width;
+    const auto shift = bit % 8;
+    const std::uint64_t delta = this->deltas_[i];
+    std::uint64_t word = 0;
+    std::memcpy(&word, bytes + bit / 8, 8);
+    word |= delta << shift;
+    std::memcpy(bytes + bit / 8, &word, 8);
+    if (shift + width > 64) {
+      std::memcpy(&word, bytes + bit / 8 + 8, 8);
+      word |= delta >> (64 - shift);
+      std::memcpy(bytes + bit / 8 + 8, &word, 8);
+    }
+  }
+  const auto size = (this->size_ * width + 7) / 8;
+  this->size_ = 0;
+  return this->writer_.write(&width, 1) && this->writer_.write(bytes, size);
+}
+
+template <Packable T>
+bool PackedReader<T>::refill() {
+  const auto n = std::min(this->left_, BLOCK);
+  std::uint8_t width = 0;
+  if (!n || !this->reader_.read(&width, 1) ||
+      width > 8 * sizeof(unsigned_type)) {
+    return false;
+  }
+  std::uint8_t bytes[BLOCK * sizeof(unsigned_type) + 16]{};
+  if (!this->reader_.read(bytes, (n * width + 7) / 8)) {
+    return false;
+  }
+  const auto mask = width == 64 ? ~std::uint64_t{0} :
+      (std::uint64_t{1} << width) - 1;
+  auto prev = this->prev_;
+  for (std::size_t i = 0; i < n; i++) {
+    const auto bit = i * width;
+    const auto shift = bit % 8;
+    std::uint64_t word = 0;
+    std::memcpy(&word, bytes + bit / 8, 8);
+    word >>= shift;
+    if (shift + width > 64) {
+      std::uint64_t next = 0;
+      std::memcpy(&next, bytes + bit / 8 + 8, 8);
+      word |= next << (64 - shift);
+    }
+    prev += static_cast<unsigned_type>(word & mask);
+    this->values_[i] = prev;
+  }
+  this->prev_ = prev;
+  this->left_ -= n;
+  this->begin_ = 0;
+  this->end_ = n;
+  return true;
+}
+
+template <Packable T>
+bool PackedReader<T>::get(value_type& val) {
+  if (this->first_ && this->left_) {
+    this->first_ = false;
+    this->left_--;
+    if (!this->reader_.read(&this->prev_, sizeof(this->prev_))) {
+      return false;
+    }
+    val = static_cast<value_type>(this->prev_);
+    return true;
+  }
+  if (this->begin_ == this->end_ && !this->refill()) {
+    return false;
+  }
+  val = static_cast<value_type>(this->values_[this->begin_++]);
+  return true;
+}
+
+/*!
+ * @brief calls f with the values of the tree at root in order, until it
+ *        returns false
+ */
+template <typename Node, typename F>
+bool inorder(const Node* root, F&& f) {
+  /// the stack holds the ancestors still to be visited
+  std::vector<const Node*> stack;
+  for (const auto* it = root; it || !stack.empty();) {
+    if (it) {
+      stack.push_back(it);
+      it = it->left();
+      continue;
+    }
+    it = stack.back();
+    stack.pop_back();
+    if (!f(it->value())) {
+      return false;
+    }
+    it = it->right();
+  }
+  return true;
+}
+
+template <typename Node>
+bool save(
+    Writer& w,
+    const Node* root,
+    std::size_t count,
+    Encoding encoding
+) {
+  using value_type = std::remove_cvref_t<decltype(root->value())>;
+  Header header;
+  header.valueSize = Codec<value_type>::RAW_SIZE;
+  header.encoding = encoding;
+  header.count = count;
+  if (encoding == Encoding::RAW) {
+    return w.write(&header, sizeof(header)) &&
+        inorder(root, [&](const value_type& val) { return w.put(val); }) &&
+        w.finish();
+  }
+  if constexpr (Packable<value_type>) {
+    if (encoding == Encoding::PACKED) {
+      PackedWriter<value_type> packed(w);
+      return w.write(&header, sizeof(header)) &&
+          inorder(root, [&](const value_type& v) { return packed.put(v); }) &&
+          packed.flush() &&
+          w.finish();
+    }
+  }
+  return false;
+}
+
+/*!
+ * @brief state of a balanced build fed by the values in order
+ */
+template <typename Node, typename Init, typename Source>
+class Builder {
+public:
+  using value_type =
+      std::remove_cvref_t<decltype(std::declval<Node&>().value())>;
+  Builder(Source& source, Init& init) : source_(source), init_(init) {}
+  /*!
+   * @brief subtree of the next n values, the left part takes the floor half
+   *        so that the right one is the larger or a perfect tree of its own
+   *        level, never a left one
+   */
+  Node* build(std::size_t n, Node* parent, std::size_t parentLevel) {
+    if (!n || !this->good_) {
+      return nullptr;
+    }
+    /// floor(log2(n + 1)) - 1, without overflowing n + 1
+    const std::size_t level = std::bit_width(n - n / 2) - 1;
+    const auto left = (n - 1) / 2;
+    auto* node = new Node();
+    this->init_(*node, parent, level, parent && level == parentLevel);
+    node->left() = this->build(left, node, level);
+    if (this->good_) {
+      this->good_ = this->source_(node->value()) &&
+          (this->first_ || !(node->value() < *this->last_));
+      this->first_ = false;
+      this->last_ = &node->value();
+    }
+    node->right() = this->build(n - 1 - left, node, level);
+    return node;
+  }
+  bool good() const { return this->good_; }
+protected:
+  Source& source_;
+  Init& init_;
+  const value_type* last_ = nullptr;
+  bool first_ = true;
+  bool good_ = true;
+private:
+};
+
+/*!
+ * @brief builds the tree at root from count values taken from source, then
+ *        checks the checksum
+ */
+template <typename Node, typename Init, typename Source>
+bool build(
+    Reader& r,
+    Node*& root,
+    std::size_t count,
+    Init& init,
+    Source source
+) {
+  Builder<Node, Init, Source> builder(source, init);
+  root = builder.build(count, nullptr, 0);
+  if (!builder.good() || !r.finish()) {
+    delete std::exchange(root, nullptr);
+    return false;
+  }
+  return true;
+}
+
+template <typename Node, typename Init>
+bool load(Reader& r, Node*& root, Init init) {
+  using value_type = std::remove_cvref_t<decltype(root->value())>;
+  delete std::exchange(root, nullptr);
+  Header header;
+  if (!r.read(&header, sizeof(header)) ||
+      header.magic != MAGIC ||
+      header.version != VERSION ||
+      header.valueSize != Codec<value_type>::RAW_SIZE) {
+    return false;
+  }
+  if (header.encoding == Encoding::RAW) {
+    return build(r, root, header.count, init, [&](value_type& val) {
+      return r.get(val);
+    });
+  }
+  if constexpr (Packable<value_type>) {
+    if (header.encoding == Encoding::PACKED) {
+      PackedReader<value_type> packed(r, header.count);
+      return build(r, root, header.count, init, [&](value_type& val) {
+        return packed.get(val);
+      });
+    }
+  }
+  return false;
+}
+
+} /// namespace snapshot
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+template <typename Sink>
+bool Tree<Data, Algorithm>::save(
+    Sink&& sink,
+    snapshot::Encoding encoding
+) const {
+  snapshot::Writer writer(sink);
+  return snapshot::save(
+      writer,
+      this->algo_.root(),
+      this->size_,
+      encoding
+  );
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+template <typename Source>
+bool Tree<Data, Algorithm>::load(Source&& source) {
+  this->detach();
+  const auto loaded = this->algo_.load(std::forward<Source>(source));
+  this->size_ = snapshot::count(this->algo_.root());
+  return loaded;
+}
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+template <typename Sink>
+bool AATree<Data>::save(
+    Sink&& sink,
+    snapshot::Encoding encoding
+) const {
+  snapshot::Writer writer(sink);
+  return snapshot::save(
+      writer,
+      this->root(),
+      snapshot::count(this->root()),
+      encoding
+  );
+}
+
+template <typename Data>
+template <typename Source>
+bool AATree<Data>::load(Source&& source) {
+  snapshot::Reader reader(source);
+  this->sequence_ = 0;
+  return snapshot::load(reader, this->root(), &AATree::init);
+}
+
+template <typename Data>
+template <typename Sink>
+bool BSTree<Data>::save(
+    Sink&& sink,
+    snapshot::Encoding encoding
+) const {
+  snapshot::Writer writer(sink);
+  return snapshot::save(writer, this->root(), this->size_, encoding);
+}
+
+template <typename Data>
+template <typename Source>
+bool BSTree<Data>::load(Source&& source) {
+  snapshot::Reader reader(source);
+  const auto loaded = snapshot::load(
+      reader,
+      this->root(),
+      [](node_type& n, node_type* parent, std::size_t, bool) {
+        n.parent() = parent;
+      }
+  );
+  this->size_ = snapshot::count(this->root());
+  return loaded;
+}
+
+template <typename Data>
+template <typename Sink>
+bool RBTree<Data>::save(
+    Sink&& sink,
+    snapshot::Encoding encoding
+) const {
+  snapshot::Writer writer(sink);
+  return snapshot::save(
+      writer,
+      this->root(),
+      snapshot::count(this->root()),
+      encoding
+  );
+}
+
+template <typename Data>
+template <typename Source>
+bool RBTree<Data>::load(Source&& source) {
+  snapshot::Reader reader(source);
+  this->sequence_ = 0;
+  return snapshot::load(reader, this->root(), &RBTree::init);
+}
+
+} /// namespace sal
+
+#endif /// SAL_SNAPSHOT_HH_
@@ -0,0 +1,325 @@
+#ifndef SAL_SPLAY_TREE_HH_
+#define SAL_SPLAY_TREE_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <sal/node_tree_binary_base.hh>
+
+namespace sal {
+
+/*!
+ * @brief self-adjusting tree, every access splays the touched node to the root
+ * @note find() restructures the tree as well, so the root is mutable
+ */
+template <typename Data>
+class SplayTree {
+public:
+  using value_type = Data;
+  template <NodeValue T>
+  class Node : public NodeTreeBinaryBase<Node, T> {
+  public:
+    constexpr Node() = default;
+    constexpr Node(T);
+    constexpr Node(const Node&) = default;
+    constexpr Node& operator=(const Node&) = default;
+    constexpr Node(Node&&) = default;
+    constexpr Node& operator=(Node&&) = default;
+    constexpr virtual ~Node() = default;
+  protected:
+  private:
+  };
+  using node_type = Node<value_type>;
+  constexpr SplayTree() = default;
+  constexpr SplayTree(const SplayTree&);
+  constexpr SplayTree& operator=(const SplayTree&);
+  constexpr SplayTree(SplayTree&&);
+  constexpr SplayTree& operator=(SplayTree&&);
+  constexpr node_type* const & root() const;
+  constexpr node_type*& root();
+  constexpr node_type* insert(const value_type&);
+  constexpr node_type* insert(value_type&&);
+  constexpr node_type* remove(const value_type&);
+  constexpr node_type* remove(value_type&&);
+  constexpr node_type* find(const value_type&) const;
+  constexpr node_type* find(value_type&&) const;
+  constexpr virtual ~SplayTree();
+protected:
+  constexpr static node_type* splay(const value_type&, node_type*);
+  constexpr static node_type* clone(const node_type*);
+  constexpr static void destroy(node_type*);
+  constexpr node_type* insert(const value_type&, node_type*&);
+  constexpr node_type* remove(const value_type&, node_type*&);
+  constexpr node_type* find(const value_type&, node_type*&) const;
+  mutable node_type* root_ = nullptr;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+template <NodeValue T>
+constexpr SplayTree<Data>::Node<T>::Node(T value)
+  : NodeTreeBinaryBase<Node, T>(value) {}
+
+template <typename Data>
+constexpr SplayTree<Data>::SplayTree(const SplayTree& other)
+  : root_(clone(other.root())) {}
+
+template <typename Data>
+constexpr SplayTree<Data>& SplayTree<Data>::operator=(const SplayTree& other) {
+  if (this != &other) {
+    destroy(std::exchange(this->root(), nullptr));
+    this->root() = clone(other.root());
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr SplayTree<Data>::SplayTree(SplayTree&& other)
+  : root_(std::exchange(other.root_, nullptr)) {}
+
+template <typename Data>
+constexpr SplayTree<Data>& SplayTree<Data>::operator=(SplayTree&& other) {
+  if (this != &other) {
+    destroy(std::exchange(this->root(), other.root()));
+    other.root() = nullptr;
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type* const &
+SplayTree<Data>::root() const {
+  return this->root_;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*&
+SplayTree<Data>::root() {
+  return this->root_;
+}
+
+/*!
+ * @brief top-down splay, brings val (or the last node on its search path)
+ *        to the root of the subtree in a single descent
+ * @note node != nullptr
+ */
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::splay(
+    const typename SplayTree<Data>::value_type& val,
+    SplayTree<Data>::node_type* node
+) {
+  node_type* l = nullptr; /// nodes smaller than val, linked by right()
+  node_type* r = nullptr; /// nodes greater than val, linked by left()
+  node_type** lmax = &l;
+  node_type** rmin = &r;
+  while (true) {
+    if (val < node->value()) {
+      if (!node->left()) {
+        break;
+      }
+      if (val < node->left()->value()) {
+        auto* c = node->left();
+        node->left() = c->right();
+        c->right() = node;
+        node = c;
+        if (!node->left()) {
+          break;
+        }
+      }
+      *rmin = node;
+      rmin = &node->left();
+      node = node->left();
+    } else if (val > node->value()) {
+      if (!node->right()) {
+        break;
+      }
+      if (val > node->right()->value()) {
+        auto* c = node->right();
+        node->right() = c->left();
+        c->left() = node;
+        node = c;
+        if (!node->right()) {
+          break;
+        }
+      }
+      *lmax = node;
+      lmax = &node->right();
+      node = node->right();
+    } else {
+      break;
+    }
+  }
+  *lmax = node->left();
+  *rmin = node->right();
+  node->left() = l;
+  node->right() = r;
+  return node;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::insert(
+    const typename SplayTree<Data>::value_type& val,
+    SplayTree<Data>::node_type*& node
+) {
+  if (!node) {
+    return node = new node_type(val);
+  }
+  node = this->splay(val, node);
+  if (val < node->value()) {
+    auto* inserted = new node_type(val);
+    inserted->left() = node->left();
+    inserted->right() = node;
+    node->left() = nullptr;
+    return node = inserted;
+  } else if (val > node->value()) {
+    auto* inserted = new node_type(val);
+    inserted->right() = node->right();
+    inserted->left() = node;
+    node->right() = nullptr;
+    return node = inserted;
+  }
+  return nullptr;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::remove(
+    const typename SplayTree<Data>::value_type& val,
+    SplayTree<Data>::node_type*& node
+) {
+  if (!node) {
+    return node;
+  }
+  node = this->splay(val, node);
+  if (val < node->value() || val > node->value()) {
+    return nullptr;
+  }
+  auto* toBeDeleted = node;
+  if (!node->left()) {
+    node = node->right();
+  } else {
+    /// every key on the left is smaller, so the maximum ends up as the root
+    /// with a free right slot
+    node = this->splay(val, node->left());
+    node->right() = toBeDeleted->right();
+  }
+  toBeDeleted->left() = nullptr;
+  toBeDeleted->right() = nullptr;
+  delete toBeDeleted;
+  return node;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::find(
+    const typename SplayTree<Data>::value_type& val,
+    SplayTree<Data>::node_type*& node
+) const {
+  if (!node) {
+    return node;
+  }
+  node = this->splay(val, node);
+  if (val < node->value() || val > node->value()) {
+    return nullptr;
+  }
+  return node;
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::insert(const typename SplayTree<Data>::value_type& val) {
+  return this->insert(val, this->root());
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::insert(typename SplayTree<Data>::value_type&& val) {
+  return this->insert(val, this->root());
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::remove(const typename SplayTree<Data>::value_type& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::remove(typename SplayTree<Data>::value_type&& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::find(const typename SplayTree<Data>::value_type& val) const {
+  return this->find(val, this->root_);
+}
+
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::find(typename SplayTree<Data>::value_type&& val) const {
+  return this->find(val, this->root_);
+}
+
+/*!
+ * @brief copies the subtree node by node, a splayed tree may be a path as
+ *        long as the tree and the node copy would recurse down all of it
+ */
+template <typename Data>
+constexpr typename SplayTree<Data>::node_type*
+SplayTree<Data>::clone(const node_type* node) {
+  node_type* ret = nullptr;
+  std::vector<std::pair<const node_type*, node_type**>> stack;
+  if (node) {
+    stack.emplace_back(node, &ret);
+  }
+  while (!stack.empty()) {
+    auto [from, to] = stack.back();
+    stack.pop_back();
+    *to = new node_type(from->value());
+    if (from->left()) {
+      stack.emplace_back(from->left(), &(*to)->left());
+    }
+    if (from->right()) {
+      stack.emplace_back(from->right(), &(*to)->right());
+    }
+  }
+  return ret;
+}
+
+/*!
+ * @brief right rotations bring every left child up, each node is freed
+ *        once it has none; ~Node would recurse down the whole depth
+ */
+template <typename Data>
+constexpr void SplayTree<Data>::destroy(node_type* node) {
+  while (node) {
+    if (auto* l = node->left()) {
+      node->left() = l->right();
+      l->right() = node;
+      node = l;
+    } else {
+      auto* toBeDeleted = node;
+      node = node->right();
+      toBeDeleted->right() = nullptr;
+      delete toBeDeleted;
+    }
+  }
+}
+
+template <typename Data>
+constexpr SplayTree<Data>::~SplayTree() {
+  destroy(std::exchange(this->root(), nullptr));
+}
+
+} /// namespace sal
+
+#endif /// SAL_SPLAY_TREE_HH_
@@ -0,0 +1,233 @@
+#ifndef SAL_THREAD_POOL_HH_
+#define SAL_THREAD_POOL_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sal {
+
+/*!
+ * @brief work stealing fork join pool: invoke() runs two functions in
+ *        parallel, the second on the calling thread while the first is
+ *        pushed on the deque of that thread, and a thread waiting for a
+ *        pushed function runs others meanwhile, so that nested invoke()
+ *        never blocks a worker
+ *
+ * a thread takes the newest function of its own deque, the smallest and
+ * the one whose data is warm, and steals the oldest of another deque, the
+ * largest part of the fork it was pushed by; threads outside the pool
+ * share one deque
+ */
+class ThreadPool {
+public:
+  /*!
+   * @param threads the calling thread included, the cores when 0
+   */
+  explicit ThreadPool(std::size_t threads = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  std::size_t threads() const;
+  /*!
+   * @brief runs a() and b() in parallel, returns once both are done
+   */
+  template <typename A, typename B>
+  void invoke(A&& a, B&& b);
+  /*!
+   * @brief runs f(begin, end) over ranges of [0, n) of about grain values,
+   *        returns once all are done
+   */
+  template <typename F>
+  void parallelFor(std::size_t n, std::size_t grain, F&& f);
+  virtual ~ThreadPool();
+protected:
+  struct Deque {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+  /*!
+   * @brief pool and deque of the calling thread when it is a worker, null
+   *        for others as thread locals start zeroed
+   */
+  struct Current {
+    const ThreadPool* pool;
+    std::size_t slot;
+  };
+  static inline thread_local Current current_{};
+  /*!
+   * @brief deque of the calling thread, 0 for threads outside the pool
+   */
+  std::size_t slot() const;
+  void push(std::function<void()>&&);
+  /*!
+   * @brief runs a function of the own deque, or one stolen
+   * @return false when there is none
+   */
+  bool runOne();
+  void worker(std::size_t slot);
+  template <typename F>
+  void parallelFor(std::size_t begin, std::size_t end, std::size_t grain,
+      F& f);
+  std::vector<std::unique_ptr<Deque>> deques_;
+  /// functions in the deques
+  std::atomic<std::size_t> pending_ = 0;
+  /// workers asleep, waiting for pending_
+  std::atomic<std::size_t> sleeping_ = 0;
+  std::mutex mutex_;
+  std::condition_variable work_;
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+inline ThreadPool::ThreadPool(std::size_t threads) {
+  if (!threads) {
+    threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  for (std::size_t i = 0; i < threads; i++) {
+    this->deques_.push_back(std::make_unique<Deque>());
+  }
+  for (std::size_t i = 1; i < threads; i++) {
+    this->workers_.emplace_back([this, i] { this->worker(i); });
+  }
+}
+
+inline std::size_t ThreadPool::threads() const {
+  return this->workers_.size() + 1;
+}
+
+template <typename A, typename B>
+void ThreadPool::invoke(A&& a, B&& b) {
+  if (this->workers_.empty()) {
+    a();
+    b();
+    return;
+  }
+  std::atomic<bool> done = false;
+  this->push([&] {
+    a();
+    done.store(true, std::memory_order_release);
+  });
+  b();
+  while (!done.load(std::memory_order_acquire)) {
+    if (!this->runOne()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename F>
+void ThreadPool::parallelFor(std::size_t n, std::size_t grain, F&& f) {
+  this->parallelFor(0, n, std::max<std::size_t>(grain, 1), f);
+}
+
+template <typename F>
+void ThreadPool::parallelFor(
+    std::size_t begin,
+    std::size_t end,
+    std::size_t grain,
+    F& f
+) {
+  if (end - begin <= grain) {
+    if (begin < end) {
+      f(begin, end);
+    }
+    return;
+  }
+  const auto middle = begin + (end - begin) / 2;
+  this->invoke(
+      [&] { this->parallelFor(middle, end, grain, f); },
+      [&] { this->parallelFor(begin, middle, grain, f); }
+  );
+}
+
+inline std::size_t ThreadPool::slot() const {
+  return current_.pool == this ? current_.slot : 0;
+}
+
+/*!
+ * @note pending_ is raised before sleeping_ is read, and a worker raises
+ *       sleeping_ before it reads pending_, so one of them sees the other
+ */
+inline void ThreadPool::push(std::function<void()>&& task) {
+  auto& deque = *this->deques_[this->slot()];
+  {
+    std::lock_guard lock(deque.mutex);
+    deque.tasks.push_back(std::move(task));
+  }
+  this->pending_++;
+  if (this->sleeping_) {
+    std::lock_guard lock(this->mutex_);
+    this->work_.notify_one();
+  }
+}
+
+inline bool ThreadPool::runOne() {
+  std::function<void()> task;
+  const auto own = this->slot();
+  const auto n = this->deques_.size();
+  for (std::size_t i = 0; i < n && !task; i++) {
+    auto& deque = *this->deques_[(own + i) % n];
+    std::lock_guard lock(deque.mutex);
+    if (deque.tasks.empty()) {
+      continue;
+    }
+    if (i) {
+      task = std::move(deque.tasks.front());
+      deque.tasks.pop_front();
+    } else {
+      task = std::move(deque.tasks.back());
+      deque.tasks.pop_back();
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  this->pending_--;
+  task();
+  return true;
+}
+
+inline void ThreadPool::worker(std::size_t slot) {
+  current_ = {this, slot};
+  while (true) {
+    if (this->runOne()) {
+      continue;
+    }
+    std::unique_lock lock(this->mutex_);
+    this->sleeping_++;
+    this->work_.wait(lock, [&] {
+      return this->stop_ || this->pending_;
+    });
+    this->sleeping_--;
+    if (this->stop_ && !this->pending_) {
+      return;
+    }
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(this->mutex_);
+    this->stop_ = true;
+  }
+  this->work_.notify_all();
+  for (auto& worker : this->workers_) {
+    worker.join();
+  }
+}
+
+} /// namespace sal
+
+#endif /// SAL_THREAD_POOL_HH_
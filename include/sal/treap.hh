@@ -0,0 +1,345 @@
+#ifndef SAL_TREAP_HH_
+#define SAL_TREAP_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <sal/node_tree_binary_base.hh>
+
+namespace sal {
+
+/*!
+ * @brief randomized search tree, keys are ordered as in a bst while random
+ *        priorities are max-heap ordered, which keeps the expected depth
+ *        logarithmic regardless of the insertion order
+ */
+template <typename Data>
+class Treap {
+public:
+  using value_type = Data;
+  using priority_type = std::uint32_t;
+  template <NodeValue T>
+  class Node : public NodeTreeBinaryBase<Node, T> {
+  public:
+    constexpr Node() = default;
+    constexpr Node(T, priority_type);
+    constexpr Node(const Node&) = default;
+    constexpr Node& operator=(const Node&) = default;
+    constexpr Node(Node&&) = default;
+    constexpr Node& operator=(Node&&) = default;
+    constexpr const priority_type& priority() const;
+    constexpr priority_type& priority();
+    constexpr virtual ~Node() = default;
+  protected:
+    priority_type priority_ = 0;
+  private:
+  };
+  using node_type = Node<value_type>;
+  constexpr Treap() = default;
+  constexpr Treap(const Treap&);
+  constexpr Treap& operator=(const Treap&);
+  constexpr Treap(Treap&&);
+  constexpr Treap& operator=(Treap&&);
+  constexpr node_type* const & root() const;
+  constexpr node_type*& root();
+  constexpr node_type* insert(const value_type&);
+  constexpr node_type* insert(value_type&&);
+  constexpr node_type* remove(const value_type&);
+  constexpr node_type* remove(value_type&&);
+  constexpr node_type* find(const value_type&) const;
+  constexpr node_type* find(value_type&&) const;
+  /*!
+   * @brief moves every value not less than val out into the returned treap
+   * @note O(log n) expected, no node is allocated or copied
+   */
+  constexpr Treap split(const value_type&);
+  /*!
+   * @brief joins two treaps into one, both are left empty
+   * @note every value of left must be less than every value of right
+   */
+  constexpr static Treap merge(Treap&& left, Treap&& right);
+  constexpr virtual ~Treap();
+protected:
+  constexpr static std::pair<node_type*, node_type*>
+      split(node_type*, const value_type&);
+  constexpr static node_type* merge(node_type*, node_type*);
+  static std::uint64_t seed();
+  constexpr priority_type priority();
+  constexpr node_type* insert(node_type*, node_type*&);
+  constexpr node_type* remove(const value_type&, node_type*&);
+  constexpr node_type* find(const value_type&, node_type* const &) const;
+  node_type* root_ = nullptr;
+  std::uint64_t seed_ = seed();
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+template <NodeValue T>
+constexpr Treap<Data>::Node<T>::Node(T value, priority_type priority)
+  : NodeTreeBinaryBase<Node, T>(value), priority_(priority) {}
+
+template <typename Data>
+template <NodeValue T>
+constexpr const typename Treap<Data>::priority_type&
+Treap<Data>::Node<T>::priority() const {
+  return this->priority_;
+}
+
+template <typename Data>
+template <NodeValue T>
+constexpr typename Treap<Data>::priority_type&
+Treap<Data>::Node<T>::priority() {
+  return this->priority_;
+}
+
+template <typename Data>
+constexpr Treap<Data>::Treap(const Treap& other) {
+  if (other.root()) {
+    this->root() = new Node(*other.root());
+  }
+}
+
+template <typename Data>
+constexpr Treap<Data>& Treap<Data>::operator=(const Treap& other) {
+  if (this != &other) {
+    if (this->root()) {
+      delete this->root();
+      this->root() = nullptr;
+    }
+    if (other.root()) {
+      this->root() = new Node(*other.root());
+    }
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr Treap<Data>::Treap(Treap&& other)
+  : root_(std::exchange(other.root_, nullptr)), seed_(other.seed_) {}
+
+template <typename Data>
+constexpr Treap<Data>& Treap<Data>::operator=(Treap&& other) {
+  if (this != &other) {
+    if (this->root()) {
+      delete this->root();
+    }
+    this->root() = std::exchange(other.root(), nullptr);
+    this->seed_ = other.seed_;
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type* const &
+Treap<Data>::root() const {
+  return this->root_;
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*&
+Treap<Data>::root() {
+  return this->root_;
+}
+
+/*!
+ * @brief splitmix64 of a process wide counter, so that no two treaps,
+ *        copies and split halves included, draw the same priorities
+ */
+template <typename Data>
+std::uint64_t Treap<Data>::seed() {
+  static std::atomic<std::uint64_t> counter = 0;
+  auto x = counter.fetch_add(1, std::memory_order_relaxed) *
+      0x9e3779b97f4a7c15ull + 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  /// xorshift never leaves zero
+  return (x ^ (x >> 31)) | 1;
+}
+
+/*!
+ * @brief xorshift64, the upper half is used as the priority
+ */
+template <typename Data>
+constexpr typename Treap<Data>::priority_type Treap<Data>::priority() {
+  this->seed_ ^= this->seed_ << 13;
+  this->seed_ ^= this->seed_ >> 7;
+  this->seed_ ^= this->seed_ << 17;
+  return static_cast<priority_type>(this->seed_ >> 32);
+}
+
+/*!
+ * @return {values less than val, values not less than val}
+ */
+template <typename Data>
+constexpr std::pair<
+    typename Treap<Data>::node_type*,
+    typename Treap<Data>::node_type*
+> Treap<Data>::split(
+    Treap<Data>::node_type* node,
+    const typename Treap<Data>::value_type& val
+) {
+  if (!node) {
+    return {nullptr, nullptr};
+  } else if (node->value() < val) {
+    const auto [l, r] = split(node->right(), val);
+    node->right() = l;
+    return {node, r};
+  } else {
+    const auto [l, r] = split(node->left(), val);
+    node->left() = r;
+    return {l, node};
+  }
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::merge(Treap<Data>::node_type* l, Treap<Data>::node_type* r) {
+  if (!l) {
+    return r;
+  } else if (!r) {
+    return l;
+  } else if (l->priority() > r->priority()) {
+    l->right() = merge(l->right(), r);
+    return l;
+  } else {
+    r->left() = merge(l, r->left());
+    return r;
+  }
+}
+
+template <typename Data>
+constexpr Treap<Data> Treap<Data>::split(
+    const typename Treap<Data>::value_type& val
+) {
+  Treap other;
+  const auto [l, r] = split(this->root(), val);
+  this->root() = l;
+  other.root() = r;
+  return other;
+}
+
+template <typename Data>
+constexpr Treap<Data> Treap<Data>::merge(Treap&& left, Treap&& right) {
+  Treap ret;
+  ret.root() = merge(
+      std::exchange(left.root(), nullptr),
+      std::exchange(right.root(), nullptr)
+  );
+  ret.seed_ = left.seed_;
+  return ret;
+}
+
+/*!
+ * @brief descends while the priorities are higher than the inserted one,
+ *        then splits the remaining subtree around the inserted node
+ */
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::insert(
+    Treap<Data>::node_type* insertable,
+    Treap<Data>::node_type*& node
+) {
+  if (!node) {
+    return node = insertable;
+  } else if (insertable->priority() > node->priority()) {
+    const auto [l, r] = split(node, insertable->value());
+    insertable->left() = l;
+    insertable->right() = r;
+    return node = insertable;
+  } else if (insertable->value() < node->value()) {
+    return this->insert(insertable, node->left());
+  } else {
+    return this->insert(insertable, node->right());
+  }
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::remove(
+    const typename Treap<Data>::value_type& val,
+    Treap<Data>::node_type*& node
+) {
+  if (!node) {
+    return node;
+  } else if (val > node->value()) {
+    return this->remove(val, node->right());
+  } else if (val < node->value()) {
+    return this->remove(val, node->left());
+  }
+  auto* toBeDeleted = node;
+  node = merge(node->left(), node->right());
+  toBeDeleted->left() = nullptr;
+  toBeDeleted->right() = nullptr;
+  delete toBeDeleted;
+  return node;
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::find(
+    const typename Treap<Data>::value_type& val,
+    Treap<Data>::node_type* const & node
+) const {
+  if (!node) {
+    return node;
+  } else if (val > node->value()) {
+    return this->find(val, node->right());
+  } else if (val < node->value()) {
+    return this->find(val, node->left());
+  }
+  return node;
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::insert(const typename Treap<Data>::value_type& val) {
+  return this->insert(new node_type(val, this->priority()), this->root());
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::insert(typename Treap<Data>::value_type&& val) {
+  return this->insert(new node_type(val, this->priority()), this->root());
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::remove(const typename Treap<Data>::value_type& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::remove(typename Treap<Data>::value_type&& val) {
+  return this->remove(val, this->root());
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::find(const typename Treap<Data>::value_type& val) const {
+  return this->find(val, this->root());
+}
+
+template <typename Data>
+constexpr typename Treap<Data>::node_type*
+Treap<Data>::find(typename Treap<Data>::value_type&& val) const {
+  return this->find(val, this->root());
+}
+
+template <typename Data>
+constexpr Treap<Data>::~Treap() {
+  if (this->root()) {
+    delete this->root();
+  }
+}
+
+} /// namespace sal
+
+#endif /// SAL_TREAP_HH_
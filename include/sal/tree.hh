@@ -2,13 +2,25 @@
 #define SAL_TREE_HH_
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
 #include <typeinfo>
 #include <vector>
 #include <stack>
+#include <utility>
 
 namespace sal {
 
+/// the optional parts of Tree are defined with these, in snapshot.hh,
+/// parallel.hh and wal.hh, so that a plain Tree includes none of them
+class ThreadPool;
+template <typename Data>
+class Wal;
+namespace snapshot {
+enum class Encoding : std::uint32_t;
+} /// namespace snapshot
+
 template <template <typename, typename...> class Algorithm,
           typename Data, typename... Args>
 concept TreeAlgorithm = requires(Algorithm<Data, Args...> a, Data d) {
@@ -23,8 +35,19 @@ class Tree {
 public:
   using data_type = Data;
   using tree_type = Algorithm<data_type>;
+  using wal_type = Wal<data_type>;
   constexpr Tree() = default;
   constexpr Tree(std::initializer_list<data_type>&&);
+  /// a copy is not logged, a tree assigned to is detached from its log
+  constexpr Tree(const Tree&);
+  constexpr Tree& operator=(const Tree&);
+  /*!
+   * @brief takes over the values and the log of other, the log this tree
+   *        was attached to is closed
+   * @note not while inserts or removes are running on either tree
+   */
+  constexpr Tree(Tree&&);
+  constexpr Tree& operator=(Tree&&);
   constexpr bool insert(const data_type&);
   constexpr bool insert(data_type&&);
   constexpr bool remove(const data_type&);
@@ -34,6 +57,52 @@ public:
   constexpr std::size_t size() const;
   constexpr bool empty() const;
   constexpr std::vector<typename tree_type::value_type> bfs() const;
+  /*!
+   * @brief writes the values in order to a std::ostream or a file
+   *        descriptor, Encoding::PACKED compresses integers, the default
+   *        is Encoding::RAW
+   * @note defined in snapshot.hh, as is load()
+   */
+  template <typename Sink>
+  bool save(Sink&&, snapshot::Encoding = snapshot::Encoding{}) const;
+  /*!
+   * @brief replaces the values with those of a snapshot, the algorithm
+   *        builds its tree balanced in O(n)
+   * @note the replaced values are not logged, the tree is detached from its
+   *       log first; attach() it again after the load
+   * @return false, leaving the tree empty, for an unusable snapshot
+   */
+  template <typename Source>
+  bool load(Source&&);
+  /*!
+   * @brief replaces the values with those of values, the algorithm sorts
+   *        and deduplicates them, then builds its tree balanced, all on the
+   *        threads of pool, instead of inserting them one by one
+   * @note not logged, the tree is detached from its log first
+   */
+  void build(std::vector<data_type> values, ThreadPool& pool);
+  /*!
+   * @brief opens the log at path through wal, replays it on top of the
+   *        values, e.g. those of a snapshot just loaded, then logs every
+   *        insert and remove, which return once their record is durable
+   *
+   * inserts and removes may then come from several threads, they are
+   * serialized by the log and committed in groups; finds still need them
+   * to be done
+   * @note defined in wal.hh
+   * @return false, leaving the tree unlogged, when the log cannot be opened
+   */
+  bool attach(wal_type& wal, const char* path);
+  /*!
+   * @brief closes the log, once the records appended are durable
+   */
+  void detach();
+  /*!
+   * @brief whether the tree is attached to a log that has not failed, after
+   *        a false insert() or remove() this tells a failed log apart from
+   *        a value present or missing
+   */
+  bool logged() const;
   template <typename T>
   requires std::convertible_to<
       std::remove_cv_t<std::remove_reference_t<T>>,
@@ -43,10 +112,49 @@ public:
   constexpr Tree operator+(Tree&&) const;
   constexpr Tree operator+(std::initializer_list<data_type>&&) const;
   /// !! operator-
+  /*!
+   * @brief values in this tree or in other, the trees flattened, split by
+   *        one another in ranges of about grain values merged on the
+   *        threads of pool, then built balanced, for algorithms with a
+   *        build(), RBTree and AATree
+   * @param grain 0 for parallel::GRAIN
+   * @note defined in parallel.hh, as are the other parallel operations
+   */
+  Tree parallelUnion(const Tree& other, ThreadPool& pool,
+      std::size_t grain = 0) const;
+  /*!
+   * @brief values in this tree and in other, see parallelUnion()
+   */
+  Tree parallelIntersection(const Tree& other, ThreadPool& pool,
+      std::size_t grain = 0) const;
+  /*!
+   * @brief values in this tree not in other, see parallelUnion()
+   */
+  Tree parallelDifference(const Tree& other, ThreadPool& pool,
+      std::size_t grain = 0) const;
   virtual ~Tree() = default;
 protected:
+  /*!
+   * @brief tree of the values of op(pool, a, b, grain), a and b those of
+   *        this tree and other
+   */
+  template <typename Op>
+  Tree combine(const Tree& other, ThreadPool& pool, std::size_t grain,
+      Op op) const;
+  /*!
+   * @brief calls of a tree into its log, filled in by attach() so that a
+   *        tree never attached needs no definition of Wal
+   */
+  struct Logger {
+    bool (*log)(Tree&, bool inserting, const data_type&);
+    void (*close)(wal_type&);
+    bool (*good)(const wal_type&);
+  };
+  bool log(bool inserting, const data_type&);
   tree_type algo_;
   std::size_t size_ = 0;
+  wal_type* wal_ = nullptr;
+  const Logger* logger_ = nullptr;
 private:
 };
 
@@ -62,9 +170,53 @@ constexpr Tree<Data, Algorithm>::Tree(std::initializer_list<data_type>&& list) {
   }
 }
 
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+constexpr Tree<Data, Algorithm>::Tree(const Tree& other)
+  : algo_(other.algo_), size_(other.size_) {}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+constexpr Tree<Data, Algorithm>&
+Tree<Data, Algorithm>::operator=(const Tree& other) {
+  if (this != &other) {
+    this->detach();
+    this->algo_ = other.algo_;
+    this->size_ = other.size_;
+  }
+  return *this;
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+constexpr Tree<Data, Algorithm>::Tree(Tree&& other)
+  : algo_(std::move(other.algo_)),
+    size_(std::exchange(other.size_, 0)),
+    wal_(std::exchange(other.wal_, nullptr)),
+    logger_(std::exchange(other.logger_, nullptr)) {}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+constexpr Tree<Data, Algorithm>&
+Tree<Data, Algorithm>::operator=(Tree&& other) {
+  if (this != &other) {
+    if (this->wal_ != other.wal_) {
+      this->detach();
+    }
+    this->algo_ = std::move(other.algo_);
+    this->size_ = std::exchange(other.size_, 0);
+    this->wal_ = std::exchange(other.wal_, nullptr);
+    this->logger_ = std::exchange(other.logger_, nullptr);
+  }
+  return *this;
+}
+
 template <typename Data, template <typename, typename...> class Algorithm>
 requires TreeAlgorithm<Algorithm, Data>
 constexpr bool Tree<Data, Algorithm>::insert(const data_type& d) {
+  if (this->wal_) {
+    return this->logger_->log(*this, true, d);
+  }
   if (!this->find(d)) {
     this->algo_.insert(d);
     this->size_++;
@@ -76,6 +228,9 @@ constexpr bool Tree<Data, Algorithm>::insert(const data_type& d) {
 template <typename Data, template <typename, typename...> class Algorithm>
 requires TreeAlgorithm<Algorithm, Data>
 constexpr bool Tree<Data, Algorithm>::insert(data_type&& d) {
+  if (this->wal_) {
+    return this->logger_->log(*this, true, d);
+  }
   if (!this->find(d)) {
     this->algo_.insert(d);
     this->size_++;
@@ -87,6 +242,9 @@ constexpr bool Tree<Data, Algorithm>::insert(data_type&& d) {
 template <typename Data, template <typename, typename...> class Algorithm>
 requires TreeAlgorithm<Algorithm, Data>
 constexpr bool Tree<Data, Algorithm>::remove(const data_type& d) {
+  if (this->wal_) {
+    return this->logger_->log(*this, false, d);
+  }
   if (this->find(d)) {
     this->algo_.remove(d);
     this->size_--;
@@ -98,6 +256,9 @@ constexpr bool Tree<Data, Algorithm>::remove(const data_type& d) {
 template <typename Data, template <typename, typename...> class Algorithm>
 requires TreeAlgorithm<Algorithm, Data>
 constexpr bool Tree<Data, Algorithm>::remove(data_type&& d) {
+  if (this->wal_) {
+    return this->logger_->log(*this, false, d);
+  }
   if (this->find(d)) {
     this->algo_.remove(d);
     this->size_--;
@@ -205,6 +366,32 @@ Tree<Data, Algorithm>::operator+(
   return tree;
 }
 
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+void Tree<Data, Algorithm>::build(
+    std::vector<data_type> values,
+    ThreadPool& pool
+) {
+  this->detach();
+  this->size_ = this->algo_.build(std::move(values), pool);
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+void Tree<Data, Algorithm>::detach() {
+  if (this->wal_) {
+    this->logger_->close(*this->wal_);
+  }
+  this->wal_ = nullptr;
+  this->logger_ = nullptr;
+}
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+bool Tree<Data, Algorithm>::logged() const {
+  return this->wal_ && this->logger_->good(*this->wal_);
+}
+
 } /// namespace sal
 
 #endif /// SAL_TREE_HH_
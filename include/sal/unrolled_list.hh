@@ -0,0 +1,334 @@
+#ifndef SAL_UNROLLED_LIST_HH_
+#define SAL_UNROLLED_LIST_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace sal {
+
+/*!
+ * @brief double linked list of chunks holding up to CAPACITY values each, a
+ *        chunk spans two cache lines, so a scan touches a line per several
+ *        values instead of one per value, and arithmetic values are compared
+ *        a whole chunk at a time in a loop the compiler vectorizes
+ * @note values keep the insertion order, a removal shifts the rest of its
+ *       chunk, merging it with the next one once both fit into one or else
+ *       refilling it from the next one below half, so every chunk but the
+ *       last stays at least half full
+ */
+template <typename Data>
+class UnrolledList {
+public:
+  using value_type = Data;
+  static constexpr std::size_t CHUNK_BYTES = 128;
+  class Chunk;
+  /// values per 16 byte vector, the capacity is a multiple of it so that
+  /// the chunk scan needs no scalar epilogue
+  static constexpr std::size_t LANES =
+      std::is_arithmetic_v<value_type> && sizeof(value_type) <= 8 ?
+          16 / sizeof(value_type) :
+          1;
+  static constexpr std::size_t CAPACITY = std::max<std::size_t>(
+      (CHUNK_BYTES - 2 * sizeof(Chunk*) - sizeof(std::uint32_t)) /
+          sizeof(value_type) / LANES * LANES,
+      1
+  );
+  class Chunk {
+  public:
+    constexpr Chunk* const & prev() const;
+    constexpr Chunk*& prev();
+    constexpr Chunk* const & next() const;
+    constexpr Chunk*& next();
+    constexpr std::size_t size() const;
+    constexpr const value_type* begin() const;
+    constexpr const value_type* end() const;
+  protected:
+    friend class UnrolledList;
+    value_type values_[CAPACITY]{};
+    std::uint32_t size_ = 0;
+    Chunk* prev_ = nullptr;
+    Chunk* next_ = nullptr;
+  private:
+  };
+  constexpr UnrolledList() = default;
+  UnrolledList(const UnrolledList&) = delete;
+  UnrolledList& operator=(const UnrolledList&) = delete;
+  constexpr UnrolledList(UnrolledList&&);
+  constexpr UnrolledList& operator=(UnrolledList&&);
+  constexpr Chunk* const & root() const;
+  constexpr Chunk* const & last() const;
+  constexpr std::size_t size() const;
+  constexpr value_type* add(const value_type&);
+  constexpr value_type* add(value_type&&);
+  /*!
+   * @return the first value equal to val, nullptr when absent
+   * @note the pointer is valid until the next del()
+   */
+  constexpr value_type* get(const value_type&);
+  constexpr const value_type* get(const value_type&) const;
+  constexpr bool del(const value_type&);
+  virtual ~UnrolledList();
+protected:
+  constexpr static std::size_t find(const Chunk*, const value_type&);
+  constexpr std::pair<Chunk*, std::size_t> find(const value_type&) const;
+  constexpr void unlink(Chunk*);
+  constexpr void clear();
+  Chunk* root_ = nullptr;
+  Chunk* last_ = nullptr;
+  std::size_t size_ = 0;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk* const &
+UnrolledList<Data>::Chunk::prev() const {
+  return this->prev_;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk*&
+UnrolledList<Data>::Chunk::prev() {
+  return this->prev_;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk* const &
+UnrolledList<Data>::Chunk::next() const {
+  return this->next_;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk*&
+UnrolledList<Data>::Chunk::next() {
+  return this->next_;
+}
+
+template <typename Data>
+constexpr std::size_t UnrolledList<Data>::Chunk::size() const {
+  return this->size_;
+}
+
+template <typename Data>
+constexpr const typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::Chunk::begin() const {
+  return this->values_;
+}
+
+template <typename Data>
+constexpr const typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::Chunk::end() const {
+  return this->values_ + this->size_;
+}
+
+template <typename Data>
+constexpr UnrolledList<Data>::UnrolledList(UnrolledList&& other)
+  : root_(std::exchange(other.root_, nullptr)),
+    last_(std::exchange(other.last_, nullptr)),
+    size_(std::exchange(other.size_, 0)) {}
+
+template <typename Data>
+constexpr UnrolledList<Data>& UnrolledList<Data>::operator=(
+    UnrolledList&& other
+) {
+  if (this != &other) {
+    this->clear();
+    this->root_ = std::exchange(other.root_, nullptr);
+    this->last_ = std::exchange(other.last_, nullptr);
+    this->size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk* const &
+UnrolledList<Data>::root() const {
+  return this->root_;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::Chunk* const &
+UnrolledList<Data>::last() const {
+  return this->last_;
+}
+
+template <typename Data>
+constexpr std::size_t UnrolledList<Data>::size() const {
+  return this->size_;
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::add(const typename UnrolledList<Data>::value_type& val) {
+  return this->add(value_type(val));
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::add(typename UnrolledList<Data>::value_type&& val) {
+  if (!this->last_ || this->last_->size_ == CAPACITY) {
+    auto* chunk = new Chunk();
+    chunk->prev_ = this->last_;
+    if (this->last_) {
+      this->last_->next_ = chunk;
+    } else {
+      this->root_ = chunk;
+    }
+    this->last_ = chunk;
+  }
+  auto* slot = this->last_->values_ + this->last_->size_++;
+  *slot = std::move(val);
+  this->size_++;
+  return slot;
+}
+
+/*!
+ * @return index of the first value equal to val in chunk, CAPACITY when
+ *         absent
+ * @note for arithmetic values every slot is compared without an early exit
+ *       over the fixed CAPACITY, which lets the loop vectorize, slots past
+ *       the size are masked out
+ */
+template <typename Data>
+constexpr std::size_t UnrolledList<Data>::find(
+    const Chunk* chunk,
+    const typename UnrolledList<Data>::value_type& val
+) {
+  if constexpr (LANES > 1) {
+    /// index and mask as wide as a value, so both share the vector lanes
+    using lane_type = std::conditional_t<
+        sizeof(value_type) == 1, std::uint8_t, std::conditional_t<
+        sizeof(value_type) == 2, std::uint16_t, std::conditional_t<
+        sizeof(value_type) == 4, std::uint32_t, std::uint64_t>>>;
+    const auto size = static_cast<lane_type>(chunk->size_);
+    lane_type any = 0;
+    for (lane_type i = 0; i < CAPACITY; i++) {
+      any |= (chunk->values_[i] == val) & (i < size);
+    }
+    if (!any) {
+      return CAPACITY;
+    }
+  }
+  for (std::size_t i = 0; i < chunk->size_; i++) {
+    if (chunk->values_[i] == val) {
+      return i;
+    }
+  }
+  return CAPACITY;
+}
+
+template <typename Data>
+constexpr std::pair<typename UnrolledList<Data>::Chunk*, std::size_t>
+UnrolledList<Data>::find(
+    const typename UnrolledList<Data>::value_type& val
+) const {
+  for (auto* chunk = this->root_; chunk; chunk = chunk->next_) {
+    const auto i = find(chunk, val);
+    if (i != CAPACITY) {
+      return {chunk, i};
+    }
+  }
+  return {nullptr, CAPACITY};
+}
+
+template <typename Data>
+constexpr typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::get(const typename UnrolledList<Data>::value_type& val) {
+  const auto [chunk, i] = this->find(val);
+  return chunk ? chunk->values_ + i : nullptr;
+}
+
+template <typename Data>
+constexpr const typename UnrolledList<Data>::value_type*
+UnrolledList<Data>::get(
+    const typename UnrolledList<Data>::value_type& val
+) const {
+  const auto [chunk, i] = this->find(val);
+  return chunk ? chunk->values_ + i : nullptr;
+}
+
+template <typename Data>
+constexpr void UnrolledList<Data>::unlink(Chunk* chunk) {
+  if (chunk->prev_) {
+    chunk->prev_->next_ = chunk->next_;
+  } else {
+    this->root_ = chunk->next_;
+  }
+  if (chunk->next_) {
+    chunk->next_->prev_ = chunk->prev_;
+  } else {
+    this->last_ = chunk->prev_;
+  }
+}
+
+template <typename Data>
+constexpr bool UnrolledList<Data>::del(
+    const typename UnrolledList<Data>::value_type& val
+) {
+  const auto [chunk, i] = this->find(val);
+  if (!chunk) {
+    return false;
+  }
+  std::move(
+      chunk->values_ + i + 1,
+      chunk->values_ + chunk->size_,
+      chunk->values_ + i
+  );
+  chunk->size_--;
+  this->size_--;
+  auto* next = chunk->next_;
+  if (!chunk->size_) {
+    this->unlink(chunk);
+    delete chunk;
+  } else if (next && chunk->size_ + next->size_ <= CAPACITY) {
+    std::move(
+        next->values_,
+        next->values_ + next->size_,
+        chunk->values_ + chunk->size_
+    );
+    chunk->size_ += next->size_;
+    this->unlink(next);
+    delete next;
+  } else if (next && chunk->size_ < CAPACITY / 2) {
+    /// borrowing keeps both above half full, the next one held more than
+    /// CAPACITY - size values
+    const auto take = CAPACITY / 2 - chunk->size_;
+    std::move(
+        next->values_,
+        next->values_ + take,
+        chunk->values_ + chunk->size_
+    );
+    std::move(
+        next->values_ + take,
+        next->values_ + next->size_,
+        next->values_
+    );
+    chunk->size_ += take;
+    next->size_ -= take;
+  }
+  return true;
+}
+
+template <typename Data>
+constexpr void UnrolledList<Data>::clear() {
+  while (this->root_) {
+    delete std::exchange(this->root_, this->root_->next_);
+  }
+  this->last_ = nullptr;
+  this->size_ = 0;
+}
+
+template <typename Data>
+UnrolledList<Data>::~UnrolledList() {
+  this->clear();
+}
+
+} /// namespace sal
+
+#endif /// SAL_UNROLLED_LIST_HH_
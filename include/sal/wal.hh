@@ -0,0 +1,440 @@
+#ifndef SAL_WAL_HH_
+#define SAL_WAL_HH_
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sal/snapshot.hh>
+#include <sal/tree.hh>
+
+namespace sal {
+
+/*!
+ * @brief write ahead log of inserts and removes, appended by any number of
+ *        threads and committed in groups, one write and one fdatasync per
+ *        group, by a thread of its own
+ *
+ * the log is a header followed by the groups, each its size, the checksum
+ * of its records and the records, an op byte and the value by its Codec:
+ *
+ *   u64 magic | u32 version | u32 value size |
+ *   { u64 size | u64 sum | { u8 op | value }... }...
+ *
+ * a group is closed once it holds Options::group records or its first one
+ * waited Options::latency; a torn or corrupt group ends the log, it is cut
+ * off when the log is opened again
+ */
+template <typename Data>
+class Wal {
+public:
+  using value_type = Data;
+  static constexpr std::uint64_t MAGIC = 0x31304c41574c4153; /// "SALWAL01"
+  static constexpr std::uint32_t VERSION = 1;
+  enum class Op : std::uint8_t {
+    INSERT = 1,
+    REMOVE = 2,
+  };
+  struct Options {
+    /// longest wait of a record for others to share its group
+    std::chrono::microseconds latency{1000};
+    /// records that close a group at once
+    std::size_t group = 64;
+    /// false skips fdatasync, the groups then survive a crash of the
+    /// process but not of the system
+    bool sync = true;
+  };
+  struct Header {
+    std::uint64_t magic = MAGIC;
+    std::uint32_t version = VERSION;
+    std::uint32_t valueSize = snapshot::Codec<value_type>::RAW_SIZE;
+  };
+  Wal() : Wal(Options{}) {}
+  explicit Wal(Options);
+  Wal(const Wal&) = delete;
+  Wal& operator=(const Wal&) = delete;
+  /*!
+   * @brief opens or creates the log at path, calling f(op, value) for
+   *        every record committed so far, before any append
+   * @return false, leaving the log closed, for a file that is no log of
+   *         this value type
+   */
+  template <typename F>
+  bool open(const char* path, F&& f);
+  bool open(const char* path);
+  /*!
+   * @brief commits the records appended so far and closes the log
+   */
+  void close();
+  bool good() const;
+  /*!
+   * @brief serializes appends, and whatever has to happen in the order of
+   *        the records, e.g. the changes they log
+   */
+  std::mutex& mutex();
+  /*!
+   * @brief queues a record for the next group, with mutex() held
+   * @return sequence number of the record to wait() for, 0 when the log is
+   *         closed or failed
+   */
+  std::uint64_t append(Op, const value_type&);
+  /*!
+   * @brief waits for the group of the record lsn to be written, without
+   *        mutex() held
+   * @return false when the log failed
+   */
+  bool wait(std::uint64_t lsn);
+  /*!
+   * @brief empties the log once what was appended is committed, e.g. after
+   *        a snapshot of the tree it logs
+   */
+  bool truncate();
+  /*!
+   * @brief groups committed since the log was opened
+   */
+  std::uint64_t groups() const;
+  virtual ~Wal();
+protected:
+  /*!
+   * @brief bytes appended to a string, for Codec
+   */
+  struct Buffer {
+    bool write(const void* data, std::size_t size) {
+      this->bytes.append(static_cast<const char*>(data), size);
+      return true;
+    }
+    std::string bytes;
+  };
+  /*!
+   * @brief bytes read from a string, for Codec
+   */
+  struct View {
+    bool read(void* data, std::size_t size) {
+      if (size > this->bytes.size() - this->offset) {
+        return false;
+      }
+      std::memcpy(data, this->bytes.data() + this->offset, size);
+      this->offset += size;
+      return true;
+    }
+    const std::string& bytes;
+    std::size_t offset = 0;
+  };
+  void flusher();
+  bool commit(const std::vector<std::pair<Op, value_type>>&);
+  Options options_;
+  int fd_ = -1;
+  mutable std::mutex mutex_;
+  /// wakes the writers waiting for their group
+  std::condition_variable committed_;
+  /// wakes the flusher for a new or a full group
+  std::condition_variable pending_;
+  std::vector<std::pair<Op, value_type>> records_;
+  std::uint64_t appended_ = 0;
+  std::uint64_t durable_ = 0;
+  std::uint64_t groups_ = 0;
+  Buffer buffer_;
+  std::thread thread_;
+  bool good_ = false;
+  bool stop_ = false;
+private:
+};
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data>
+Wal<Data>::Wal(Options options) : options_(options) {}
+
+template <typename Data>
+template <typename F>
+bool Wal<Data>::open(const char* path, F&& f) {
+  this->close();
+  const auto fd = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st{};
+  Header header;
+  const Header expected;
+  bool ok = ::fstat(fd, &st) == 0;
+  const auto bytes = static_cast<std::size_t>(st.st_size);
+  if (ok && bytes < sizeof(Header)) {
+    ok = ::ftruncate(fd, 0) == 0 &&
+        ::pwrite(fd, &expected, sizeof(expected), 0) == sizeof(expected) &&
+        ::fdatasync(fd) == 0;
+  } else if (ok) {
+    ok = ::pread(fd, &header, sizeof(header), 0) == sizeof(header) &&
+        std::memcmp(&header, &expected, sizeof(header)) == 0;
+  }
+  /// the groups up to the first torn or corrupt one
+  std::size_t end = sizeof(Header);
+  if (ok && ::lseek(fd, end, SEEK_SET) == off_t(end)) {
+    snapshot::Reader reader(fd);
+    std::string payload;
+    std::uint64_t frame[2]{};
+    std::vector<std::pair<Op, value_type>> records;
+    while (reader.read(frame, sizeof(frame)) &&
+        frame[0] <= bytes - end - sizeof(frame)) {
+      payload.resize(frame[0]);
+      snapshot::Checksum checksum;
+      if (!reader.read(payload.data(), payload.size())) {
+        break;
+      }
+      checksum.update(payload.data(), payload.size());
+      if (checksum.value() != frame[1]) {
+        break;
+      }
+      View view{payload};
+      records.clear();
+      for (Op op; view.offset < payload.size();) {
+        value_type val;
+        if (!view.read(&op, sizeof(op)) ||
+            !snapshot::Codec<value_type>::read(view, val)) {
+          break;
+        }
+        records.emplace_back(op, std::move(val));
+      }
+      if (view.offset != payload.size()) {
+        break;
+      }
+      for (const auto& [op, val] : records) {
+        f(op, val);
+      }
+      end += sizeof(frame) + payload.size();
+    }
+    ok = ::ftruncate(fd, end) == 0 &&
+        ::lseek(fd, end, SEEK_SET) == off_t(end);
+  }
+  if (!ok) {
+    ::close(fd);
+    return false;
+  }
+  this->fd_ = fd;
+  this->good_ = true;
+  this->stop_ = false;
+  this->appended_ = 0;
+  this->durable_ = 0;
+  this->groups_ = 0;
+  this->thread_ = std::thread([this] { this->flusher(); });
+  return true;
+}
+
+template <typename Data>
+bool Wal<Data>::open(const char* path) {
+  return this->open(path, [](Op, const value_type&) {});
+}
+
+template <typename Data>
+void Wal<Data>::close() {
+  if (this->thread_.joinable()) {
+    {
+      std::lock_guard lock(this->mutex_);
+      this->stop_ = true;
+    }
+    this->pending_.notify_one();
+    this->thread_.join();
+  }
+  if (this->fd_ >= 0) {
+    ::close(this->fd_);
+  }
+  this->fd_ = -1;
+  this->good_ = false;
+}
+
+template <typename Data>
+bool Wal<Data>::good() const {
+  std::lock_guard lock(this->mutex_);
+  return this->good_;
+}
+
+template <typename Data>
+std::mutex& Wal<Data>::mutex() {
+  return this->mutex_;
+}
+
+template <typename Data>
+std::uint64_t Wal<Data>::append(Op op, const value_type& val) {
+  if (!this->good_ || this->stop_) {
+    return 0;
+  }
+  this->records_.emplace_back(op, val);
+  /// the flusher waits for the first record, then for a full group
+  if (this->records_.size() == 1 ||
+      this->records_.size() == this->options_.group) {
+    this->pending_.notify_one();
+  }
+  return ++this->appended_;
+}
+
+template <typename Data>
+bool Wal<Data>::wait(std::uint64_t lsn) {
+  std::unique_lock lock(this->mutex_);
+  this->committed_.wait(lock, [&] {
+    return this->durable_ >= lsn || !this->good_;
+  });
+  return this->durable_ >= lsn;
+}
+
+template <typename Data>
+bool Wal<Data>::truncate() {
+  std::unique_lock lock(this->mutex_);
+  this->committed_.wait(lock, [&] {
+    return this->durable_ == this->appended_ || !this->good_;
+  });
+  this->good_ = this->good_ &&
+      ::ftruncate(this->fd_, sizeof(Header)) == 0 &&
+      ::lseek(this->fd_, sizeof(Header), SEEK_SET) == sizeof(Header) &&
+      (!this->options_.sync || ::fdatasync(this->fd_) == 0);
+  return this->good_;
+}
+
+template <typename Data>
+std::uint64_t Wal<Data>::groups() const {
+  std::lock_guard lock(this->mutex_);
+  return this->groups_;
+}
+
+/*!
+ * @note the records are swapped out under the lock and written without it,
+ *       so the next group fills while this one is on its way to the disk
+ */
+template <typename Data>
+void Wal<Data>::flusher() {
+  std::vector<std::pair<Op, value_type>> group;
+  std::unique_lock lock(this->mutex_);
+  while (true) {
+    this->pending_.wait(lock, [&] {
+      return this->stop_ || !this->records_.empty();
+    });
+    if (this->records_.empty()) {
+      return;
+    }
+    this->pending_.wait_for(lock, this->options_.latency, [&] {
+      return this->stop_ || this->records_.size() >= this->options_.group;
+    });
+    group.swap(this->records_);
+    const auto last = this->appended_;
+    lock.unlock();
+    const auto ok = this->commit(group);
+    group.clear();
+    lock.lock();
+    if (ok) {
+      this->durable_ = last;
+      this->groups_++;
+    }
+    this->good_ = this->good_ && ok;
+    this->committed_.notify_all();
+  }
+}
+
+template <typename Data>
+bool Wal<Data>::commit(const std::vector<std::pair<Op, value_type>>& group) {
+  auto& bytes = this->buffer_.bytes;
+  bytes.assign(2 * sizeof(std::uint64_t), '\0');
+  for (const auto& [op, val] : group) {
+    this->buffer_.write(&op, sizeof(op));
+    snapshot::Codec<value_type>::write(this->buffer_, val);
+  }
+  snapshot::Checksum checksum;
+  checksum.update(bytes.data() + 16, bytes.size() - 16);
+  const std::uint64_t frame[2] = {bytes.size() - 16, checksum.value()};
+  std::memcpy(bytes.data(), frame, sizeof(frame));
+  for (std::size_t done = 0; done < bytes.size();) {
+    const auto written =
+        ::write(this->fd_, bytes.data() + done, bytes.size() - done);
+    if (written < 0 && errno != EINTR) {
+      return false;
+    } else if (written > 0) {
+      done += static_cast<std::size_t>(written);
+    }
+  }
+  return !this->options_.sync || ::fdatasync(this->fd_) == 0;
+}
+
+template <typename Data>
+Wal<Data>::~Wal() {
+  this->close();
+}
+
+} /// namespace sal
+
+namespace sal {
+
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+bool Tree<Data, Algorithm>::attach(wal_type& wal, const char* path) {
+  static constexpr Logger logger = {
+      [](Tree& tree, bool inserting, const data_type& d) {
+        return tree.log(inserting, d);
+      },
+      [](wal_type& wal) { wal.close(); },
+      [](const wal_type& wal) { return wal.good(); },
+  };
+  this->detach();
+  const auto opened = wal.open(
+      path,
+      [this](typename wal_type::Op op, const data_type& d) {
+        if (op == wal_type::Op::INSERT) {
+          this->insert(d);
+        } else {
+          this->remove(d);
+        }
+      }
+  );
+  if (opened) {
+    this->wal_ = &wal;
+    this->logger_ = &logger;
+  }
+  return opened;
+}
+
+/*!
+ * @brief logs an insert or a remove that changes the tree and applies it,
+ *        the record is appended in the order of the changes, then waited
+ *        for without holding the log
+ * @return false as well when the log failed: before the append the change
+ *         is not applied, after it the change is applied but may not
+ *         survive a restart; logged() is false either way
+ */
+template <typename Data, template <typename, typename...> class Algorithm>
+requires TreeAlgorithm<Algorithm, Data>
+bool Tree<Data, Algorithm>::log(bool inserting, const data_type& d) {
+  std::unique_lock lock(this->wal_->mutex());
+  if (this->find(d) == inserting) {
+    return false;
+  }
+  const auto lsn = this->wal_->append(
+      inserting ? wal_type::Op::INSERT : wal_type::Op::REMOVE,
+      d
+  );
+  if (!lsn) {
+    return false;
+  }
+  if (inserting) {
+    this->algo_.insert(d);
+    this->size_++;
+  } else {
+    this->algo_.remove(d);
+    this->size_--;
+  }
+  lock.unlock();
+  return this->wal_->wait(lsn);
+}
+
+} /// namespace sal
+
+#endif /// SAL_WAL_HH_
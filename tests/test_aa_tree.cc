@@ -1,6 +1,24 @@
 #include <sal/aa_tree.hh>
 #include <sal/tree.hh>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+
+template <typename Node>
+void check(const Node* node) {
+  if (!node) {
+    return;
+  }
+  if (node->left()) {
+    assert(node->left()->value() < node->value());
+  }
+  if (node->right()) {
+    assert(node->value() < node->right()->value());
+  }
+  check(node->left());
+  check(node->right());
+}
 
 int main() {
   using data_type = int;
@@ -566,5 +584,47 @@ int main() {
     assert(dst.root()->right()->value() == 1);
   }
 
+  {
+    /// removals relink nodes, the surviving ones keep their addresses
+    Tree tree;
+    for (auto i = -3; i <= 3; i++) {
+      tree.insert(i);
+    }
+    auto* root = tree.root();
+    assert(root->value() == 0);
+    auto* predecessor = tree.find(-1);
+    auto* three = tree.find(3);
+    tree.remove(0);
+    assert(tree.root() == predecessor);
+    assert(tree.root()->value() == -1);
+    assert(tree.find(3) == three);
+    check<Tree::node_type>(tree.root());
+  }
+  {
+    std::srand(1);
+    Tree tree;
+    std::set<int> reference;
+    for (auto i = 0; i < 1 << 14; i++) {
+      const auto val = std::rand() % 512;
+      if (reference.count(val)) {
+        auto* other = reference.size() > 1 ?
+            tree.find(val == *reference.begin() ? *reference.rbegin() :
+                *reference.begin()) :
+            nullptr;
+        const auto otherValue = other ? other->value() : 0;
+        tree.remove(val);
+        reference.erase(val);
+        assert(!other || tree.find(otherValue) == other);
+      } else {
+        tree.insert(val);
+        reference.insert(val);
+      }
+      check<Tree::node_type>(tree.root());
+    }
+    for (auto val = 0; val < 512; val++) {
+      assert(static_cast<bool>(tree.find(val)) == reference.count(val));
+    }
+  }
+
   return 0;
 }
@@ -0,0 +1,118 @@
+#include <sal/avl_tree.hh>
+#include <sal/tree.hh>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+
+template <typename Node>
+std::size_t check(
+    const Node* node,
+    const std::type_identity_t<Node>* lo = nullptr,
+    const std::type_identity_t<Node>* hi = nullptr
+) {
+  if (!node) {
+    return 0;
+  }
+  assert(!lo || lo->value() < node->value());
+  assert(!hi || node->value() < hi->value());
+  const auto l = check<Node>(node->left(), lo, node);
+  const auto r = check<Node>(node->right(), node, hi);
+  assert(l <= r + 1 && r <= l + 1);
+  assert(node->height() == std::max(l, r) + 1);
+  return node->height();
+}
+
+int main() {
+  using data_type = int;
+  using Tree = sal::AVLTree<data_type>;
+
+  {
+    auto tree = Tree();
+    assert(tree.root() == nullptr);
+    assert(!tree.find(0));
+    assert(!tree.remove(0));
+    tree.insert(0);
+    assert(tree.root());
+    assert(tree.root()->value() == 0);
+    assert(tree.root()->height() == 1);
+    tree.insert(1);
+    assert(tree.root()->value() == 0);
+    assert(tree.root()->height() == 2);
+    assert(tree.root()->right());
+    assert(tree.root()->right()->value() == 1);
+    tree.insert(2);
+    assert(tree.root()->value() == 1);
+    assert(tree.root()->height() == 2);
+    assert(tree.root()->left());
+    assert(tree.root()->left()->value() == 0);
+    assert(tree.root()->right());
+    assert(tree.root()->right()->value() == 2);
+    tree.insert(-2);
+    tree.insert(-1);
+    assert(tree.root()->value() == 1);
+    assert(tree.root()->height() == 3);
+    assert(tree.root()->left());
+    assert(tree.root()->left()->value() == -1);
+    assert(tree.root()->left()->left());
+    assert(tree.root()->left()->left()->value() == -2);
+    assert(tree.root()->left()->right());
+    assert(tree.root()->left()->right()->value() == 0);
+    /// the successor node takes over, so other nodes keep their addresses
+    auto* two = tree.find(2);
+    tree.remove(1);
+    assert(!tree.find(1));
+    assert(tree.find(2) == two);
+    assert(tree.root()->value() == -1);
+    check(std::as_const(tree).root());
+    tree.remove(-1);
+    tree.remove(-2);
+    tree.remove(0);
+    tree.remove(2);
+    assert(!tree.root());
+  }
+  {
+    auto tree = Tree();
+    constexpr auto N = 4096;
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+    }
+    /// a perfectly balanced tree of 4096 nodes has a height of 13
+    assert(check(std::as_const(tree).root()) == 13);
+    std::srand(1);
+    for (auto i = 0; i < N; i++) {
+      const auto val = std::rand() % N;
+      if (tree.find(val)) {
+        tree.remove(val);
+        assert(!tree.find(val));
+      } else {
+        tree.insert(val);
+        assert(tree.find(val));
+      }
+    }
+    check(std::as_const(tree).root());
+  }
+  {
+    Tree src;
+    src.insert(0);
+    src.insert(1);
+    Tree dst = src;
+    dst.remove(0);
+    assert(src.find(0));
+    assert(!dst.find(0));
+    const Tree moved = std::move(dst);
+    assert(!dst.root());
+    assert(moved.find(1));
+  }
+  {
+    using Facade = sal::Tree<data_type, sal::AVLTree>;
+    Facade tree = {-3, -2, -1, 0, 1, 2, 3};
+    assert(tree.size() == 7);
+    assert(!tree.insert(0));
+    assert(tree.remove(0));
+    assert(!tree.remove(0));
+    assert(tree.size() == 6);
+  }
+
+  return 0;
+}
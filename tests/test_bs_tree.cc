@@ -1,5 +1,28 @@
 #include <sal/bs_tree.hh>
+#include <sal/tree.hh>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+
+template <typename Node>
+std::size_t height(
+    const Node* node,
+    const std::type_identity_t<Node>* parent = nullptr
+) {
+  if (!node) {
+    return 0;
+  }
+  assert(node->parent() == parent);
+  assert(!node->left() || node->left()->value() < node->value());
+  assert(!node->right() || node->value() < node->right()->value());
+  return std::max(
+      height<Node>(node->left(), node),
+      height<Node>(node->right(), node)
+  ) + 1;
+}
 
 int main() {
   using data_type = int;
@@ -183,6 +206,145 @@ int main() {
     assert(!tree.find(4));
     assert(!tree.find(-4));
   }
+  {
+    /// removals keep the parent links consistent
+    auto tree = Tree();
+    for (const auto val : {8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7}) {
+      tree.insert(val);
+    }
+    tree.remove(4);
+    assert(tree.root()->left()->value() == 3);
+    assert(tree.root()->left()->parent() == tree.root());
+    assert(tree.root()->left()->left()->parent() == tree.root()->left());
+    assert(tree.root()->left()->right()->parent() == tree.root()->left());
+    assert(tree.root()->left()->left()->right() == nullptr);
+    tree.remove(2);
+    assert(tree.root()->left()->left()->value() == 1);
+    assert(tree.root()->left()->left()->parent() == tree.root()->left());
+    tree.remove(8);
+    assert(tree.root()->value() == 7);
+    assert(tree.root()->parent() == nullptr);
+    assert(tree.root()->left()->parent() == tree.root());
+    assert(tree.root()->right()->parent() == tree.root());
+    assert(tree.root()->left()->right()->value() == 6);
+    assert(tree.root()->left()->right()->left()->parent() ==
+        tree.root()->left()->right());
+    for (const auto val : {1, 3, 5, 6, 7, 10, 12, 14}) {
+      assert(tree.find(val));
+      tree.remove(val);
+      assert(!tree.find(val));
+    }
+    assert(tree.root() == nullptr);
+  }
+  {
+    /// without automatic rebuilds sorted keys make a vine, dsw fixes it
+    auto tree = Tree();
+    tree.factor() = 0;
+    constexpr auto N = 1023;
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+    }
+    assert(tree.size() == N);
+    assert(height(std::as_const(tree).root()) == N);
+    tree.rebalance();
+    assert(height(std::as_const(tree).root()) == 10);
+    assert(tree.root()->value() == N / 2);
+    for (auto i = 0; i < N; i++) {
+      assert(tree.find(i));
+    }
+    assert(!tree.find(N));
+    tree.insert(N);
+    tree.rebalance();
+    assert(height(std::as_const(tree).root()) == 11);
+  }
+  {
+    auto tree = Tree();
+    constexpr auto N = 1 << 12;
+    for (auto i = 0; i < N; i++) {
+      auto* inserted = tree.insert(i);
+      assert(inserted);
+      assert(inserted->value() == i);
+      assert(tree.find(i) == inserted);
+      const auto bound = tree.factor() * std::log2(tree.size() + 1);
+      assert(height(std::as_const(tree).root()) <= bound);
+    }
+    assert(tree.size() == N);
+    assert(!tree.insert(0));
+    assert(tree.size() == N);
+    std::srand(1);
+    for (auto i = 0; i < N; i++) {
+      const auto val = std::rand() % N;
+      if (tree.find(val)) {
+        tree.remove(val);
+        assert(!tree.find(val));
+      } else {
+        tree.insert(val);
+        assert(tree.find(val));
+      }
+    }
+    height(std::as_const(tree).root());
+    auto copy = tree;
+    height(std::as_const(copy).root());
+    assert(copy.size() == tree.size());
+    copy.rebalance();
+    height(std::as_const(copy).root());
+    const auto size = copy.size();
+    auto moved = std::move(copy);
+    assert(!copy.root() && copy.size() == 0);
+    assert(moved.size() == size);
+    height(std::as_const(moved).root());
+    copy = std::move(moved);
+    assert(!moved.root() && moved.size() == 0);
+    assert(copy.size() == size);
+    height(std::as_const(copy).root());
+  }
+  {
+    /// an empty tree assigned over a full one leaves it empty, and its size
+    /// bounds the depth of later inserts again
+    auto tree = Tree();
+    for (auto i = 0; i < 100; i++) {
+      tree.insert(i);
+    }
+    tree = Tree();
+    assert(!tree.root() && !tree.find(5) && tree.size() == 0);
+    for (auto i = 0; i < 100; i++) {
+      tree.insert(i);
+    }
+    const auto empty = Tree();
+    tree = empty;
+    assert(!tree.root() && !tree.find(5) && tree.size() == 0);
+    for (auto i = 0; i < 100; i++) {
+      tree.insert(i);
+      const auto bound = tree.factor() * std::log2(tree.size() + 1);
+      assert(height(std::as_const(tree).root()) <= bound);
+    }
+  }
+  for (const auto factor : {0.5, 1.0, 1.1}) {
+    /// a bound no tree could meet stays at the height of a balanced one
+    auto tree = Tree();
+    tree.factor() = factor;
+    std::srand(2);
+    for (auto i = 0; i < 1000; i++) {
+      const auto val = std::rand() % 100000;
+      tree.insert(val);
+      assert(tree.find(val));
+      const auto bound = std::max(
+          factor * std::log2(tree.size() + 1),
+          std::ceil(std::log2(tree.size() + 1))
+      );
+      assert(height(std::as_const(tree).root()) <= bound);
+    }
+  }
+  {
+    using Facade = sal::Tree<data_type, sal::BSTree>;
+    Facade tree;
+    for (auto i = 0; i < 1024; i++) {
+      assert(tree.insert(i));
+    }
+    assert(tree.size() == 1024);
+    assert(tree.remove(0));
+    assert(!tree.find(0));
+  }
 
   return 0;
 }
@@ -0,0 +1,132 @@
+#include <sal/buffered_tree.hh>
+#include <sal/tree.hh>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+#include <string>
+
+/*!
+ * @brief asserts the pivots bound their childs and the buffers hold one
+ *        sorted message per value, within the range of the node
+ * @return depth of the leaves, the same for all
+ */
+template <typename Node, typename T>
+std::size_t check(const Node& node, const T* lo, const T* hi) {
+  const auto within = [&](const T& val) {
+    return (!lo || !(val < *lo)) && (!hi || val < *hi);
+  };
+  for (std::size_t i = 0; i < node.keys.size(); i++) {
+    assert(within(node.keys[i]));
+    assert(!i || node.keys[i - 1] < node.keys[i]);
+  }
+  if (node.leaf()) {
+    assert(node.buffer.empty());
+    return 1;
+  }
+  assert(node.keys.size() + 1 == node.childs.size());
+  for (std::size_t i = 0; i < node.buffer.size(); i++) {
+    assert(within(node.buffer[i].value));
+    assert(!i || node.buffer[i - 1].value < node.buffer[i].value);
+  }
+  std::size_t depth = 0;
+  for (std::size_t i = 0; i < node.childs.size(); i++) {
+    const auto d = check(
+        node.childs[i],
+        i ? &node.keys[i - 1] : lo,
+        i < node.keys.size() ? &node.keys[i] : hi
+    );
+    assert(!depth || d == depth);
+    depth = d;
+  }
+  return depth + 1;
+}
+
+template <typename T>
+class Checked : public sal::BufferedTree<T> {
+public:
+  std::size_t check() const {
+    return ::check<typename sal::BufferedTree<T>::node_type, T>(
+        this->root_,
+        nullptr,
+        nullptr
+    );
+  }
+};
+
+int main() {
+  std::srand(47);
+  {
+    Checked<int> tree;
+    assert(!tree.find(0));
+    assert(tree.depth() == 1);
+    tree.insert(1);
+    tree.insert(1);
+    assert(tree.find(1) && !tree.find(0));
+    tree.remove(1);
+    assert(!tree.find(1));
+    assert(tree.check() == 1);
+  }
+  {
+    /// random writes, then removes of everything but a few
+    Checked<int> tree;
+    std::set<int> expected;
+    const int range = 200000;
+    for (int i = 0; i < 600000; i++) {
+      const auto val = std::rand() % range;
+      if (std::rand() % 4) {
+        tree.insert(val);
+        expected.insert(val);
+      } else {
+        tree.remove(val);
+        expected.erase(val);
+      }
+      if (i % 50000 == 0) {
+        assert(tree.check() == tree.depth());
+      }
+    }
+    assert(tree.depth() >= 3);
+    for (int val = -1; val <= range; val++) {
+      assert(tree.find(val) == (expected.count(val) == 1));
+    }
+    for (int val = 0; val < range; val++) {
+      if (val % 1000) {
+        tree.remove(val);
+        expected.erase(val);
+      }
+    }
+    /// messages pushed down by more removes, dropping the empty leaves
+    for (int i = 0; i < 100000; i++) {
+      tree.remove(range + i);
+    }
+    assert(tree.check() == tree.depth());
+    for (int val = -1; val <= range; val++) {
+      assert(tree.find(val) == (expected.count(val) == 1));
+    }
+  }
+  {
+    /// sequential inserts, all at one end
+    Checked<std::string> tree;
+    for (int i = 0; i < 20000; i++) {
+      tree.insert(std::to_string(100000 + i));
+    }
+    assert(tree.check() == tree.depth());
+    for (int i = 0; i < 20000; i++) {
+      assert(tree.find(std::to_string(100000 + i)));
+    }
+    assert(!tree.find("1"));
+  }
+  {
+    sal::Tree<int, sal::BufferedTree> tree;
+    assert(tree.insert(3));
+    assert(!tree.insert(3));
+    assert(tree.insert(4));
+    assert(tree.remove(3));
+    assert(!tree.remove(3));
+    assert(tree.size() == 1 && tree.find(4) && !tree.find(3));
+    auto copy = tree;
+    assert(copy.insert(5) && !tree.find(5));
+  }
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template <typename Node, typename T>
+void inorder(const Node* node, std::vector<T>& out) {
+  if (node) {
+    inorder(node->left(), out);
+    out.push_back(node->value());
+    inorder(node->right(), out);
+  }
+}
+
+template <typename Tree, typename T>
+void checkValues(const Tree& tree, const std::multiset<T>& values) {
+  std::vector<T> got;
+  inorder(tree.root(), got);
+  assert(got == std::vector<T>(values.begin(), values.end()));
+}
+
+/*!
+ * @brief every marked node has its parent marked
+ */
+template <typename Node>
+void checkMarks(const Node* node, bool parentDirty = true) {
+  if (node) {
+    assert(!node->dirty() || parentDirty);
+    checkMarks(node->left(), node->dirty());
+    checkMarks(node->right(), node->dirty());
+  }
+}
+
+template <typename Tree>
+std::string checkpoint(Tree& tree) {
+  std::ostringstream os;
+  assert(tree.checkpoint(os));
+  return os.str();
+}
+
+template <typename Tree>
+bool replay(Tree& tree, const std::string& bytes) {
+  std::istringstream is(bytes);
+  return tree.apply(is);
+}
+
+/*!
+ * @brief random inserts and removes, equal values included, checkpointed
+ *        every round and recovered from the base and the checkpoints
+ */
+template <typename Tree>
+void churn(std::size_t size, std::size_t changes, bool rb) {
+  Tree tree;
+  std::multiset<int> values;
+  for (std::size_t i = 0; i < size; i++) {
+    const auto val = std::rand() % int(size);
+    tree.insert(val);
+    values.insert(val);
+  }
+  std::ostringstream base;
+  assert(tree.save(base));
+  tree.clean();
+  std::vector<std::string> checkpoints;
+  for (std::size_t round = 0; round < 6; round++) {
+    for (std::size_t i = 0; i < changes; i++) {
+      const auto val = std::rand() % int(size + 10);
+      if (std::rand() % 2 && values.count(val)) {
+        tree.remove(val);
+        values.erase(values.find(val));
+      } else {
+        tree.insert(val);
+        values.insert(val);
+      }
+    }
+    if (rb) {
+      checkMarks(tree.root());
+    }
+    checkpoints.push_back(checkpoint(tree));
+    checkValues(tree, values);
+  }
+  Tree recovered;
+  std::istringstream is(base.str());
+  assert(recovered.load(is));
+  for (const auto& bytes : checkpoints) {
+    assert(replay(recovered, bytes));
+  }
+  checkValues(recovered, values);
+  /// replayed again, or skipped, they are out of sequence
+  assert(!replay(recovered, checkpoints.back()));
+  Tree skipping;
+  std::istringstream again(base.str());
+  assert(skipping.load(again));
+  assert(!replay(skipping, checkpoints[1]));
+  /// and follows the next checkpoints
+  for (std::size_t i = 0; i < changes; i++) {
+    const auto val = std::rand() % int(size + 1);
+    tree.insert(val);
+    values.insert(val);
+  }
+  assert(replay(recovered, checkpoint(tree)));
+  checkValues(recovered, values);
+  /// copies and moves carry on the numbering
+  const auto next = [&](Tree& from) {
+    const auto val = std::rand() % int(size + 1);
+    from.insert(val);
+    values.insert(val);
+    assert(replay(recovered, checkpoint(from)));
+    checkValues(recovered, values);
+  };
+  Tree moved(std::move(tree));
+  next(moved);
+  Tree copied(moved);
+  next(copied);
+  Tree assigned;
+  assigned = copied;
+  next(assigned);
+  Tree moveAssigned;
+  moveAssigned = std::move(assigned);
+  next(moveAssigned);
+}
+
+int main() {
+  std::srand(43);
+  for (std::size_t size : {0, 1, 10, 1000}) {
+    for (std::size_t changes : {0, 1, 5, 100}) {
+      churn<sal::RBTree<int>>(size, changes, true);
+      churn<sal::AATree<int>>(size, changes, false);
+    }
+  }
+  {
+    /// a few changes in a large tree make a small checkpoint
+    sal::RBTree<int> tree;
+    sal::AATree<int> aa;
+    for (int i = 0; i < 100000; i++) {
+      tree.insert(i * 2);
+      aa.insert(i * 2);
+    }
+    const auto full = checkpoint(tree);
+    assert(checkpoint(aa).size() == full.size());
+    assert(checkpoint(tree).size() < 100);
+    for (int i = 0; i < 10; i++) {
+      tree.insert(i * 20000 + 1);
+      tree.remove(i * 20000 + 100);
+      aa.insert(i * 20000 + 1);
+      aa.remove(i * 20000 + 100);
+    }
+    /// absent values change nothing
+    tree.remove(3);
+    aa.remove(3);
+    const auto small = checkpoint(tree);
+    assert(small.size() * 50 < full.size());
+    assert(checkpoint(aa).size() * 50 < full.size());
+    checkMarks(tree.root());
+    /// nothing left to write
+    assert(checkpoint(tree).size() < 100);
+    sal::RBTree<int> copy;
+    std::ostringstream os;
+    assert(tree.save(os));
+    tree.clean();
+    std::istringstream is(os.str());
+    assert(copy.load(is));
+    /// corrupt checkpoints leave the tree as it was
+    tree.insert(-1);
+    auto bytes = checkpoint(tree);
+    for (std::size_t i = 0; i < bytes.size(); i += 7) {
+      auto corrupt = bytes;
+      corrupt[i] ^= 0x20;
+      assert(!replay(copy, corrupt));
+      assert(copy.find(0) && !copy.find(-1));
+    }
+    assert(!replay(copy, bytes.substr(0, bytes.size() - 1)));
+    assert(replay(copy, bytes));
+    assert(copy.find(-1));
+  }
+  {
+    /// encoded values
+    sal::AATree<std::string> tree;
+    sal::AATree<std::string> copy;
+    tree.insert("b");
+    tree.insert("d");
+    assert(replay(copy, checkpoint(tree)));
+    tree.insert("a");
+    tree.insert("c");
+    tree.remove("d");
+    assert(replay(copy, checkpoint(tree)));
+    std::vector<std::string> got;
+    inorder(copy.root(), got);
+    assert(got == std::vector<std::string>({"a", "b", "c"}));
+  }
+
+  return 0;
+}
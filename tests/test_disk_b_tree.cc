@@ -0,0 +1,130 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+/// small pages make a deep tree out of few values
+using Tree = sal::DiskBTree<int, 128>;
+
+std::string temporary() {
+  char path[] = "/tmp/test_disk_b_tree_XXXXXX";
+  const auto fd = ::mkstemp(path);
+  assert(fd >= 0);
+  ::close(fd);
+  return path;
+}
+
+void checkValues(const Tree& tree, const std::set<int>& values) {
+  assert(tree.size() == values.size());
+  std::vector<int> order;
+  tree.inorder([&](int val) { order.push_back(val); });
+  assert(order == std::vector<int>(values.begin(), values.end()));
+}
+
+int main() {
+  std::srand(46);
+  const auto path = temporary();
+  std::set<int> values;
+  std::uint64_t pages = 0;
+  {
+    /// 8 frames for hundreds of pages, evicting all along
+    Tree tree(8);
+    assert(!tree.good());
+    assert(tree.open(path.c_str()));
+    assert(tree.good() && tree.size() == 0);
+    assert(!tree.find(0) && !tree.lowerBound(0));
+    for (int i = 0; i < 30000; i++) {
+      const auto val = std::rand() % 5000;
+      if (std::rand() % 3) {
+        assert(tree.insert(val) == values.insert(val).second);
+      } else {
+        assert(tree.remove(val) == (values.erase(val) == 1));
+      }
+      if (i % 1000 == 0) {
+        checkValues(tree, values);
+      }
+    }
+    checkValues(tree, values);
+    for (int val = -1; val <= 5000; val++) {
+      assert(tree.find(val) == (values.count(val) == 1));
+      const auto it = values.lower_bound(val);
+      const auto bound = tree.lowerBound(val);
+      assert(bound.has_value() == (it != values.end()));
+      assert(!bound || *bound == *it);
+    }
+    const auto& stats = tree.pool().stats();
+    assert(stats.reads && stats.writes && stats.hits);
+    pages = tree.pages();
+    assert(tree.close());
+    assert(!tree.good() && !tree.insert(1));
+  }
+  {
+    /// reopened, and emptied, the freed pages are reused
+    Tree tree(64);
+    assert(tree.open(path.c_str()));
+    checkValues(tree, values);
+    for (const auto& val : values) {
+      assert(tree.remove(val));
+    }
+    checkValues(tree, {});
+    assert(!tree.lowerBound(0));
+    assert(tree.pages() == pages);
+    for (int i = 0; i < 1000; i++) {
+      assert(tree.insert(i));
+    }
+    assert(tree.pages() == pages);
+    values.clear();
+    for (int i = 0; i < 1000; i++) {
+      values.insert(i);
+    }
+    assert(tree.flush());
+  }
+  {
+    Tree tree;
+    assert(tree.open(path.c_str()));
+    checkValues(tree, values);
+    assert(*tree.lowerBound(-10) == 0 && !tree.lowerBound(1000));
+  }
+  {
+    /// other value types, page sizes, or no tree at all
+    sal::DiskBTree<long long, 128> wide;
+    assert(!wide.open(path.c_str()));
+    sal::DiskBTree<int> paged;
+    assert(!paged.open(path.c_str()));
+    {
+      std::ofstream os(path, std::ios::binary | std::ios::trunc);
+      os << std::string(128, 'x');
+    }
+    Tree tree;
+    assert(!tree.open(path.c_str()));
+    assert(!tree.open("/nonexistent/tree"));
+    assert(!tree.insert(1));
+  }
+  {
+    /// default pages, a tree of a few levels
+    std::remove(path.c_str());
+    sal::DiskBTree<std::uint64_t> tree(16);
+    assert(tree.open(path.c_str()));
+    for (std::uint64_t i = 0; i < 200000; i++) {
+      assert(tree.insert(i * 7919 % 200000));
+    }
+    for (std::uint64_t i = 0; i < 200000; i += 2) {
+      assert(tree.remove(i));
+    }
+    assert(tree.size() == 100000);
+    for (std::uint64_t i = 0; i < 1000; i++) {
+      assert(tree.find(i) == (i % 2 == 1));
+      assert(*tree.lowerBound(2 * i) == 2 * i + 1);
+    }
+  }
+  std::remove(path.c_str());
+
+  return 0;
+}
@@ -0,0 +1,200 @@
+#include <sal/double_linked_list.hh>
+#include <sal/indexed_linked_list.hh>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+template <typename List, typename T>
+void check(const List& list, const std::vector<T>& order) {
+  auto* it = list.root();
+  decltype(it) prev = nullptr;
+  for (const auto& val : order) {
+    assert(it);
+    assert(it->value() == val);
+    assert(it->prev() == prev);
+    prev = it;
+    it = it->next();
+  }
+  assert(!it);
+  assert(list.last() == prev);
+}
+
+/// orders by the first member only, the second one tells equal keys apart
+struct ByKey {
+  bool operator()(
+      const std::pair<int, int>& a,
+      const std::pair<int, int>& b
+  ) const {
+    return a.first < b.first;
+  }
+};
+
+/*!
+ * @return resident set size in pages, 0 where /proc is unavailable
+ */
+std::size_t resident() {
+  std::size_t size = 0;
+  std::size_t pages = 0;
+  if (auto* file = std::fopen("/proc/self/statm", "r")) {
+    if (std::fscanf(file, "%zu %zu", &size, &pages) != 2) {
+      pages = 0;
+    }
+    std::fclose(file);
+  }
+  return pages;
+}
+
+int main() {
+  using data = int;
+  {
+    sal::DoubleLinkedList<data> list;
+    const std::vector<data> values{1, 2, 3};
+    assert(!list.append(std::vector<data>{}));
+    auto* first = list.append(values);
+    assert(first == list.root());
+    check(list, values);
+    assert(list.append(std::vector<data>{4, 5})->value() == 4);
+    check(list, std::vector<data>{1, 2, 3, 4, 5});
+    assert(list.popFront() == 1);
+    assert(list.popBack() == 5);
+    check(list, std::vector<data>{2, 3, 4});
+    assert(list.popBack() == 4);
+    assert(list.popBack() == 3);
+    assert(list.popFront() == 2);
+    check(list, std::vector<data>{});
+  }
+  {
+    sal::DoubleLinkedList<data> a;
+    sal::DoubleLinkedList<data> b;
+    a.append(std::vector<data>{1, 2});
+    b.append(std::vector<data>{3, 4});
+    auto* three = b.root();
+    /// whole list to the end, nodes keep their addresses
+    a.splice(a.nil, b);
+    check(a, std::vector<data>{1, 2, 3, 4});
+    check(b, std::vector<data>{});
+    assert(a.get(3) == three);
+    /// an empty list splices to nothing
+    a.splice(a.root(), b);
+    check(a, std::vector<data>{1, 2, 3, 4});
+    /// whole list to the front
+    b.splice(b.nil, a);
+    a.add(0);
+    a.splice(a.nil, b);
+    check(a, std::vector<data>{0, 1, 2, 3, 4});
+    b.add(9);
+    b.add(10);
+    a.splice(a.root(), b);
+    check(a, std::vector<data>{9, 10, 0, 1, 2, 3, 4});
+    /// a range out of the middle into the middle of another list
+    b.append(std::vector<data>{5, 6, 7, 8});
+    a.splice(a.get(1), b, b.get(6), b.get(7));
+    check(a, std::vector<data>{9, 10, 0, 6, 7, 1, 2, 3, 4});
+    check(b, std::vector<data>{5, 8});
+    /// a range moved within the same list
+    a.splice(a.nil, a, a.root(), a.get(0));
+    check(a, std::vector<data>{6, 7, 1, 2, 3, 4, 9, 10, 0});
+    a.splice(a.root(), a, a.last(), a.last());
+    check(a, std::vector<data>{0, 6, 7, 1, 2, 3, 4, 9, 10});
+  }
+  {
+    sal::DoubleLinkedList<data> list;
+    list.sort();
+    check(list, std::vector<data>{});
+    list.add(1);
+    list.sort();
+    check(list, std::vector<data>{1});
+    list.append(std::vector<data>{3, 2});
+    auto* three = list.get(3);
+    list.sort();
+    check(list, std::vector<data>{1, 2, 3});
+    assert(list.last() == three);
+    list.sort(std::greater<>{});
+    check(list, std::vector<data>{3, 2, 1});
+  }
+  std::srand(38);
+  for (std::size_t n : {2, 7, 64, 100, 1000, 4097}) {
+    /// few distinct keys, so that stability shows
+    std::vector<std::pair<int, int>> values;
+    for (std::size_t i = 0; i < n; i++) {
+      values.emplace_back(std::rand() % 16, static_cast<int>(i));
+    }
+    sal::DoubleLinkedList<std::pair<int, int>> list;
+    list.append(values);
+    list.sort(ByKey{});
+    std::stable_sort(values.begin(), values.end(), ByKey{});
+    check(list, values);
+  }
+  {
+    /// the index follows pops, a duplicate is skipped by append
+    sal::IndexedLinkedList<data> list;
+    assert(list.append(std::vector<data>{1, 2, 3, 2})->value() == 1);
+    assert(list.size() == 3);
+    assert(!list.append(std::vector<data>{1, 3}));
+    assert(list.popFront() == 1);
+    assert(list.popBack() == 3);
+    assert(!list.get(1));
+    assert(!list.get(3));
+    assert(list.size() == 1);
+    list.append(std::vector<data>{5, 4});
+    list.sort();
+    check(list, std::vector<data>{2, 4, 5});
+    assert(list.get(4) == list.root()->next());
+    assert(list.del(4));
+    check(list, std::vector<data>{2, 5});
+  }
+  {
+    /// removed nodes are reused, up to the free capacity
+    sal::DoubleLinkedList<data> list(2);
+    assert(list.freeCapacity() == 2);
+    list.append(std::vector<data>{1, 2, 3, 4});
+    auto* one = list.root();
+    auto* two = one->next();
+    assert(list.del(1));
+    assert(list.del(2));
+    assert(list.del(3));
+    assert(list.freeSize() == 2);
+    check(list, std::vector<data>{4});
+    /// the last released comes back first
+    assert(list.add(5) == two);
+    assert(list.add(6) == one);
+    assert(!list.freeSize());
+    check(list, std::vector<data>{4, 5, 6});
+    assert(list.popFront() == 4);
+    assert(list.popBack() == 6);
+    assert(list.freeSize() == 2);
+    list.freeCapacity(1);
+    assert(list.freeSize() == 1);
+    list.shrinkToFit();
+    assert(!list.freeSize());
+    assert(list.freeCapacity() == 1);
+    sal::DoubleLinkedList<data> none(0);
+    none.add(1);
+    assert(none.del(1));
+    assert(!none.freeSize());
+  }
+  {
+    /// queue like churn, memory stays bounded by the longest queue
+    sal::DoubleLinkedList<data> list;
+    constexpr std::size_t QUEUE = 1000;
+    constexpr std::size_t CHURN = 4'000'000;
+    for (std::size_t i = 0; i < QUEUE; i++) {
+      list.add(static_cast<data>(i));
+    }
+    const auto before = resident();
+    for (std::size_t i = QUEUE; i < CHURN; i++) {
+      assert(list.del(static_cast<data>(i - QUEUE)));
+      list.add(static_cast<data>(i));
+    }
+    const auto after = resident();
+    /// a leak of CHURN nodes would take well over 100MB
+    assert(after < before + 1024);
+    assert(list.root()->value() == static_cast<data>(CHURN - QUEUE));
+    assert(list.freeSize() == 0);
+  }
+
+  return 0;
+}
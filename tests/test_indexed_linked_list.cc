@@ -0,0 +1,148 @@
+#include <sal/indexed_linked_list.hh>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+/// every value lands in the same home slot, probing does all the work
+struct Collide {
+  std::size_t operator()(unsigned) const { return 0; }
+};
+
+template <typename List>
+void check(const List& list, const std::vector<unsigned>& order) {
+  auto* it = list.root();
+  const typename List::node_type* prev = nullptr;
+  for (const auto& val : order) {
+    assert(it);
+    assert(it->value() == val);
+    assert(it->prev() == prev);
+    assert(list.get(val) == it);
+    prev = it;
+    it = it->next();
+  }
+  assert(!it);
+  assert(list.last() == prev);
+  assert(list.size() == order.size());
+}
+
+int main() {
+  using data = unsigned;
+  {
+    sal::IndexedLinkedList<data> list;
+    assert(!list.get(0));
+    assert(!list.del(0));
+    assert(list.add(0));
+    assert(list.root());
+    assert(list.root()->value() == 0);
+    assert(list.add(1));
+    assert(list.root()->next());
+    assert(list.root()->next()->value() == 1);
+    assert(list.root()->next()->prev() == list.root());
+    assert(!list.root()->next()->next());
+    assert(list.get(0) == list.root());
+    assert(list.get(1) == list.last());
+    assert(!list.get(2));
+    /// values are unique
+    assert(list.add(1) == list.last());
+    assert(list.size() == 2);
+    assert(list.del(1));
+    assert(!list.del(1));
+    assert(list.add(3));
+    assert(list.add(4));
+    assert(list.add(5));
+    assert(list.del(0));
+    check(list, {3, 4, 5});
+    assert(list.del(4));
+    check(list, {3, 5});
+    assert(list.del(5));
+    assert(list.del(3));
+    check(list, {});
+    assert(!list.root());
+    assert(list.add(0));
+    assert(list.add(2));
+    assert(list.add(1));
+    check(list, {0, 2, 1});
+  }
+  {
+    sal::IndexedLinkedList<data, Collide> list;
+    for (data i = 0; i < 64; i++) {
+      assert(list.add(i));
+    }
+    for (data i = 0; i < 64; i += 2) {
+      assert(list.del(i));
+    }
+    std::vector<data> order;
+    for (data i = 1; i < 64; i += 2) {
+      order.push_back(i);
+    }
+    check(list, order);
+    for (data i = 0; i < 64; i += 2) {
+      assert(!list.get(i));
+    }
+  }
+  {
+    std::srand(1);
+    sal::IndexedLinkedList<data> list;
+    list.reserve(256);
+    std::set<data> reference;
+    for (auto i = 0; i < 1 << 15; i++) {
+      const data val = std::rand() % 1024;
+      if (std::rand() % 2) {
+        assert(list.add(val)->value() == val);
+        reference.insert(val);
+      } else {
+        assert(list.del(val) == static_cast<bool>(reference.erase(val)));
+      }
+      assert(list.size() == reference.size());
+    }
+    for (data val = 0; val < 1024; val++) {
+      assert(static_cast<bool>(list.get(val)) == reference.count(val));
+    }
+    std::size_t count = 0;
+    for (auto* it = list.root(); it; it = it->next()) {
+      assert(reference.count(it->value()));
+      assert(!it->next() || it->next()->prev() == it);
+      count++;
+    }
+    assert(count == reference.size());
+  }
+  {
+    /// splices keep the index of both lists, through the base class too
+    sal::IndexedLinkedList<data> src;
+    sal::IndexedLinkedList<data> dst;
+    src.append(std::vector<data>{1, 2});
+    auto* two = src.last();
+    dst.splice(dst.nil, src);
+    check(src, {});
+    assert(!src.get(1) && !src.get(2));
+    check(dst, {1, 2});
+    assert(dst.get(2) == two);
+    assert(dst.del(1));
+    assert(!src.get(1));
+    src.append(std::vector<data>{3, 4, 5});
+    sal::DoubleLinkedList<data>& base = dst;
+    base.splice(dst.root(), src, src.get(3), src.get(4));
+    check(src, {5});
+    check(dst, {3, 4, 2});
+    /// present values are dropped on the way in
+    src.append(std::vector<data>{4, 6});
+    base.splice(base.nil, src);
+    check(src, {});
+    check(dst, {3, 4, 2, 5, 6});
+    assert(base.append(std::vector<data>{2, 7, 3})->value() == 7);
+    assert(!base.append(std::vector<data>{6}));
+    check(dst, {3, 4, 2, 5, 6, 7});
+    /// and a range moved within the list stays indexed
+    dst.splice(dst.root(), dst, dst.get(6), dst.last());
+    check(dst, {6, 7, 3, 4, 2, 5});
+    /// into a plain list
+    sal::DoubleLinkedList<data> plain;
+    plain.splice(plain.nil, dst, dst.get(3), dst.get(4));
+    check(dst, {6, 7, 2, 5});
+    assert(!dst.get(3) && plain.get(3) && plain.get(4));
+  }
+
+  return 0;
+}
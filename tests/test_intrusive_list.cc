@@ -0,0 +1,73 @@
+#include <sal/intrusive_list.hh>
+#include <cassert>
+#include <vector>
+
+struct ByAge {};
+struct ByState {};
+
+/// a connection sits in two lists at once without any node allocation
+struct Connection : sal::ListHook<ByAge>, sal::ListHook<ByState> {
+  Connection(int _id) : id(_id) {}
+  int id = 0;
+};
+
+template <typename List>
+void order(const List& list, const std::vector<int>& ids) {
+  auto* it = list.root();
+  const Connection* prev = nullptr;
+  for (const auto& id : ids) {
+    assert(it);
+    assert(it->id == id);
+    assert(List::prev(*it) == prev);
+    prev = it;
+    it = List::next(*it);
+  }
+  assert(!it);
+  assert(list.last() == prev);
+  assert(list.size() == ids.size());
+}
+
+int main() {
+  std::vector<Connection> connections;
+  for (auto i = 0; i < 5; i++) {
+    connections.emplace_back(i);
+  }
+  {
+    sal::IntrusiveList<Connection, ByAge> ages;
+    sal::IntrusiveList<Connection, ByState> states;
+    assert(!ages.root());
+    assert(!ages.last());
+    for (auto& connection : connections) {
+      assert(&ages.add(connection) == &connection);
+    }
+    states.add(connections[3]);
+    states.add(connections[1]);
+    order(ages, {0, 1, 2, 3, 4});
+    order(states, {3, 1});
+    ages.del(connections[0]);
+    ages.del(connections[2]);
+    ages.del(connections[4]);
+    order(ages, {1, 3});
+    order(states, {3, 1});
+    ages.insert(&connections[3], connections[2]);
+    ages.insert(ages.root(), connections[0]);
+    ages.insert(nullptr, connections[4]);
+    order(ages, {0, 1, 2, 3, 4});
+    states.del(connections[1]);
+    states.del(connections[3]);
+    order(states, {});
+    /// moving between positions is an unlink and a relink
+    ages.insert(ages.root(), ages.del(*ages.last()));
+    order(ages, {4, 0, 1, 2, 3});
+    states.add(connections[2]);
+  }
+  /// the lists unlinked what was left on destruction
+  for (auto& connection : connections) {
+    const auto& age = static_cast<sal::ListHook<ByAge>&>(connection);
+    const auto& state = static_cast<sal::ListHook<ByState>&>(connection);
+    assert(!age.prev() && !age.next());
+    assert(!state.prev() && !state.next());
+  }
+
+  return 0;
+}
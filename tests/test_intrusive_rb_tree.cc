@@ -0,0 +1,143 @@
+#include <sal/intrusive_rb_tree.hh>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <set>
+#include <vector>
+
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+  allocations++;
+  if (auto* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+struct ById {};
+struct ByDeadline {};
+
+struct Connection : sal::RBTreeHook<ById>, sal::RBTreeHook<ByDeadline> {
+  int id = 0;
+  int deadline = 0;
+};
+
+/// the id tree orders connections through these
+bool operator<(const Connection& a, const Connection& b) {
+  return a.id < b.id;
+}
+bool operator<(const Connection& a, int id) { return a.id < id; }
+bool operator<(int id, const Connection& a) { return id < a.id; }
+
+struct ByDeadlineLess {
+  bool operator()(const Connection& a, const Connection& b) const {
+    return a.deadline < b.deadline;
+  }
+  bool operator()(const Connection& a, int deadline) const {
+    return a.deadline < deadline;
+  }
+  bool operator()(int deadline, const Connection& a) const {
+    return deadline < a.deadline;
+  }
+};
+
+/*!
+ * @return black height
+ */
+template <typename Hook>
+std::size_t check(const Hook* hook, const Hook* parent = nullptr) {
+  if (!hook) {
+    return 1;
+  }
+  assert(hook->parent() == parent);
+  if (hook->color() == Hook::Color::RED) {
+    assert(!hook->left() || hook->left()->color() == Hook::Color::BLACK);
+    assert(!hook->right() || hook->right()->color() == Hook::Color::BLACK);
+  }
+  const auto l = check(hook->left(), hook);
+  const auto r = check(hook->right(), hook);
+  assert(l == r);
+  return l + (hook->color() == Hook::Color::BLACK ? 1 : 0);
+}
+
+int main() {
+  using Ids = sal::IntrusiveRBTree<Connection, ById>;
+  const auto n = 1 << 12;
+  auto connections = std::make_unique<Connection[]>(n);
+  for (auto i = 0; i < n; i++) {
+    connections[i].id = i;
+    connections[i].deadline = (i * 7919) % n;
+  }
+  {
+    Ids ids;
+    assert(!ids.find(0));
+    assert(!ids.remove(0));
+    const auto before = allocations;
+    for (auto i = 0; i < n; i++) {
+      ids.insert(connections[(i * 2654435761u) % n]);
+    }
+    assert(allocations == before);
+    assert(ids.size() == n);
+    assert(ids.root()->color() == Ids::hook_type::Color::BLACK);
+    check(ids.root());
+    for (auto i = 0; i < n; i++) {
+      assert(ids.find(i) == &connections[i]);
+    }
+    /// unlinking by object, inner nodes included, relinks and never copies
+    for (auto i = 0; i < n; i += 3) {
+      assert(&ids.remove(connections[i]) == &connections[i]);
+    }
+    assert(ids.remove(1) == &connections[1]);
+    assert(!ids.remove(1));
+    assert(allocations == before);
+    check(ids.root());
+    for (auto i = 0; i < n; i++) {
+      assert(static_cast<bool>(ids.find(i)) == (i % 3 != 0 && i != 1));
+    }
+  }
+  {
+    /// one object in two trees at once, against a reference multiset
+    std::srand(1);
+    Ids ids;
+    sal::IntrusiveRBTree<Connection, ByDeadline, ByDeadlineLess> deadlines;
+    std::vector<bool> linked(n, false);
+    std::multiset<int> reference;
+    for (auto step = 0; step < 1 << 15; step++) {
+      auto& connection = connections[std::rand() % n];
+      if (linked[connection.id]) {
+        ids.remove(connection);
+        deadlines.remove(connection);
+        reference.erase(reference.find(connection.deadline));
+      } else {
+        ids.insert(connection);
+        deadlines.insert(connection);
+        reference.insert(connection.deadline);
+      }
+      linked[connection.id] = !linked[connection.id];
+      assert(ids.size() == reference.size());
+      assert(deadlines.size() == reference.size());
+      if (step % 1024 == 0) {
+        check(ids.root());
+        check(deadlines.root());
+      }
+    }
+    for (auto i = 0; i < n; i++) {
+      assert(static_cast<bool>(ids.find(i)) == linked[i]);
+      auto* found = deadlines.find(connections[i].deadline);
+      assert(found == (linked[i] ? &connections[i] : nullptr));
+    }
+  }
+
+  return 0;
+}
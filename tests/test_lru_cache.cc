@@ -0,0 +1,141 @@
+#include <sal/lru_cache.hh>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <vector>
+
+template <typename Cache>
+void order(
+    const Cache& cache,
+    std::uint8_t segment,
+    const std::vector<int>& keys
+) {
+  auto* it = cache.segment(segment).root();
+  const typename Cache::node_type* prev = nullptr;
+  for (const auto& key : keys) {
+    assert(it);
+    assert(it->value().key == key);
+    assert(it->value().segment == segment);
+    assert(it->prev() == prev);
+    prev = it;
+    it = it->next();
+  }
+  assert(!it);
+  assert(cache.segment(segment).last() == prev);
+}
+
+int main() {
+  using Cache = sal::LRUCache<int, std::string>;
+  {
+    Cache cache(3);
+    assert(cache.capacity() == 3);
+    assert(!cache.get(0));
+    assert(!cache.del(0));
+    assert(*cache.put(0, "0") == "0");
+    assert(*cache.put(1, "1") == "1");
+    assert(*cache.put(2, "2") == "2");
+    order(cache, Cache::PROBATION, {2, 1, 0});
+    assert(*cache.get(0) == "0");
+    order(cache, Cache::PROBATION, {0, 2, 1});
+    /// 1 is the least recently used, its node is reused for 3
+    auto* recycled = cache.segment(Cache::PROBATION).last();
+    assert(*cache.put(3, "3") == "3");
+    assert(cache.segment(Cache::PROBATION).root() == recycled);
+    assert(cache.size() == 3);
+    assert(!cache.get(1));
+    order(cache, Cache::PROBATION, {3, 0, 2});
+    assert(*cache.put(2, "two") == "two");
+    order(cache, Cache::PROBATION, {2, 3, 0});
+    assert(cache.del(3));
+    assert(!cache.del(3));
+    order(cache, Cache::PROBATION, {2, 0});
+    assert(cache.size() == 2);
+    assert(*cache.get(2) == "two");
+    order(cache, Cache::PROTECTED, {});
+  }
+  {
+    /// capacities no cache could keep are clamped
+    Cache empty(0);
+    assert(empty.capacity() == 1);
+    assert(*empty.put(0, "0") == "0");
+    assert(*empty.put(1, "1") == "1");
+    assert(!empty.get(0) && *empty.get(1) == "1");
+    Cache unbounded(2, 2);
+    assert(*unbounded.put(0, "0") == "0");
+    assert(*unbounded.put(1, "1") == "1");
+    assert(*unbounded.get(0) == "0" && *unbounded.get(1) == "1");
+    order(unbounded, Cache::PROTECTED, {1});
+    order(unbounded, Cache::PROBATION, {0});
+    assert(*unbounded.put(2, "2") == "2");
+    assert(unbounded.size() == 2);
+  }
+  {
+    /// segmented, 2 of 4 entries protected
+    Cache cache(4, 2);
+    cache.put(0, "0");
+    cache.put(1, "1");
+    cache.put(2, "2");
+    order(cache, Cache::PROBATION, {2, 1, 0});
+    assert(cache.get(0));
+    assert(cache.get(1));
+    order(cache, Cache::PROTECTED, {1, 0});
+    order(cache, Cache::PROBATION, {2});
+    /// the protected segment overflows into probation
+    assert(cache.get(2));
+    order(cache, Cache::PROTECTED, {2, 1});
+    order(cache, Cache::PROBATION, {0});
+    assert(cache.get(1));
+    order(cache, Cache::PROTECTED, {1, 2});
+    /// a scan over cold keys only churns probation
+    for (auto key = 10; key < 20; key++) {
+      cache.put(key, std::to_string(key));
+    }
+    order(cache, Cache::PROTECTED, {1, 2});
+    order(cache, Cache::PROBATION, {19, 18});
+    assert(!cache.get(0));
+    assert(cache.del(2));
+    order(cache, Cache::PROTECTED, {1});
+    assert(cache.size() == 3);
+  }
+  {
+    /// against a reference lru
+    std::srand(1);
+    sal::LRUCache<int, int> cache(64);
+    std::list<std::pair<int, int>> reference;
+    for (auto i = 0; i < 1 << 15; i++) {
+      const auto key = std::rand() % 256;
+      auto it = reference.begin();
+      while (it != reference.end() && it->first != key) {
+        it++;
+      }
+      if (std::rand() % 2) {
+        auto* val = cache.get(key);
+        assert(static_cast<bool>(val) == (it != reference.end()));
+        if (val) {
+          assert(*val == it->second);
+          reference.splice(reference.begin(), reference, it);
+        }
+      } else {
+        assert(*cache.put(key, i) == i);
+        if (it != reference.end()) {
+          reference.erase(it);
+        } else if (reference.size() == 64) {
+          reference.pop_back();
+        }
+        reference.emplace_front(key, i);
+      }
+      assert(cache.size() == reference.size());
+    }
+    auto* node = cache.segment(0).root();
+    for (const auto& [key, val] : reference) {
+      assert(node->value().key == key);
+      assert(node->value().value == val);
+      node = node->next();
+    }
+    assert(!node);
+  }
+
+  return 0;
+}
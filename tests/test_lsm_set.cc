@@ -0,0 +1,185 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+#include <string>
+
+#include <dirent.h>
+#include <unistd.h>
+
+std::size_t files(const std::string& directory) {
+  std::size_t ret = 0;
+  auto* dir = ::opendir(directory.c_str());
+  assert(dir);
+  while (const auto* entry = ::readdir(dir)) {
+    ret += entry->d_name[0] != '.';
+  }
+  ::closedir(dir);
+  return ret;
+}
+
+/*!
+ * @brief random writes checked against a std::set along the way
+ */
+void churn(sal::LsmSet<int>::Options options, std::size_t ops) {
+  sal::LsmSet<int> set(options);
+  std::set<int> expected;
+  const int range = static_cast<int>(ops / 2);
+  for (std::size_t i = 0; i < ops; i++) {
+    const auto val = std::rand() % range;
+    if (std::rand() % 3) {
+      set.insert(val);
+      expected.insert(val);
+    } else {
+      set.remove(val);
+      expected.erase(val);
+    }
+    if (i % 997 == 0) {
+      const auto probe = std::rand() % (range + 10);
+      assert(set.find(probe) == expected.count(probe));
+    }
+  }
+  set.flush();
+  set.compact();
+  for (int val = -5; val < range + 5; val++) {
+    assert(set.find(val) == expected.count(val));
+  }
+  /// merged down to fewer than ratio runs per tier
+  assert(set.runs() < options.ratio * 8);
+}
+
+int main() {
+  std::srand(45);
+  sal::LsmSet<int>::Options options;
+  options.memtable = 64;
+  options.ratio = 3;
+  options.background = false;
+  churn(options, 20000);
+  options.background = true;
+  churn(options, 20000);
+  {
+    /// tombstones shadow older runs until merged into the oldest
+    options.background = false;
+    options.ratio = 4;
+    sal::LsmSet<int> set(options);
+    for (int i = 0; i < 64; i++) {
+      set.insert(i);
+    }
+    assert(set.runs() == 1);
+    set.remove(5);
+    set.insert(100);
+    assert(!set.find(5) && set.find(100));
+    set.flush();
+    assert(set.runs() == 2);
+    assert(!set.find(5) && set.find(6) && set.find(100));
+    set.insert(5);
+    assert(set.find(5));
+    for (int i = 0; i < 2; i++) {
+      set.insert(1000 + i);
+      set.flush();
+    }
+    /// four runs of the first tier make one, without the tombstone
+    assert(set.runs() == 1);
+    assert(set.records() == 67);
+    assert(set.find(5) && set.find(1001));
+  }
+  {
+    /// full memtables of distinct values make runs of exact tier sizes, so
+    /// the runs left count flushes in base ratio: a run per digit unit
+    options.background = false;
+    options.memtable = 16;
+    options.ratio = 4;
+    sal::LsmSet<int> set(options);
+    int next = 0;
+    for (std::size_t flushes = 1; flushes <= 1000; flushes++) {
+      for (std::size_t i = 0; i < options.memtable; i++) {
+        set.insert(next++);
+      }
+      set.flush();
+      std::size_t digits = 0;
+      for (auto f = flushes; f; f /= options.ratio) {
+        digits += f % options.ratio;
+      }
+      assert(set.runs() == digits);
+      assert(set.records() == flushes * options.memtable);
+    }
+    assert(set.find(0) && set.find(next - 1) && !set.find(next));
+    options.memtable = 64;
+  }
+  {
+    /// runs in files, removed with their runs
+    char directory[] = "/tmp/test_lsm_set_XXXXXX";
+    assert(::mkdtemp(directory));
+    options.directory = directory;
+    options.background = true;
+    {
+      sal::LsmSet<long long> set({
+          options.memtable,
+          options.ratio,
+          options.bitsPerKey,
+          options.directory,
+          options.background,
+      });
+      for (long long i = 0; i < 5000; i++) {
+        set.insert(i * 3);
+      }
+      set.compact();
+      assert(files(directory) == set.runs());
+      for (long long i = 0; i < 15000; i++) {
+        assert(set.find(i) == (i % 3 == 0));
+      }
+    }
+    assert(files(directory) == 0);
+    {
+      /// sets sharing a directory keep to their own files
+      sal::LsmSet<long long> a({
+          1024,
+          options.ratio,
+          options.bitsPerKey,
+          options.directory,
+          false,
+      });
+      sal::LsmSet<long long> b({
+          1024,
+          options.ratio,
+          options.bitsPerKey,
+          options.directory,
+          false,
+      });
+      for (long long i = 0; i < 1024; i++) {
+        a.insert(i);
+      }
+      a.flush();
+      for (long long i = 0; i < 1024; i++) {
+        b.insert(1000000 + i);
+      }
+      b.flush();
+      assert(files(directory) == 2);
+      for (long long i = 0; i < 1024; i++) {
+        assert(a.find(i) && !a.find(1000000 + i));
+        assert(b.find(1000000 + i) && !b.find(i));
+      }
+    }
+    assert(files(directory) == 0);
+    /// values that cannot be mapped stay in memory
+    sal::LsmSet<std::string> strings({
+        options.memtable,
+        options.ratio,
+        options.bitsPerKey,
+        options.directory,
+        options.background,
+    });
+    for (int i = 0; i < 500; i++) {
+      strings.insert(std::to_string(i));
+    }
+    strings.remove("7");
+    strings.flush();
+    strings.compact();
+    assert(files(directory) == 0);
+    assert(strings.find("499") && !strings.find("7") && !strings.find("x"));
+    ::rmdir(directory);
+  }
+
+  return 0;
+}
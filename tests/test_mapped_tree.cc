@@ -0,0 +1,185 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*!
+ * @brief asserts that both trees have the same shape and values
+ */
+template <typename Node, typename MappedNode>
+void same(const Node* node, const MappedNode* mapped) {
+  assert(!node == !mapped);
+  if (node) {
+    assert(node->value() == mapped->value());
+    same(node->left(), mapped->left());
+    same(node->right(), mapped->right());
+  }
+}
+
+std::string temporary() {
+  char path[] = "/tmp/test_mapped_tree_XXXXXX";
+  const auto fd = ::mkstemp(path);
+  assert(fd >= 0);
+  ::close(fd);
+  return path;
+}
+
+int main() {
+  std::srand(41);
+  const auto path = temporary();
+  const auto otherPath = temporary();
+  for (std::size_t n : {0, 1, 2, 3, 10, 1000, 20000}) {
+    std::set<int> values;
+    while (values.size() < n) {
+      values.insert(std::rand() % 1000000);
+    }
+    sal::RBTree<int> rb;
+    sal::AATree<int> aa;
+    for (const auto& val : values) {
+      rb.insert(val);
+      aa.insert(val);
+    }
+    {
+      std::ofstream os(path, std::ios::binary | std::ios::trunc);
+      assert(sal::MappedTree<int>::write(os, rb.root()));
+    }
+    sal::MappedTree<int> tree;
+    assert(tree.open(path.c_str()));
+    assert(tree.verify());
+    assert(tree.size() == n);
+    same(rb.root(), tree.root());
+    for (const auto& val : values) {
+      assert(tree.find(val));
+      assert(tree.find(val)->value() == val);
+      assert(!tree.find(val + 1) || values.count(val + 1));
+    }
+    assert(!tree.find(-1));
+    std::vector<int> order;
+    tree.inorder([&](int val) { order.push_back(val); });
+    assert(order == std::vector<int>(values.begin(), values.end()));
+    {
+      /// through a file descriptor
+      std::FILE* file = std::fopen(otherPath.c_str(), "wb");
+      assert(sal::MappedTree<int>::write(fileno(file), aa.root()));
+      std::fclose(file);
+    }
+    sal::MappedTree<int> other;
+    assert(other.open(otherPath.c_str()));
+    same(aa.root(), other.root());
+    tree = std::move(other);
+    assert(!other.root());
+    same(aa.root(), tree.root());
+  }
+  {
+    sal::RBTree<int> rb;
+    for (int i = 0; i < 100; i++) {
+      rb.insert(i);
+    }
+    {
+      std::ofstream os(path, std::ios::binary | std::ios::trunc);
+      assert(sal::MappedTree<int>::write(os, rb.root()));
+    }
+    {
+      /// the header is written whole, its padding as zeros
+      std::ostringstream os;
+      assert(sal::MappedTree<int>::write(os, rb.root()));
+      const auto bytes = os.str();
+      using Header = sal::MappedTree<int>::Header;
+      const std::pair<std::size_t, std::size_t> padding[] = {
+          {offsetof(Header, nodeSize) + 4, offsetof(Header, count)},
+          {offsetof(Header, count) + 8, sizeof(Header)},
+      };
+      for (const auto& [begin, end] : padding) {
+        for (auto i = begin; i < end; i++) {
+          assert(bytes[i] == 0);
+        }
+      }
+    }
+    /// another process maps the same pages
+    const auto pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+      sal::MappedTree<int> tree;
+      bool ok = tree.open(path.c_str());
+      for (int i = 0; ok && i < 100; i++) {
+        ok = tree.find(i);
+      }
+      std::_Exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    /// other value type
+    sal::MappedTree<long long> wide;
+    assert(!wide.open(path.c_str()));
+    assert(!wide.root());
+    std::string bytes;
+    {
+      std::ifstream is(path, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(is), {});
+    }
+    const auto rewrite = [&](const std::string& content) {
+      std::ofstream os(path, std::ios::binary | std::ios::trunc);
+      os << content;
+    };
+    sal::MappedTree<int> tree;
+    /// truncated
+    rewrite(bytes.substr(0, bytes.size() - 1));
+    assert(!tree.open(path.c_str()));
+    /// a flipped value opens, but does not verify
+    using Node = sal::MappedTree<int>::node_type;
+    const auto at = [&](std::size_t i) {
+      return sizeof(sal::MappedTree<int>::Header) + i * sizeof(Node);
+    };
+    auto corrupt = bytes;
+    corrupt[at(1)] ^= 1;
+    rewrite(corrupt);
+    assert(tree.open(path.c_str()));
+    assert(!tree.verify());
+    /// childs out of the image, behind their parent or onto it open, and
+    /// are taken as none, but do not verify
+    const auto count = (bytes.size() - at(0) - 8) / sizeof(Node);
+    for (const auto& [node, distance] : {
+        std::pair<std::size_t, std::int32_t>{0, 1 << 30},
+        {1, -1},
+        {2, -2},
+        {count - 1, 1},
+        {count / 2, static_cast<std::int32_t>(count - count / 2)},
+    }) {
+      corrupt = bytes;
+      std::memcpy(&corrupt[at(node) + sizeof(int)], &distance,
+          sizeof(distance));
+      rewrite(corrupt);
+      assert(tree.open(path.c_str()));
+      assert(!tree.verify());
+      std::size_t visited = 0;
+      tree.inorder([&](int) { visited++; });
+      assert(visited <= count);
+      for (int val = -1; val < 101; val++) {
+        tree.find(val);
+      }
+    }
+    corrupt = bytes;
+    corrupt[0] ^= 1;
+    rewrite(corrupt);
+    assert(!tree.open(path.c_str()));
+    assert(!tree.verify());
+    assert(!tree.open("/nonexistent/image"));
+  }
+  std::remove(path.c_str());
+  std::remove(otherPath.c_str());
+
+  return 0;
+}
@@ -0,0 +1,363 @@
+#include <sal/sal.hxx>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template <typename Node, typename T>
+void inorder(const Node* node, std::vector<T>& out) {
+  if (node) {
+    inorder(node->left(), out);
+    out.push_back(node->value());
+    inorder(node->right(), out);
+  }
+}
+
+/*!
+ * @return black height, asserting parent links and colors on the way
+ */
+template <typename Node>
+std::size_t checkRB(const Node* node, const Node* parent = nullptr) {
+  if (!node) {
+    return 1;
+  }
+  assert(node->parent() == parent);
+  if (node->color() == Node::Color::RED) {
+    assert(parent);
+    assert(!node->left() || node->left()->color() == Node::Color::BLACK);
+    assert(!node->right() || node->right()->color() == Node::Color::BLACK);
+  }
+  const auto l = checkRB(node->left(), node);
+  const auto r = checkRB(node->right(), node);
+  assert(l == r);
+  return l + (node->color() == Node::Color::BLACK);
+}
+
+template <typename Node>
+void checkAA(const Node* node) {
+  if (!node) {
+    return;
+  }
+  if (!node->left() || !node->right()) {
+    assert(node->level() == 0);
+  }
+  if (node->left()) {
+    assert(node->left()->level() + 1 == node->level());
+  }
+  if (auto* r = node->right()) {
+    assert(r->level() == node->level() || r->level() + 1 == node->level());
+    assert(!r->right() || r->right()->level() < node->level());
+  }
+  checkAA(node->left());
+  checkAA(node->right());
+}
+
+int main() {
+  std::mt19937_64 rng(48);
+  for (std::size_t threads : {1, 3}) {
+    sal::ThreadPool pool(threads);
+    for (std::size_t n : {0, 1, 2, 1000, 100000, 300001}) {
+      std::vector<std::uint64_t> values(n);
+      for (auto& val : values) {
+        val = rng() % (n + 1);
+      }
+      auto expected = values;
+      std::sort(expected.begin(), expected.end());
+      auto sorted = values;
+      sal::parallel::sort(pool, sorted);
+      assert(sorted == expected);
+      expected.erase(
+          std::unique(expected.begin(), expected.end()),
+          expected.end()
+      );
+      sal::parallel::unique(pool, sorted);
+      assert(sorted == expected);
+
+      sal::RBTree<std::uint64_t> rb;
+      rb.insert(n + 5);
+      assert(rb.build(values, pool) == expected.size());
+      checkRB(rb.root());
+      std::vector<std::uint64_t> got;
+      inorder(rb.root(), got);
+      assert(got == expected);
+      /// the same shape as a tree loaded from a snapshot
+      std::stringstream snapshot;
+      assert(rb.save(snapshot));
+      sal::RBTree<std::uint64_t> loaded;
+      assert(loaded.load(snapshot));
+      std::vector<std::uint64_t> order;
+      std::vector<std::uint64_t> loadedOrder;
+      for (auto* it = rb.root(); it; it = it->left()) {
+        order.push_back(it->value());
+      }
+      for (auto* it = loaded.root(); it; it = it->left()) {
+        loadedOrder.push_back(it->value());
+      }
+      assert(order == loadedOrder);
+      /// and as good for changes
+      for (std::uint64_t val = 0; val < 100; val++) {
+        rb.insert(n + 10 + val);
+        rb.remove(val);
+      }
+      checkRB(rb.root());
+
+      sal::AATree<std::uint64_t> aa;
+      assert(aa.build(values, pool) == expected.size());
+      checkAA(aa.root());
+      got.clear();
+      inorder(aa.root(), got);
+      assert(got == expected);
+      for (std::uint64_t val = 0; val < 100; val++) {
+        aa.insert(n + 10 + val);
+        aa.remove(val);
+        expected.push_back(n + 10 + val);
+      }
+      expected.erase(
+          expected.begin(),
+          std::lower_bound(expected.begin(), expected.end(), 100)
+      );
+      got.clear();
+      inorder(aa.root(), got);
+      assert(got == expected);
+    }
+  }
+  for (std::size_t threads : {1, 4}) {
+    sal::ThreadPool pool(threads);
+    for (std::size_t n : {0, 1, 1000, 100000}) {
+      std::vector<std::uint64_t> values(n);
+      for (auto& val : values) {
+        val = rng() % (4 * n + 1);
+      }
+      /// distinct, the trees differing in how they keep repeated values
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+      std::shuffle(values.begin(), values.end(), rng);
+      sal::RBTree<std::uint64_t> rb;
+      sal::AATree<std::uint64_t> aa;
+      sal::BSTree<std::uint64_t> bs;
+      for (const auto val : values) {
+        rb.insert(val);
+        aa.insert(val);
+        bs.insert(val);
+      }
+      std::vector<std::uint64_t> expected;
+      inorder(rb.root(), expected);
+      std::uint64_t sum = 0;
+      for (const auto val : expected) {
+        sum += val;
+      }
+
+      /// every value once
+      std::vector<std::atomic<int>> seen(4 * n + 1);
+      sal::parallel::forEach(pool, rb.root(), [&](std::uint64_t& val) {
+        seen[val]++;
+      });
+      for (const auto val : expected) {
+        assert(seen[val] == 1);
+        seen[val] = 0;
+      }
+      std::atomic<std::uint64_t> total = 0;
+      sal::parallel::forEach(pool, aa.root(), [&](std::uint64_t val) {
+        total += val;
+      });
+      assert(total == sum);
+      assert(sal::parallel::reduce(pool, bs.root(), std::uint64_t{0},
+          [](std::uint64_t a, std::uint64_t b) { return a + b; }) == sum);
+      /// in order, for an op that is not commutative
+      const auto concat = [](std::vector<std::uint64_t> a,
+          std::uint64_t val) {
+        a.push_back(val);
+        return a;
+      };
+      const auto join = [&](auto a, const auto& b) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(b)>,
+            std::uint64_t>) {
+          return concat(std::move(a), b);
+        } else {
+          a.insert(a.end(), b.begin(), b.end());
+          return a;
+        }
+      };
+      assert(sal::parallel::reduce(pool, rb.root(),
+          std::vector<std::uint64_t>{}, join) == expected);
+
+      /// copies shaped as their source, parents pointing into them
+      sal::RBTree<std::uint64_t> rbCopy;
+      rbCopy.insert(1);
+      rbCopy.assign(rb, pool);
+      checkRB(rbCopy.root());
+      std::vector<std::uint64_t> got;
+      inorder(rbCopy.root(), got);
+      assert(got == expected);
+      for (auto* a = rb.root(), * b = rbCopy.root(); a;
+          a = a->left(), b = b->left()) {
+        assert(b && a != b && a->value() == b->value());
+        assert(a->color() == b->color());
+      }
+      sal::AATree<std::uint64_t> aaCopy;
+      aaCopy.assign(aa, pool);
+      checkAA(aaCopy.root());
+      got.clear();
+      inorder(aaCopy.root(), got);
+      assert(got == expected);
+      sal::BSTree<std::uint64_t> bsCopy;
+      bsCopy.factor() = 3.0;
+      bsCopy.assign(bs, pool);
+      assert(bsCopy.size() == bs.size() && bsCopy.factor() == 2.0);
+      got.clear();
+      inorder(bsCopy.root(), got);
+      assert(got == expected);
+      std::vector<sal::bs::Node<std::uint64_t>*> stack;
+      if (bsCopy.root()) {
+        assert(!bsCopy.root()->parent());
+        stack.push_back(bsCopy.root());
+      }
+      while (!stack.empty()) {
+        auto* node = stack.back();
+        stack.pop_back();
+        for (auto* child : node->childs()) {
+          if (child) {
+            assert(child->parent() == node);
+            stack.push_back(child);
+          }
+        }
+      }
+      /// and independent of it
+      for (std::uint64_t val = 0; val < 50; val++) {
+        rbCopy.remove(val);
+        rbCopy.insert(4 * n + 10 + val);
+        bsCopy.remove(val);
+        bsCopy.insert(4 * n + 10 + val);
+      }
+      checkRB(rbCopy.root());
+      got.clear();
+      inorder(rb.root(), got);
+      assert(got == expected);
+      got.clear();
+      inorder(bs.root(), got);
+      assert(got == expected);
+      rbCopy.assign(rbCopy, pool);
+      checkRB(rbCopy.root());
+    }
+  }
+  for (std::size_t threads : {1, 3}) {
+    sal::ThreadPool pool(threads);
+    for (std::size_t n : {0, 1, 50, 20000}) {
+      for (std::size_t m : {std::size_t{0}, n / 3, 2 * n + 1}) {
+        std::vector<std::uint64_t> a(n);
+        std::vector<std::uint64_t> b(m);
+        for (auto& val : a) {
+          val = rng() % (2 * n + 2);
+        }
+        for (auto& val : b) {
+          val = rng() % (2 * n + 2);
+        }
+        sal::Tree<std::uint64_t, sal::RBTree> ta;
+        sal::Tree<std::uint64_t, sal::AATree> aa;
+        sal::Tree<std::uint64_t, sal::RBTree> tb;
+        sal::Tree<std::uint64_t, sal::AATree> ab;
+        ta.build(a, pool);
+        aa.build(a, pool);
+        tb.build(b, pool);
+        ab.build(b, pool);
+        sal::parallel::sort(pool, a);
+        sal::parallel::unique(pool, a);
+        sal::parallel::sort(pool, b);
+        sal::parallel::unique(pool, b);
+        sal::RBTree<std::uint64_t> rb;
+        rb.build(a, pool);
+        assert(sal::parallel::flatten<std::uint64_t>(pool, rb.root()) == a);
+
+        std::vector<std::uint64_t> unite;
+        std::vector<std::uint64_t> common;
+        std::vector<std::uint64_t> rest;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+            std::back_inserter(unite));
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+            std::back_inserter(common));
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+            std::back_inserter(rest));
+        for (std::size_t grain : {2, 7, 1 << 14}) {
+          assert(sal::parallel::setUnion(pool, a, b, grain) == unite);
+          assert(sal::parallel::setIntersection(pool, a, b, grain) == common);
+          assert(sal::parallel::setDifference(pool, a, b, grain) == rest);
+          assert(sal::parallel::setDifference(pool, b, a, grain).size() ==
+              unite.size() - a.size());
+        }
+
+        const auto values = [](const auto& tree) {
+          std::stringstream snapshot;
+          assert(tree.save(snapshot));
+          sal::RBTree<std::uint64_t> loaded;
+          assert(loaded.load(snapshot));
+          std::vector<std::uint64_t> ret;
+          inorder(loaded.root(), ret);
+          return ret;
+        };
+        const auto u = ta.parallelUnion(tb, pool, 5);
+        assert(u.size() == unite.size() && values(u) == unite);
+        const auto i = ta.parallelIntersection(tb, pool, 5);
+        assert(i.size() == common.size() && values(i) == common);
+        const auto d = ta.parallelDifference(tb, pool);
+        assert(d.size() == rest.size() && values(d) == rest);
+        const auto au = ab.parallelUnion(aa, pool);
+        assert(au.size() == unite.size() && values(au) == unite);
+        auto ad = aa.parallelDifference(ab, pool, 3);
+        assert(ad.size() == rest.size() && values(ad) == rest);
+        /// a tree like any other
+        assert(ad.insert(2 * n + 5) && ad.find(2 * n + 5));
+        for (const auto val : common) {
+          assert(!ad.find(val) && !ad.remove(val));
+        }
+        assert(ad.size() == rest.size() + 1);
+      }
+    }
+  }
+  {
+    sal::ThreadPool pool(2);
+    sal::Tree<std::string, sal::RBTree> tree{"old"};
+    tree.build({"b", "a", "c", "a"}, pool);
+    assert(tree.size() == 3);
+    assert(tree.find("a") && tree.find("c") && !tree.find("old"));
+    assert(tree.insert("d") && tree.size() == 4);
+    tree.build({}, pool);
+    assert(tree.empty() && !tree.find("a"));
+  }
+  {
+    /// runs of repeats inside and across the GRAIN sized ranges
+    sal::ThreadPool pool(4);
+    const auto n = 3 * sal::parallel::GRAIN + 5;
+    std::vector<std::string> values;
+    for (std::size_t i = 0; values.size() < n; i++) {
+      const auto repeat = i % 3 ? 1 + i % 5 : sal::parallel::GRAIN / 2 + 3;
+      for (std::size_t r = 0; r < repeat && values.size() < n; r++) {
+        values.push_back("value" + std::to_string(1000000 + i));
+      }
+    }
+    auto expected = values;
+    expected.erase(std::unique(expected.begin(), expected.end()),
+        expected.end());
+    auto unique = values;
+    sal::parallel::unique(pool, unique);
+    assert(unique == expected);
+    std::shuffle(values.begin(), values.end(), rng);
+    sal::RBTree<std::string> rb;
+    assert(rb.build(values, pool) == expected.size());
+    checkRB(rb.root());
+    std::vector<std::string> got;
+    inorder(rb.root(), got);
+    assert(got == expected);
+    sal::Tree<std::string, sal::AATree> aa;
+    aa.build(values, pool);
+    assert(aa.size() == expected.size());
+  }
+
+  return 0;
+}
@@ -1,5 +1,29 @@
 #include <sal/sal.hxx>
 #include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <set>
+
+/*!
+ * @return black height, asserting order, parent links and colors on the way
+ */
+template <typename Node>
+std::size_t check(const Node* node, const Node* parent = nullptr) {
+  if (!node) {
+    return 1;
+  }
+  assert(node->parent() == parent);
+  assert(!node->left() || node->left()->value() < node->value());
+  assert(!node->right() || node->value() < node->right()->value());
+  if (node->color() == Node::Color::RED) {
+    assert(!node->left() || node->left()->color() == Node::Color::BLACK);
+    assert(!node->right() || node->right()->color() == Node::Color::BLACK);
+  }
+  const auto l = check(node->left(), node);
+  const auto r = check(node->right(), node);
+  assert(l == r);
+  return l + (node->color() == Node::Color::BLACK);
+}
 
 int main() {
   using Tree = sal::RBTree<int>;
@@ -505,5 +529,56 @@ int main() {
     }
   }
 
+  {
+    std::srand(1);
+    Tree tree;
+    std::set<int> reference;
+    for (auto i = 0; i < 1 << 14; i++) {
+      const auto val = std::rand() % 512;
+      if (reference.count(val)) {
+        tree.remove(val);
+        reference.erase(val);
+      } else {
+        tree.insert(val);
+        reference.insert(val);
+      }
+      assert(!tree.root() || tree.root()->color() == BLACK);
+      check<Tree::node_type>(tree.root());
+    }
+    for (auto val = 0; val < 512; val++) {
+      assert(static_cast<bool>(tree.find(val)) == reference.count(val));
+    }
+  }
+
+  {
+    /// copies and moves own their parent links, changes stay in the copy
+    Tree tree;
+    for (auto i = 0; i < 256; i++) {
+      tree.insert(i);
+    }
+    Tree copy(tree);
+    check<Tree::node_type>(copy.root());
+    for (auto i = 256; i < 512; i++) {
+      copy.insert(i);
+      copy.remove(i - 256);
+    }
+    check<Tree::node_type>(tree.root());
+    check<Tree::node_type>(copy.root());
+    for (auto i = 0; i < 256; i++) {
+      assert(tree.find(i) && !tree.find(i + 256));
+      assert(!copy.find(i) && copy.find(i + 256));
+    }
+    copy = tree;
+    check<Tree::node_type>(copy.root());
+    Tree moved(std::move(copy));
+    assert(!copy.root());
+    check<Tree::node_type>(moved.root());
+    moved.insert(1000);
+    check<Tree::node_type>(moved.root());
+    copy = std::move(moved);
+    assert(!moved.root() && copy.find(1000));
+    check<Tree::node_type>(copy.root());
+  }
+
   return 0;
 }
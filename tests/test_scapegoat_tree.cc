@@ -0,0 +1,139 @@
+#include <sal/bs_tree.hh>
+#include <sal/scapegoat_tree.hh>
+#include <sal/tree.hh>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <type_traits>
+
+template <typename Node>
+std::size_t height(
+    const Node* node,
+    const std::type_identity_t<Node>* lo = nullptr,
+    const std::type_identity_t<Node>* hi = nullptr
+) {
+  if (!node) {
+    return 0;
+  }
+  assert(!lo || lo->value() < node->value());
+  assert(!hi || node->value() < hi->value());
+  return std::max(
+      height<Node>(node->left(), lo, node),
+      height<Node>(node->right(), node, hi)
+  ) + 1;
+}
+
+int main() {
+  using data_type = int;
+  using Tree = sal::ScapegoatTree<data_type>;
+
+  static_assert(sizeof(Tree::node_type) < sizeof(sal::bs::Node<data_type>));
+  {
+    auto tree = Tree();
+    assert(tree.root() == nullptr);
+    assert(tree.size() == 0);
+    assert(!tree.find(0));
+    assert(tree.insert(0));
+    assert(!tree.insert(0));
+    assert(tree.size() == 1);
+    assert(tree.insert(1));
+    assert(tree.root()->value() == 0);
+    assert(tree.root()->right()->value() == 1);
+    assert(tree.insert(2));
+    assert(tree.insert(3));
+    assert(tree.root()->right()->right()->right()->value() == 3);
+    /// 4 lands at depth 4 > log_1.5(5), 1 is the first unbalanced ancestor
+    assert(tree.insert(4));
+    assert(tree.size() == 5);
+    assert(tree.root()->value() == 0);
+    assert(!tree.root()->left());
+    assert(tree.root()->right()->value() == 2);
+    assert(tree.root()->right()->left()->value() == 1);
+    assert(tree.root()->right()->right()->value() == 3);
+    assert(tree.root()->right()->right()->right()->value() == 4);
+    tree.remove(2);
+    assert(!tree.find(2));
+    assert(tree.find(1));
+    assert(tree.find(3));
+    assert(tree.size() == 4);
+    /// 2 < 2/3 * 5, the whole tree is rebuilt
+    tree.remove(1);
+    assert(tree.root()->value() == 3);
+    assert(tree.root()->left()->value() == 0);
+    assert(tree.root()->right()->value() == 4);
+    tree.remove(0);
+    tree.remove(3);
+    tree.remove(4);
+    assert(!tree.root());
+    assert(tree.size() == 0);
+  }
+  {
+    /// sorted insertion keeps within the alpha height bound
+    auto tree = Tree();
+    constexpr auto N = 4096;
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+      const auto bound = std::log(tree.size()) / -std::log(Tree::ALPHA);
+      assert(height(std::as_const(tree).root()) <= bound + 1);
+    }
+    std::srand(1);
+    for (auto i = 0; i < N; i++) {
+      const auto val = std::rand() % N;
+      if (tree.find(val)) {
+        tree.remove(val);
+        assert(!tree.find(val));
+      } else {
+        tree.insert(val);
+        assert(tree.find(val));
+      }
+      const auto bound = std::log(tree.size()) / -std::log(Tree::ALPHA);
+      assert(height(std::as_const(tree).root()) <= bound + 2);
+    }
+    for (auto i = 0; i < N; i++) {
+      tree.remove(i);
+    }
+    assert(!tree.root());
+    assert(tree.size() == 0);
+  }
+  {
+    Tree src;
+    src.insert(0);
+    src.insert(1);
+    Tree dst = src;
+    dst.remove(0);
+    assert(src.find(0));
+    assert(!dst.find(0));
+    assert(src.size() == 2);
+    assert(dst.size() == 1);
+    Tree moved = std::move(dst);
+    assert(!dst.root() && dst.size() == 0);
+    assert(moved.find(1) && moved.size() == 1);
+  }
+  {
+    /// an empty tree assigned over a full one leaves it empty
+    Tree full;
+    for (auto i = 0; i < 100; i++) {
+      full.insert(i);
+    }
+    full = Tree();
+    assert(!full.root() && !full.find(5) && full.size() == 0);
+    for (auto i = 0; i < 100; i++) {
+      full.insert(i);
+    }
+    const Tree empty;
+    full = empty;
+    assert(!full.root() && !full.find(5) && full.size() == 0);
+  }
+  {
+    using Facade = sal::Tree<data_type, sal::ScapegoatTree>;
+    Facade tree = {-3, -2, -1, 0, 1, 2, 3};
+    assert(tree.size() == 7);
+    assert(!tree.insert(0));
+    assert(tree.remove(0));
+    assert(!tree.remove(0));
+    assert(tree.size() == 6);
+  }
+
+  return 0;
+}
@@ -1,5 +1,21 @@
 #include <sal/self_organizing_list.hh>
 #include <cassert>
+#include <vector>
+
+template <typename List>
+void order(const List& list, const std::vector<unsigned>& values) {
+  auto* it = list.root();
+  const typename List::node_type* prev = nullptr;
+  for (const auto& val : values) {
+    assert(it);
+    assert(it->value() == val);
+    assert(it->prev() == prev);
+    prev = it;
+    it = it->next();
+  }
+  assert(!it);
+  assert(list.last() == prev);
+}
 
 int main() {
   using data = unsigned;
@@ -40,5 +56,75 @@ int main() {
   assert(list.root()->next()->next());
   assert(list.root()->next()->next()->value() == 1);
 
+  {
+    sal::SelfOrganizingList<data> list;
+    for (data i = 0; i < 5; i++) {
+      list.add(i);
+    }
+    assert(list.get(3)->value() == 3);
+    order(list, {0, 1, 3, 2, 4});
+    assert(list.get(4));
+    assert(list.get(4));
+    order(list, {0, 1, 4, 3, 2});
+    assert(list.del(4));
+    order(list, {0, 1, 3, 2});
+  }
+  {
+    sal::SelfOrganizingList<data, sal::so::MoveToFront> list;
+    for (data i = 0; i < 5; i++) {
+      list.add(i);
+    }
+    assert(list.get(3));
+    order(list, {3, 0, 1, 2, 4});
+    assert(list.get(4));
+    order(list, {4, 3, 0, 1, 2});
+    assert(list.get(4));
+    order(list, {4, 3, 0, 1, 2});
+    assert(list.get(2));
+    order(list, {2, 4, 3, 0, 1});
+    assert(!list.get(5));
+  }
+  {
+    sal::SelfOrganizingList<data, sal::so::MoveAheadK<2>> list;
+    for (data i = 0; i < 5; i++) {
+      list.add(i);
+    }
+    assert(list.get(4));
+    order(list, {0, 1, 4, 2, 3});
+    assert(list.get(4));
+    order(list, {4, 0, 1, 2, 3});
+    assert(list.get(1));
+    order(list, {1, 4, 0, 2, 3});
+  }
+  {
+    sal::SelfOrganizingList<data, sal::so::FrequencyCount> list;
+    for (data i = 0; i < 5; i++) {
+      list.add(i);
+    }
+    assert(list.get(3));
+    order(list, {3, 0, 1, 2, 4});
+    assert(list.get(4));
+    /// ties keep their order, 4 only overtakes the nodes never accessed
+    order(list, {3, 4, 0, 1, 2});
+    assert(list.get(4));
+    order(list, {4, 3, 0, 1, 2});
+    assert(list.get(2));
+    assert(list.get(2));
+    assert(list.get(2));
+    order(list, {2, 4, 3, 0, 1});
+    assert(list.del(2));
+    assert(list.add(2));
+    assert(list.get(0));
+    order(list, {4, 3, 0, 1, 2});
+    /// a node spliced out and back counts from scratch
+    sal::DoubleLinkedList<data> other;
+    other.splice(other.nil, list, list.root(), list.root());
+    order(list, {3, 0, 1, 2});
+    list.splice(list.nil, other);
+    order(list, {3, 0, 1, 2, 4});
+    assert(list.get(4));
+    order(list, {3, 0, 4, 1, 2});
+  }
+
   return 0;
 }
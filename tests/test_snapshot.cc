@@ -0,0 +1,304 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+template <typename Node, typename T>
+void inorder(const Node* node, std::vector<T>& out) {
+  if (node) {
+    inorder(node->left(), out);
+    out.push_back(node->value());
+    inorder(node->right(), out);
+  }
+}
+
+template <typename Tree, typename T>
+void checkValues(const Tree& tree, const std::vector<T>& values) {
+  std::vector<T> got;
+  inorder(tree.root(), got);
+  assert(got == values);
+}
+
+/*!
+ * @return black height, asserting parent links and colors on the way
+ */
+template <typename Node>
+std::size_t checkRB(const Node* node, const Node* parent = nullptr) {
+  if (!node) {
+    return 1;
+  }
+  assert(node->parent() == parent);
+  if (node->color() == Node::Color::RED) {
+    assert(parent);
+    assert(!node->left() || node->left()->color() == Node::Color::BLACK);
+    assert(!node->right() || node->right()->color() == Node::Color::BLACK);
+  }
+  const auto l = checkRB(node->left(), node);
+  const auto r = checkRB(node->right(), node);
+  assert(l == r);
+  return l + (node->color() == Node::Color::BLACK);
+}
+
+template <typename Node>
+void checkAA(const Node* node) {
+  if (!node) {
+    return;
+  }
+  if (!node->left() || !node->right()) {
+    assert(node->level() == 0);
+  }
+  if (node->left()) {
+    assert(node->left()->level() + 1 == node->level());
+  }
+  if (auto* r = node->right()) {
+    assert(r->level() == node->level() || r->level() + 1 == node->level());
+    assert(!r->right() || r->right()->level() < node->level());
+  }
+  checkAA(node->left());
+  checkAA(node->right());
+}
+
+template <typename Node>
+std::size_t checkBS(const Node* node, const Node* parent = nullptr) {
+  if (!node) {
+    return 0;
+  }
+  assert(node->parent() == parent);
+  return std::max(
+      checkBS(node->left(), node),
+      checkBS(node->right(), node)
+  ) + 1;
+}
+
+template <typename Tree>
+std::string save(
+    const Tree& tree,
+    sal::snapshot::Encoding encoding = sal::snapshot::Encoding::RAW
+) {
+  std::ostringstream os;
+  assert(tree.save(os, encoding));
+  return os.str();
+}
+
+template <typename Tree>
+bool load(Tree& tree, const std::string& bytes) {
+  std::istringstream is(bytes);
+  return tree.load(is);
+}
+
+std::vector<int> sample(std::size_t n) {
+  std::set<int> set;
+  while (set.size() < n) {
+    set.insert(std::rand() % 100000 - 50000);
+  }
+  return {set.begin(), set.end()};
+}
+
+int main() {
+  std::srand(40);
+  for (std::size_t n : {0, 1, 2, 3, 4, 5, 6, 7, 8, 14, 15, 16, 100, 1000}) {
+    const auto values = sample(n);
+    {
+      sal::RBTree<int> tree;
+      for (auto i = values.rbegin(); i != values.rend(); i++) {
+        tree.insert(*i);
+      }
+      const auto bytes = save(tree);
+      sal::RBTree<int> loaded;
+      loaded.insert(12345678);
+      assert(load(loaded, bytes));
+      checkValues(loaded, values);
+      checkRB(loaded.root());
+      /// the loaded tree rebalances as usual
+      loaded.insert(1 << 20);
+      for (std::size_t i = 0; i < n; i += 2) {
+        loaded.remove(values[i]);
+      }
+      checkRB(loaded.root());
+    }
+    {
+      sal::AATree<int> tree;
+      for (const auto& val : values) {
+        tree.insert(val);
+      }
+      sal::AATree<int> loaded;
+      assert(load(loaded, save(tree)));
+      checkValues(loaded, values);
+      checkAA(loaded.root());
+      loaded.insert(1 << 20);
+      checkAA(loaded.root());
+    }
+    {
+      sal::BSTree<int> tree;
+      tree.factor() = 0;
+      for (const auto& val : values) {
+        tree.insert(val);
+      }
+      sal::BSTree<int> loaded;
+      assert(load(loaded, save(tree)));
+      assert(loaded.size() == n);
+      checkValues(loaded, values);
+      /// perfectly balanced, whatever the shape it was saved from
+      std::size_t height = 0;
+      while ((std::size_t{1} << height) < n + 1) {
+        height++;
+      }
+      assert(checkBS(loaded.root()) == height);
+    }
+  }
+  {
+    /// through Tree, with encoded values
+    using Tree = sal::Tree<std::string, sal::AATree>;
+    Tree tree = {"pear", "apple", "", "fig"};
+    Tree loaded = {"kiwi"};
+    assert(load(loaded, save(tree)));
+    assert(loaded.size() == 4);
+    assert(loaded.find("apple"));
+    assert(loaded.find(""));
+    assert(!loaded.find("kiwi"));
+    /// a corrupt length fails before it allocates, huge or merely too long
+    const auto bytes = save(tree);
+    const auto at = sizeof(sal::snapshot::Header) + sizeof(std::uint64_t);
+    for (const std::uint64_t size : {~std::uint64_t{0},
+        std::uint64_t{1} << 40, std::uint64_t{1} << 20, std::uint64_t{6}}) {
+      auto corrupt = bytes;
+      std::memcpy(&corrupt[at], &size, sizeof(size));
+      assert(!load(loaded, corrupt));
+      assert(loaded.empty());
+    }
+    auto corrupt = bytes;
+    corrupt[at + 7] ^= 0x40;
+    sal::AATree<std::string> strings;
+    std::istringstream is(corrupt);
+    assert(!strings.load(is));
+    assert(!strings.root());
+  }
+  {
+    /// unusable snapshots leave the tree empty
+    const auto values = sample(500);
+    sal::Tree<int, sal::RBTree> tree;
+    for (const auto& val : values) {
+      tree.insert(val);
+    }
+    const auto bytes = save(tree);
+    sal::Tree<int, sal::RBTree> loaded;
+    assert(load(loaded, bytes));
+    assert(loaded.size() == 500);
+    for (std::size_t i = 0; i < bytes.size(); i += 97) {
+      auto corrupt = bytes;
+      corrupt[i] ^= 0x10;
+      assert(!load(loaded, corrupt));
+      assert(loaded.empty());
+    }
+    assert(!load(loaded, bytes.substr(0, bytes.size() - 1)));
+    assert(!load(loaded, bytes.substr(0, 24)));
+    assert(!load(loaded, ""));
+    assert(loaded.empty());
+    /// same bytes, other value type
+    sal::Tree<long long, sal::RBTree> wide;
+    assert(!load(wide, bytes));
+  }
+  {
+    /// values out of order, with a valid checksum
+    sal::BSTree<int> tree;
+    tree.factor() = 0;
+    tree.insert(2);
+    tree.insert(1);
+    /// breaks the order by hand, save() checksums it all the same
+    tree.root()->left()->value() = 3;
+    sal::BSTree<int> loaded;
+    assert(!load(loaded, save(tree)));
+    assert(!loaded.root());
+    assert(!loaded.size());
+  }
+  {
+    /// packed integers
+    constexpr auto PACKED = sal::snapshot::Encoding::PACKED;
+    for (std::size_t n : {0, 1, 127, 128, 129, 1000, 5000}) {
+      std::vector<long long> dense;
+      std::vector<long long> sparse;
+      for (std::size_t i = 0; i < n; i++) {
+        dense.push_back(static_cast<long long>(i) - 100);
+      }
+      std::set<long long> set;
+      while (set.size() < n) {
+        set.insert(
+            (static_cast<long long>(std::rand()) << 32 ^ std::rand()) *
+            (std::rand() % 2 ? 1 : -1)
+        );
+      }
+      if (n > 2) {
+        set.erase(set.begin());
+        set.erase(std::prev(set.end()));
+        set.insert(std::numeric_limits<long long>::min());
+        set.insert(std::numeric_limits<long long>::max());
+      }
+      sparse.assign(set.begin(), set.end());
+      for (const auto* values : {&dense, &sparse}) {
+        sal::BSTree<long long> tree;
+        for (const auto& val : *values) {
+          tree.insert(val);
+        }
+        const auto packed = save(tree, PACKED);
+        sal::BSTree<long long> loaded;
+        assert(load(loaded, packed));
+        checkValues(loaded, *values);
+        if (values == &dense && n >= 128) {
+          /// about a bit per value, instead of 8 bytes
+          assert(packed.size() * 8 < save(tree).size());
+        }
+      }
+    }
+    /// equal values, which RBTree keeps
+    sal::RBTree<unsigned char> tree;
+    std::vector<unsigned char> values;
+    for (int i = 0; i < 300; i++) {
+      values.push_back(static_cast<unsigned char>(i / 3));
+      tree.insert(values.back());
+    }
+    sal::RBTree<unsigned char> loaded;
+    const auto packed = save(tree, PACKED);
+    assert(load(loaded, packed));
+    checkValues(loaded, values);
+    checkRB(loaded.root());
+    /// a bit width beyond the value type
+    auto corrupt = packed;
+    /// past the first value, which goes as is
+    corrupt[sizeof(sal::snapshot::Header) + 1] = 9;
+    assert(!load(loaded, corrupt));
+    assert(!loaded.root());
+    /// only integers pack
+    sal::AATree<std::string> strings;
+    strings.insert("a");
+    std::ostringstream os;
+    assert(!strings.save(os, PACKED));
+  }
+  {
+    /// file descriptors
+    auto* file = std::tmpfile();
+    assert(file);
+    const auto values = sample(3000);
+    sal::RBTree<int> tree;
+    for (const auto& val : values) {
+      tree.insert(val);
+    }
+    assert(tree.save(fileno(file)));
+    std::rewind(file);
+    sal::RBTree<int> loaded;
+    assert(loaded.load(fileno(file)));
+    checkValues(loaded, values);
+    checkRB(loaded.root());
+    std::fclose(file);
+  }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include <sal/splay_tree.hh>
+#include <sal/tree.hh>
+#include <cassert>
+
+int main() {
+  using data_type = int;
+  using Tree = sal::SplayTree<data_type>;
+
+  {
+    auto tree = Tree();
+    assert(tree.root() == nullptr);
+    assert(!tree.find(0));
+    assert(!tree.remove(0));
+    tree.insert(0);
+    assert(tree.root());
+    assert(tree.root()->value() == 0);
+    assert(!tree.root()->left());
+    assert(!tree.root()->right());
+    tree.insert(1);
+    assert(tree.root());
+    assert(tree.root()->value() == 1);
+    assert(tree.root()->left());
+    assert(tree.root()->left()->value() == 0);
+    assert(!tree.root()->right());
+    tree.insert(-1);
+    assert(tree.root());
+    assert(tree.root()->value() == -1);
+    assert(!tree.root()->left());
+    assert(tree.root()->right());
+    assert(tree.root()->right()->value() == 0);
+    assert(!tree.root()->right()->left());
+    assert(tree.root()->right()->right());
+    assert(tree.root()->right()->right()->value() == 1);
+    assert(!tree.insert(0));
+    assert(tree.root()->value() == 0);
+    assert(tree.root()->left());
+    assert(tree.root()->left()->value() == -1);
+    assert(tree.root()->right());
+    assert(tree.root()->right()->value() == 1);
+    assert(tree.find(1));
+    assert(tree.root()->value() == 1);
+    assert(!tree.find(2));
+    assert(tree.root()->value() == 1);
+    assert(tree.find(-1));
+    assert(tree.root()->value() == -1);
+    tree.remove(-1);
+    assert(!tree.find(-1));
+    assert(tree.find(0));
+    assert(tree.find(1));
+    tree.remove(1);
+    assert(tree.root());
+    assert(tree.root()->value() == 0);
+    assert(!tree.root()->left());
+    assert(!tree.root()->right());
+    tree.remove(0);
+    assert(!tree.root());
+  }
+  {
+    /// sorted insertion produces a path, a single access halves its depth
+    auto tree = Tree();
+    constexpr auto N = 1024;
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+    }
+    assert(tree.root()->value() == N - 1);
+    assert(tree.find(0));
+    assert(tree.root()->value() == 0);
+    for (auto i = 0; i < N; i++) {
+      assert(tree.find(i));
+      assert(tree.root()->value() == i);
+    }
+    for (auto i = 0; i < N; i += 2) {
+      assert(tree.remove(i));
+    }
+    for (auto i = 0; i < N; i++) {
+      assert(static_cast<bool>(tree.find(i)) == (i % 2 == 1));
+    }
+  }
+  {
+    Tree src;
+    src.insert(0);
+    src.insert(1);
+    Tree dst = src;
+    dst.remove(0);
+    assert(src.find(0));
+    assert(src.find(1));
+    assert(!dst.find(0));
+    assert(dst.find(1));
+    const Tree moved = std::move(dst);
+    assert(!dst.root());
+    assert(moved.root());
+    assert(moved.root()->value() == 1);
+    dst = src;
+    assert(dst.find(0) && dst.find(1));
+    dst = moved;
+    assert(!dst.find(0) && dst.find(1));
+    src = std::move(dst);
+    assert(!dst.root());
+    assert(!src.find(0) && src.find(1));
+  }
+  {
+    /// sorted insertion leaves a path as deep as the tree, copies and
+    /// destruction must not recurse down it
+    constexpr auto N = 1000000;
+    auto tree = Tree();
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+    }
+    auto copy = tree;
+    assert(copy.root()->value() == N - 1);
+    assert(copy.root()->left()->value() == N - 2);
+    copy = tree;
+    assert(copy.find(0) && copy.find(N - 1) && !copy.find(N));
+  }
+  {
+    using Facade = sal::Tree<data_type, sal::SplayTree>;
+    Facade tree = {-3, -2, -1, 0, 1, 2, 3};
+    assert(tree.size() == 7);
+    assert(!tree.insert(0));
+    assert(tree.remove(0));
+    assert(!tree.remove(0));
+    assert(tree.size() == 6);
+    const Facade other = {4, 5};
+    const auto sum = tree + other;
+    assert(sum.size() == 8);
+    for (const auto& val : other.bfs()) {
+      assert(sum.find(val));
+    }
+  }
+
+  return 0;
+}
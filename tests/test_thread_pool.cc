@@ -0,0 +1,88 @@
+#include <sal/thread_pool.hh>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/*!
+ * @brief sum of [begin, end) by nested forks
+ */
+std::uint64_t sum(sal::ThreadPool& pool, std::uint64_t begin,
+    std::uint64_t end) {
+  if (end - begin <= 64) {
+    std::uint64_t ret = 0;
+    for (auto i = begin; i < end; i++) {
+      ret += i;
+    }
+    return ret;
+  }
+  const auto middle = begin + (end - begin) / 2;
+  std::uint64_t left = 0;
+  std::uint64_t right = 0;
+  pool.invoke(
+      [&] { right = sum(pool, middle, end); },
+      [&] { left = sum(pool, begin, middle); }
+  );
+  return left + right;
+}
+
+int main() {
+  for (std::size_t threads : {1, 2, 4, 0}) {
+    sal::ThreadPool pool(threads);
+    assert(pool.threads() >= 1);
+    assert(!threads || pool.threads() == threads);
+    assert(sum(pool, 0, 1 << 20) == (std::uint64_t{1} << 20) *
+        ((std::uint64_t{1} << 20) - 1) / 2);
+    /// every index exactly once
+    std::vector<std::atomic<int>> seen(100000);
+    std::atomic<std::size_t> calls = 0;
+    pool.parallelFor(seen.size(), 1000, [&](std::size_t b, std::size_t e) {
+      assert(b < e && e - b <= 1000);
+      calls++;
+      for (auto i = b; i < e; i++) {
+        seen[i]++;
+      }
+    });
+    for (const auto& s : seen) {
+      assert(s == 1);
+    }
+    assert(calls >= 100);
+    pool.parallelFor(0, 10, [&](std::size_t, std::size_t) {
+      assert(false);
+    });
+    /// nested loops
+    std::atomic<std::size_t> total = 0;
+    pool.parallelFor(16, 1, [&](std::size_t, std::size_t) {
+      pool.parallelFor(1000, 10, [&](std::size_t b, std::size_t e) {
+        total += e - b;
+      });
+    });
+    assert(total == 16000);
+  }
+  {
+    /// forks from threads outside the pool, one of them a worker of another
+    sal::ThreadPool pool(3);
+    sal::ThreadPool other(2);
+    std::vector<std::thread> callers;
+    std::atomic<std::size_t> failed = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+      callers.emplace_back([&] {
+        for (std::size_t round = 0; round < 20; round++) {
+          failed += sum(pool, 0, 1 << 14) != (1u << 14) * ((1u << 14) - 1) / 2;
+        }
+      });
+    }
+    other.invoke(
+        [&] { failed += sum(pool, 0, 1 << 16) != (1u << 16) * 65535u / 2; },
+        [&] { failed += sum(pool, 0, 1 << 16) != (1u << 16) * 65535u / 2; }
+    );
+    for (auto& caller : callers) {
+      caller.join();
+    }
+    assert(!failed);
+  }
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+#include <sal/treap.hh>
+#include <sal/tree.hh>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+template <typename Node>
+std::size_t check(
+    const Node* node,
+    const std::type_identity_t<Node>* lo = nullptr,
+    const std::type_identity_t<Node>* hi = nullptr
+) {
+  if (!node) {
+    return 0;
+  }
+  assert(!lo || lo->value() < node->value());
+  assert(!hi || node->value() < hi->value());
+  if (node->left()) {
+    assert(node->left()->priority() <= node->priority());
+  }
+  if (node->right()) {
+    assert(node->right()->priority() <= node->priority());
+  }
+  return std::max(
+      check<Node>(node->left(), lo, node),
+      check<Node>(node->right(), node, hi)
+  ) + 1;
+}
+
+int main() {
+  using data_type = int;
+  using Tree = sal::Treap<data_type>;
+
+  {
+    auto tree = Tree();
+    assert(tree.root() == nullptr);
+    assert(!tree.find(0));
+    assert(!tree.remove(0));
+    assert(tree.insert(0));
+    assert(tree.root());
+    assert(tree.root()->value() == 0);
+    assert(tree.insert(1));
+    assert(tree.insert(-1));
+    assert(tree.find(0));
+    assert(tree.find(1));
+    assert(tree.find(-1));
+    assert(!tree.find(2));
+    check(std::as_const(tree).root());
+    tree.remove(0);
+    assert(!tree.find(0));
+    assert(tree.find(1));
+    assert(tree.find(-1));
+    tree.remove(1);
+    tree.remove(-1);
+    assert(!tree.root());
+  }
+  {
+    /// sorted insertion stays logarithmic
+    auto tree = Tree();
+    constexpr auto N = 4096;
+    for (auto i = 0; i < N; i++) {
+      assert(tree.insert(i));
+    }
+    assert(check(std::as_const(tree).root()) < 48);
+    for (auto i = 0; i < N; i += 2) {
+      tree.remove(i);
+    }
+    check(std::as_const(tree).root());
+    for (auto i = 0; i < N; i++) {
+      assert(static_cast<bool>(tree.find(i)) == (i % 2 == 1));
+    }
+  }
+  {
+    auto tree = Tree();
+    constexpr auto N = 1024;
+    for (auto i = 0; i < N; i++) {
+      tree.insert(i);
+    }
+    auto upper = tree.split(N / 2);
+    check(std::as_const(tree).root());
+    check(std::as_const(upper).root());
+    for (auto i = 0; i < N; i++) {
+      assert(static_cast<bool>(tree.find(i)) == (i < N / 2));
+      assert(static_cast<bool>(upper.find(i)) == (i >= N / 2));
+    }
+    auto empty = upper.split(N);
+    assert(!empty.root());
+    auto all = tree.split(-1);
+    assert(!tree.root());
+    auto merged = Tree::merge(std::move(all), std::move(upper));
+    assert(!all.root());
+    assert(!upper.root());
+    check(std::as_const(merged).root());
+    for (auto i = 0; i < N; i++) {
+      assert(merged.find(i));
+    }
+    merged.insert(N);
+    assert(merged.find(N));
+    Tree copy = merged;
+    merged.remove(0);
+    assert(!merged.find(0));
+    assert(copy.find(0));
+  }
+  {
+    /// instances and split halves draw priorities of their own
+    auto a = Tree();
+    auto b = Tree();
+    std::size_t same = 0;
+    for (auto i = 0; i < 64; i++) {
+      same += a.insert(i)->priority() == b.insert(i)->priority();
+    }
+    auto upper = a.split(32);
+    for (auto i = 64; i < 128; i++) {
+      same += a.insert(-i)->priority() == upper.insert(i)->priority();
+    }
+    assert(same == 0);
+  }
+  {
+    using Facade = sal::Tree<data_type, sal::Treap>;
+    Facade tree = {-3, -2, -1, 0, 1, 2, 3};
+    assert(tree.size() == 7);
+    assert(!tree.insert(0));
+    assert(tree.remove(0));
+    assert(!tree.remove(0));
+    assert(tree.size() == 6);
+    const Facade other = {4, 5};
+    const auto sum = tree + other;
+    assert(sum.size() == 8);
+    for (const auto& val : other.bfs()) {
+      assert(sum.find(val));
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <sal/unrolled_list.hh>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+template <typename List>
+void check(
+    const List& list,
+    const std::vector<typename List::value_type>& ref
+) {
+  std::vector<typename List::value_type> values;
+  const typename List::Chunk* prev = nullptr;
+  for (auto* chunk = list.root(); chunk; chunk = chunk->next()) {
+    assert(chunk->prev() == prev);
+    assert(chunk->size() > 0);
+    assert(chunk->size() <= List::CAPACITY);
+    assert(chunk == list.last() || chunk->size() >= List::CAPACITY / 2);
+    values.insert(values.end(), chunk->begin(), chunk->end());
+    prev = chunk;
+  }
+  assert(list.last() == prev);
+  assert(values == ref);
+  assert(list.size() == ref.size());
+}
+
+int main() {
+  {
+    using List = sal::UnrolledList<unsigned>;
+    static_assert(sizeof(List::Chunk) <= List::CHUNK_BYTES);
+    List list;
+    assert(!list.get(0));
+    assert(!list.del(0));
+    assert(*list.add(0) == 0);
+    assert(list.root() == list.last());
+    assert(*list.add(1) == 1);
+    assert(list.get(0));
+    assert(list.get(1));
+    assert(!list.get(2));
+    assert(list.del(1));
+    assert(!list.del(1));
+    assert(list.del(0));
+    assert(!list.root());
+    assert(!list.last());
+    std::vector<unsigned> ref;
+    for (unsigned i = 0; i < 3 * List::CAPACITY; i++) {
+      list.add(i);
+      ref.push_back(i);
+    }
+    check(list, ref);
+    assert(list.root()->next()->next() == list.last());
+    /// the first chunk refills from the second one until they fit into one
+    while (list.root()->next()->next()) {
+      assert(list.del(ref.front()));
+      ref.erase(ref.begin());
+      check(list, ref);
+    }
+    assert(list.root()->size() == List::CAPACITY);
+    for (const auto& val : ref) {
+      assert(*list.get(val) == val);
+    }
+    List other(std::move(list));
+    assert(!list.root());
+    check(other, ref);
+  }
+  {
+    std::srand(1);
+    sal::UnrolledList<int> list;
+    std::vector<int> ref;
+    for (auto i = 0; i < 1 << 14; i++) {
+      const auto val = std::rand() % 512;
+      if (std::rand() % 3) {
+        list.add(val);
+        ref.push_back(val);
+      } else {
+        const auto it = std::find(ref.begin(), ref.end(), val);
+        assert(list.del(val) == (it != ref.end()));
+        if (it != ref.end()) {
+          ref.erase(it);
+        }
+      }
+      assert(static_cast<bool>(list.get(val)) ==
+          (std::find(ref.begin(), ref.end(), val) != ref.end()));
+    }
+    check(list, ref);
+  }
+  {
+    /// not arithmetic, scanned without the vectorized pass
+    sal::UnrolledList<std::string> list;
+    std::vector<std::string> ref;
+    for (auto i = 0; i < 100; i++) {
+      list.add(std::to_string(i));
+      ref.push_back(std::to_string(i));
+    }
+    assert(*list.get("42") == "42");
+    assert(list.del("42"));
+    ref.erase(ref.begin() + 42);
+    assert(!list.get("42"));
+    check(list, ref);
+  }
+
+  return 0;
+}
@@ -0,0 +1,208 @@
+#include <sal/sal.hxx>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using Tree = sal::Tree<int, sal::RBTree>;
+using Wal = Tree::wal_type;
+
+std::string temporary() {
+  char path[] = "/tmp/test_wal_XXXXXX";
+  const auto fd = ::mkstemp(path);
+  assert(fd >= 0);
+  ::close(fd);
+  return path;
+}
+
+template <typename T>
+void checkValues(const Tree& tree, const std::set<T>& values) {
+  assert(tree.size() == values.size());
+  for (const auto& val : values) {
+    assert(tree.find(val));
+  }
+}
+
+std::string read(const std::string& path) {
+  std::ifstream is(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(is), {}};
+}
+
+void write(const std::string& path, const std::string& bytes) {
+  std::ofstream os(path, std::ios::binary | std::ios::trunc);
+  os << bytes;
+}
+
+int main() {
+  std::srand(44);
+  const auto path = temporary();
+  std::set<int> values;
+  {
+    /// writers on several threads, group by group
+    Wal wal({std::chrono::microseconds(500), 8, false});
+    Tree tree;
+    assert(tree.attach(wal, path.c_str()));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+      threads.emplace_back([&tree, t] {
+        for (int i = 0; i < 200; i++) {
+          assert(tree.insert(t * 1000 + i));
+        }
+        for (int i = 0; i < 200; i += 3) {
+          assert(tree.remove(t * 1000 + i));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (int t = 0; t < 8; t++) {
+      for (int i = 0; i < 200; i++) {
+        if (i % 3) {
+          values.insert(t * 1000 + i);
+        }
+      }
+    }
+    checkValues(tree, values);
+    /// records share groups
+    assert(wal.groups() < 8 * (200 + 67));
+    /// no change, no record
+    assert(!tree.insert(1));
+    assert(!tree.remove(0));
+    tree.detach();
+    /// detached, the tree is no longer logged
+    assert(!tree.logged());
+    assert(tree.insert(-1));
+  }
+  {
+    /// replay
+    Wal wal;
+    Tree tree;
+    assert(tree.attach(wal, path.c_str()));
+    checkValues(tree, values);
+    assert(tree.logged());
+    /// a moved tree takes its log along
+    Tree moved(std::move(tree));
+    assert(tree.size() == 0 && tree.empty() && !tree.logged());
+    assert(moved.logged());
+    checkValues(moved, values);
+    Tree assigned;
+    assigned = std::move(moved);
+    assert(moved.size() == 0 && !moved.logged());
+    assert(assigned.logged());
+    assert(assigned.insert(-5));
+    values.insert(-5);
+    /// a failed log, told apart from a present value
+    assert(!assigned.insert(-5) && assigned.logged());
+    wal.close();
+    assert(!assigned.insert(-7) && !assigned.logged());
+    assert(!assigned.find(-7) && assigned.size() == values.size());
+  }
+  const auto bytes = read(path);
+  {
+    /// a torn group ends the log and is cut off
+    write(path, bytes + std::string(20, '\x01'));
+    Wal wal;
+    Tree tree;
+    assert(tree.attach(wal, path.c_str()));
+    checkValues(tree, values);
+    tree.detach();
+    assert(read(path) == bytes);
+    /// so is a corrupt one, with what follows
+    auto corrupt = bytes;
+    corrupt[bytes.size() - 1] ^= 1;
+    write(path, corrupt);
+    Tree other;
+    assert(other.attach(wal, path.c_str()));
+    assert(!other.find(-5));
+    assert(other.size() + 1 == values.size());
+    assert(other.insert(-5));
+    other.detach();
+    Tree again;
+    assert(again.attach(wal, path.c_str()));
+    checkValues(again, values);
+  }
+  {
+    /// a log on top of a snapshot, then emptied
+    Wal wal;
+    Tree tree;
+    assert(tree.attach(wal, path.c_str()));
+    std::stringstream snapshot;
+    assert(tree.save(snapshot));
+    assert(wal.truncate());
+    assert(tree.insert(-6));
+    assert(tree.remove(-5));
+    values.insert(-6);
+    values.erase(-5);
+    tree.detach();
+    Tree restored;
+    assert(restored.load(snapshot));
+    assert(restored.attach(wal, path.c_str()));
+    checkValues(restored, values);
+    restored.detach();
+    Tree logOnly;
+    assert(logOnly.attach(wal, path.c_str()));
+    assert(logOnly.size() == 1 && logOnly.find(-6));
+  }
+  {
+    /// values replaced whole are not logged, the tree leaves its log
+    std::remove(path.c_str());
+    Wal wal;
+    sal::ThreadPool pool(2);
+    Tree tree;
+    assert(tree.attach(wal, path.c_str()));
+    assert(tree.insert(1));
+    tree = Tree{7, 8};
+    assert(!tree.logged() && tree.size() == 2);
+    assert(tree.attach(wal, path.c_str()));
+    assert(tree.size() == 3 && tree.find(1));
+    std::stringstream snapshot;
+    assert(Tree{9}.save(snapshot));
+    assert(tree.load(snapshot));
+    assert(!tree.logged() && tree.size() == 1);
+    assert(tree.attach(wal, path.c_str()));
+    tree.build({2, 3}, pool);
+    assert(!tree.logged() && tree.size() == 2);
+    /// the log holds the one insert that was logged
+    Tree replayed;
+    assert(replayed.attach(wal, path.c_str()));
+    assert(replayed.size() == 1 && replayed.find(1));
+  }
+  {
+    /// logs of other value types, or no logs at all
+    sal::Tree<long long, sal::RBTree>::wal_type wide;
+    sal::Tree<long long, sal::RBTree> tree;
+    assert(!tree.attach(wide, path.c_str()));
+    write(path, "not a log, not at all");
+    Wal wal;
+    Tree other;
+    assert(!other.attach(wal, path.c_str()));
+    assert(!other.attach(wal, "/nonexistent/log"));
+    assert(other.insert(1));
+  }
+  {
+    /// encoded values
+    std::remove(path.c_str());
+    sal::Tree<std::string, sal::AATree>::wal_type wal;
+    sal::Tree<std::string, sal::AATree> tree;
+    assert(tree.attach(wal, path.c_str()));
+    assert(tree.insert("durable"));
+    assert(tree.insert(""));
+    assert(tree.remove("durable"));
+    tree.detach();
+    sal::Tree<std::string, sal::AATree> replayed;
+    assert(replayed.attach(wal, path.c_str()));
+    assert(replayed.size() == 1 && replayed.find(""));
+  }
+  std::remove(path.c_str());
+
+  return 0;
+}